@@ -0,0 +1,35 @@
+// Turns the minified control panel (stdin) into main/http_server_index.h (stdout):
+// the page as a raw literal plus a gzip copy and content hashes used as ETags.
+const crypto = require("crypto");
+const zlib = require("zlib");
+
+let input = "";
+process.stdin.setEncoding("utf8");
+process.stdin.on("data", (chunk) => (input += chunk));
+process.stdin.on("end", () => {
+  const html = input.replace(/\n+$/, "");
+  // Exactly the bytes of index_html, including the newlines the raw literal adds
+  const page = Buffer.from("\n" + html + "\n", "utf8");
+  const gz = zlib.gzipSync(page, { level: 9 });
+  const hash = (data) => crypto.createHash("sha256").update(data).digest("hex").slice(0, 16);
+
+  const bytes = [];
+  for (let i = 0; i < gz.length; i += 16) {
+    const row = Array.from(gz.subarray(i, i + 16), (b) => "0x" + b.toString(16).padStart(2, "0"));
+    bytes.push("  " + row.join(", ") + ",");
+  }
+
+  process.stdout.write(
+    'const char index_html[] PROGMEM = R"rawliteral(\n' +
+      html +
+      '\n)rawliteral";\n' +
+      "\n" +
+      "// Generated by .githooks/pre-commit from control-panel/index.html\n" +
+      `#define INDEX_HTML_ETAG "\\"${hash(page)}\\""\n` +
+      `#define INDEX_HTML_GZ_ETAG "\\"${hash(gz)}-gz\\""\n` +
+      `const size_t index_html_gz_len = ${gz.length};\n` +
+      "const uint8_t index_html_gz[] PROGMEM = {\n" +
+      bytes.join("\n") +
+      "\n};\n"
+  );
+});
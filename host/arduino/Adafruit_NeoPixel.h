@@ -0,0 +1,43 @@
+#ifndef HOST_ADAFRUIT_NEOPIXEL_H
+#define HOST_ADAFRUIT_NEOPIXEL_H
+
+#include "Arduino.h"
+
+#define NEO_GRB     0x52
+#define NEO_KHZ800  0x0000
+
+// Records what would go out on the data pin: show() copies the pixel buffer
+// aside and counts, so the host can check the frame and the refresh rate.
+class Adafruit_NeoPixel {
+public:
+    Adafruit_NeoPixel(uint16_t count, int16_t pin, uint16_t type);
+    ~Adafruit_NeoPixel();
+
+    void begin() {}
+    void show();
+    void clear();
+    void setBrightness(uint8_t value) { brightness = value; }
+    uint8_t getBrightness() const { return brightness; }
+    void setPixelColor(uint16_t index, uint32_t color);
+    void setPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+    uint32_t getPixelColor(uint16_t index) const;
+    uint16_t numPixels() const { return count; }
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+        return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+    }
+
+    // Host only
+    uint32_t shows() const { return showCount; }
+    const uint32_t* shownPixels() const { return shown; } // As of the last show()
+    uint64_t lastShowUs() const { return lastShow; }
+
+private:
+    uint16_t count;
+    uint8_t brightness;
+    uint32_t* pixels;
+    uint32_t* shown;
+    uint32_t showCount;
+    uint64_t lastShow;
+};
+
+#endif // HOST_ADAFRUIT_NEOPIXEL_H
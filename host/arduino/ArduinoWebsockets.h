@@ -0,0 +1,72 @@
+#ifndef HOST_ARDUINOWEBSOCKETS_H
+#define HOST_ARDUINOWEBSOCKETS_H
+
+#include "Arduino.h"
+#include <functional>
+
+// --- ArduinoWebsockets Client ---
+// The far end is a HostHassPeer (see host.h). Messages point into the
+// fake's receive queue; the library hands the callback a String it
+// allocated for each one instead.
+
+namespace websockets {
+
+enum class WebsocketsEvent {
+    ConnectionOpened,
+    ConnectionClosed,
+    GotPing,
+    GotPong,
+};
+
+enum class MessageType {
+    Empty,
+    Text,
+    Binary,
+    Ping,
+    Pong,
+    Close,
+};
+
+typedef String WSInterfaceString;
+
+class WebsocketsMessage {
+public:
+    WebsocketsMessage(MessageType type, const char* data, size_t length)
+        : messageType(type), text(data), size(length) {}
+
+    const char* c_str() const { return text; }
+    size_t length() const { return size; }
+    MessageType type() const { return messageType; }
+    bool isText() const { return messageType == MessageType::Text; }
+    bool isBinary() const { return messageType == MessageType::Binary; }
+
+private:
+    MessageType messageType;
+    const char* text;
+    size_t size;
+};
+
+class WebsocketsClient {
+public:
+    typedef std::function<void(WebsocketsMessage)> PartialMessageCallback;
+    typedef std::function<void(WebsocketsEvent, WSInterfaceString)> PartialEventCallback;
+
+    bool connect(const char* host, int port, const char* path);
+    void onMessage(PartialMessageCallback callback) { messageCallback = callback; }
+    void onEvent(PartialEventCallback callback) { eventCallback = callback; }
+    bool poll();
+    bool send(const char* data, size_t length);
+    bool send(const char* data) { return send(data, strlen(data)); }
+    bool available() const;
+    void close();
+
+private:
+    PartialMessageCallback messageCallback;
+    PartialEventCallback eventCallback;
+
+    void closed();
+};
+
+} // namespace websockets
+
+#endif // HOST_ARDUINOWEBSOCKETS_H
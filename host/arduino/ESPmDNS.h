@@ -0,0 +1,12 @@
+#ifndef HOST_ESPMDNS_H
+#define HOST_ESPMDNS_H
+
+class MDNSResponder {
+public:
+    bool begin(const char* hostName) { return true; }
+    void end() {}
+};
+
+extern MDNSResponder MDNS;
+
+#endif // HOST_ESPMDNS_H
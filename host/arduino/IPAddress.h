@@ -0,0 +1,24 @@
+#ifndef HOST_IPADDRESS_H
+#define HOST_IPADDRESS_H
+
+#include <stdint.h>
+#include <string.h>
+#include "WString.h"
+
+class IPAddress {
+public:
+    IPAddress() : IPAddress(0, 0, 0, 0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+    IPAddress(uint32_t address) { memcpy(bytes, &address, sizeof(bytes)); } // Network byte order
+
+    uint8_t operator[](int index) const { return bytes[index]; }
+    uint8_t& operator[](int index) { return bytes[index]; }
+    bool operator==(const IPAddress& other) const;
+    bool operator!=(const IPAddress& other) const { return !(*this == other); }
+    String toString() const;
+
+private:
+    uint8_t bytes[4];
+};
+
+#endif // HOST_IPADDRESS_H
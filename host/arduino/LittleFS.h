@@ -0,0 +1,46 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "Arduino.h"
+
+// --- LittleFS ---
+// A flat in-memory file system: HOST_FS_FILES files of up to
+// HOST_FS_FILE_SIZE bytes, kept for the life of the process.
+
+#define HOST_FS_FILES     8
+#define HOST_FS_FILE_SIZE 8192
+
+class File : public Stream {
+public:
+    File() : index(-1), position(0), writable(false) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    size_t read(uint8_t* buffer, size_t size);
+    int peek() override;
+    size_t size() const;
+    void close() { index = -1; }
+    operator bool() const { return index >= 0; }
+
+private:
+    friend class LittleFSFS;
+    int index;
+    size_t position;
+    bool writable;
+};
+
+class LittleFSFS {
+public:
+    bool begin(bool formatOnFail = false) { return true; }
+    File open(const char* path, const char* mode = "r", bool create = false);
+    bool exists(const char* path);
+    bool remove(const char* path);
+    bool format();
+};
+
+extern LittleFSFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
@@ -0,0 +1,30 @@
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+
+// --- NVS ---
+// In-memory key/value blobs, at most HOST_NVS_ENTRIES of HOST_NVS_BLOB_SIZE
+// bytes across all namespaces.
+
+#define HOST_NVS_ENTRIES   8
+#define HOST_NVS_BLOB_SIZE 512
+
+class Preferences {
+public:
+    Preferences() : space(nullptr), readOnly(true) {}
+
+    bool begin(const char* name, bool readOnly = false, const char* partition = nullptr);
+    void end() { space = nullptr; }
+    size_t putBytes(const char* key, const void* value, size_t length);
+    size_t getBytes(const char* key, void* buffer, size_t maxLength);
+    size_t getBytesLength(const char* key);
+    bool remove(const char* key);
+    bool clear();
+
+private:
+    const char* space;
+    bool readOnly;
+};
+
+#endif // HOST_PREFERENCES_H
@@ -0,0 +1,75 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class __FlashStringHelper;
+#define F(text) (reinterpret_cast<const __FlashStringHelper*>(text))
+
+// Heap-backed like the core's String, with the same small-string buffer, so
+// the allocation counts of the host build match the device for short text.
+class String {
+public:
+    String(const char* text = "");
+    String(const __FlashStringHelper* text) : String(reinterpret_cast<const char*>(text)) {}
+    String(const String& other);
+    String(String&& other);
+    explicit String(char c);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    ~String();
+
+    String& operator=(const String& other);
+    String& operator=(String&& other);
+    String& operator=(const char* text);
+
+    const char* c_str() const { return heap != nullptr ? heap : sso; }
+    unsigned int length() const { return len; }
+    bool reserve(unsigned int size);
+
+    bool concat(const char* text, unsigned int length);
+    bool concat(const char* text);
+    bool concat(const String& other) { return concat(other.c_str(), other.len); }
+    bool concat(char c) { return concat(&c, 1); }
+    String& operator+=(const String& other) { concat(other); return *this; }
+    String& operator+=(const char* text) { concat(text); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+
+    bool equals(const char* text) const;
+    bool equals(const String& other) const { return equals(other.c_str()); }
+    bool equalsIgnoreCase(const String& other) const;
+    bool operator==(const char* text) const { return equals(text); }
+    bool operator==(const String& other) const { return equals(other); }
+    bool operator!=(const char* text) const { return !equals(text); }
+    bool operator!=(const String& other) const { return !equals(other); }
+    bool startsWith(const String& prefix) const;
+    int indexOf(char c, unsigned int from = 0) const;
+    int indexOf(const char* text, unsigned int from = 0) const;
+    char operator[](unsigned int index) const { return index < len ? c_str()[index] : 0; }
+
+    String substring(unsigned int from, unsigned int to) const;
+    String substring(unsigned int from) const { return substring(from, len); }
+    long toInt() const;
+    void toUpperCase();
+    void toLowerCase();
+    void trim();
+
+private:
+    enum { SSO_SIZE = 16 };
+    char sso[SSO_SIZE];
+    char* heap;
+    unsigned int capacity;
+    unsigned int len;
+
+    char* buffer() { return heap != nullptr ? heap : sso; }
+    void assign(const char* text, unsigned int length);
+    void release();
+};
+
+String operator+(const String& a, const String& b);
+String operator+(const String& a, const char* b);
+
+#endif // HOST_WSTRING_H
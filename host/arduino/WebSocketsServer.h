@@ -0,0 +1,57 @@
+#ifndef HOST_WEBSOCKETSSERVER_H
+#define HOST_WEBSOCKETSSERVER_H
+
+#include "Arduino.h"
+#include "WiFi.h"
+#include <functional>
+
+// --- WebSocketsServer ---
+// Clients live in the process (hostWsConnect() and friends in host.h);
+// their events are delivered from loop() like the library does.
+
+#define WEBSOCKETS_SERVER_CLIENT_MAX 5
+
+typedef enum {
+    WStype_ERROR,
+    WStype_DISCONNECTED,
+    WStype_CONNECTED,
+    WStype_TEXT,
+    WStype_BIN,
+    WStype_PING,
+    WStype_PONG,
+} WStype_t;
+
+// The part of the library's per-client state a subclass may use
+struct WSclient_t {
+    WiFiClient* tcp;
+};
+
+class WebSocketsServer {
+public:
+    typedef std::function<void(uint8_t num, WStype_t type, uint8_t* payload, size_t length)> WebSocketServerEvent;
+
+    explicit WebSocketsServer(uint16_t port);
+
+    void begin() { started = true; }
+    void loop();
+    void onEvent(WebSocketServerEvent callback) { eventCallback = callback; }
+
+    bool sendTXT(uint8_t num, const char* payload, size_t length = 0, bool headerToPayload = false);
+    bool sendTXT(uint8_t num, const uint8_t* payload, size_t length = 0, bool headerToPayload = false) {
+        return sendTXT(num, (const char*)payload, length, headerToPayload);
+    }
+    bool sendBIN(uint8_t num, const uint8_t* payload, size_t length, bool headerToPayload = false);
+    void disconnect(uint8_t num);
+    int connectedClients();
+
+protected:
+    WSclient_t _clients[WEBSOCKETS_SERVER_CLIENT_MAX];
+
+private:
+    bool started;
+    WebSocketServerEvent eventCallback;
+
+    void event(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
+};
+
+#endif // HOST_WEBSOCKETSSERVER_H
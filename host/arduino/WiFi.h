@@ -0,0 +1,109 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+
+// --- WiFi ---
+// A station that associates after a delay and reports it through the same
+// events as the core. The HTTP server and its clients are real sockets on
+// 127.0.0.1; see host.h for the controls.
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED = 6,
+} wl_status_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_STA_START,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_STA_LOST_IP,
+} arduino_event_id_t;
+
+typedef union {
+    uint8_t reason; // wifi_event_sta_disconnected_t on the device
+} arduino_event_info_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+typedef arduino_event_info_t WiFiEventInfo_t;
+typedef void (*WiFiEventFuncCb)(WiFiEvent_t event, WiFiEventInfo_t info);
+
+typedef enum {
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+} wifi_mode_t;
+
+class WiFiClass {
+public:
+    wl_status_t status();
+    wl_status_t begin(const char* ssid, const char* password, int32_t channel = 0,
+                      const uint8_t* bssid = nullptr);
+    bool disconnect(bool wifiOff = false);
+    bool mode(wifi_mode_t mode);
+    bool setHostname(const char* name);
+    const char* getHostname();
+    bool setAutoReconnect(bool autoReconnect);
+    int onEvent(WiFiEventFuncCb callback);
+
+    IPAddress localIP();
+    int32_t channel();
+    uint8_t* BSSID();
+    int8_t RSSI();
+    int hostByName(const char* host, IPAddress& result);
+};
+
+extern WiFiClass WiFi;
+
+// Copies share the socket, like the core's shared handle; stop() closes it
+// for all of them
+class WiFiClient : public Stream {
+public:
+    WiFiClient();
+    WiFiClient(const WiFiClient& other);
+    WiFiClient& operator=(const WiFiClient& other);
+    ~WiFiClient();
+
+    uint8_t connected();
+    int available() override;
+    int read() override;
+    int read(uint8_t* buffer, size_t size);
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+    void stop();
+    void setNoDelay(bool noDelay) {}
+    int fd() const;
+    operator bool() { return connected(); }
+
+private:
+    friend class WiFiServer;
+    friend WiFiClient hostAdoptSocket(int fd);
+    explicit WiFiClient(int fd);
+
+    int slot; // Index in the shared socket table, -1 when empty
+    void release();
+};
+
+class WiFiServer {
+public:
+    explicit WiFiServer(uint16_t port, uint8_t maxClients = 4) : port(port), listener(-1), pending(-1) {}
+
+    void begin();
+    bool hasClient();
+    WiFiClient accept();
+    WiFiClient available() { return accept(); }
+    void setNoDelay(bool noDelay) {}
+
+private:
+    uint16_t port;
+    int listener;
+    int pending;
+};
+
+#endif // HOST_WIFI_H
@@ -0,0 +1,25 @@
+#ifndef HOST_WIFIUDP_H
+#define HOST_WIFIUDP_H
+
+#include "WiFi.h"
+
+// Datagrams are counted, not sent (see hostUdpPackets())
+class WiFiUDP : public Stream {
+public:
+    uint8_t begin(uint16_t port) { return 1; }
+    int beginPacket(IPAddress ip, uint16_t port);
+    int beginPacket(const char* host, uint16_t port);
+    int endPacket();
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+
+private:
+    bool open = false;
+    size_t length = 0;
+};
+
+#endif // HOST_WIFIUDP_H
@@ -0,0 +1,101 @@
+#include "host.h"
+#include <malloc.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Allocation Counter ---
+// Wraps glibc's allocator for the whole process. The counters are plain
+// statics: the host build is single threaded, like one core of loop().
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* pointer);
+}
+
+static HostAllocStats stats;
+
+static void* counted(void* pointer) {
+    if (pointer != nullptr) {
+        stats.allocations++;
+        stats.liveBytes += malloc_usable_size(pointer);
+        if (stats.liveBytes > stats.peakBytes) {
+            stats.peakBytes = stats.liveBytes;
+        }
+    }
+    return pointer;
+}
+
+static void released(void* pointer) {
+    if (pointer != nullptr) {
+        stats.frees++;
+        stats.liveBytes -= malloc_usable_size(pointer);
+    }
+}
+
+HostAllocStats hostAllocStats() {
+    return stats;
+}
+
+void hostResetPeak() {
+    stats.peakBytes = stats.liveBytes;
+}
+
+extern "C" {
+
+void* malloc(size_t size) {
+    return counted(__libc_malloc(size));
+}
+
+void* calloc(size_t count, size_t size) {
+    return counted(__libc_calloc(count, size));
+}
+
+void* realloc(void* pointer, size_t size) {
+    if (pointer == nullptr) {
+        return malloc(size);
+    }
+    if (size == 0) {
+        free(pointer);
+        return nullptr;
+    }
+    size_t before = malloc_usable_size(pointer);
+    void* moved = __libc_realloc(pointer, size);
+    if (moved != nullptr) {
+        // Growing a block is an allocation as far as fragmentation goes
+        stats.allocations++;
+        stats.frees++;
+        stats.liveBytes += malloc_usable_size(moved) - before;
+        if (stats.liveBytes > stats.peakBytes) {
+            stats.peakBytes = stats.liveBytes;
+        }
+    }
+    return moved;
+}
+
+void free(void* pointer) {
+    released(pointer);
+    __libc_free(pointer);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    return counted(__libc_memalign(alignment, size));
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    void* pointer = memalign(alignment, size);
+    if (pointer == nullptr) {
+        return ENOMEM;
+    }
+    *out = pointer;
+    return 0;
+}
+
+}
@@ -0,0 +1,437 @@
+#include "Arduino.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "host.h"
+#include <chrono>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// --- Virtual Clock ---
+
+static uint64_t nowUs = 0;
+
+struct ScheduledEvent {
+    bool pending;
+    uint64_t atUs;
+    uint32_t order; // Ties run in the order they were scheduled
+    HostEvent event;
+    void* arg;
+};
+
+struct esp_timer {
+    bool used;
+    bool armed;
+    uint64_t atUs;
+    uint64_t periodUs;
+    uint32_t order;
+    esp_timer_cb_t callback;
+    void* arg;
+};
+
+#define HOST_MAX_TIMERS 8
+
+static ScheduledEvent events[HOST_MAX_EVENTS];
+static esp_timer timers[HOST_MAX_TIMERS];
+static uint32_t nextOrder = 0;
+
+uint64_t hostNow() {
+    return nowUs;
+}
+
+bool hostSchedule(uint64_t atUs, HostEvent event, void* arg) {
+    for (ScheduledEvent& slot : events) {
+        if (!slot.pending) {
+            slot = { true, atUs, nextOrder++, event, arg };
+            return true;
+        }
+    }
+    return false;
+}
+
+void hostCancel(HostEvent event, void* arg) {
+    for (ScheduledEvent& slot : events) {
+        if (slot.pending && slot.event == event && slot.arg == arg) {
+            slot.pending = false;
+        }
+    }
+}
+
+static bool before(uint64_t atUs, uint32_t order, uint64_t bestUs, uint32_t bestOrder) {
+    return atUs < bestUs || (atUs == bestUs && order < bestOrder);
+}
+
+// Fires the earliest event or timer due at or before 'limitUs'
+static bool runNext(uint64_t limitUs) {
+    ScheduledEvent* event = nullptr;
+    esp_timer* timer = nullptr;
+    uint64_t at = UINT64_MAX;
+    uint32_t order = UINT32_MAX;
+    for (ScheduledEvent& slot : events) {
+        if (slot.pending && slot.atUs <= limitUs && before(slot.atUs, slot.order, at, order)) {
+            event = &slot;
+            at = slot.atUs;
+            order = slot.order;
+        }
+    }
+    for (esp_timer& slot : timers) {
+        if (slot.armed && slot.atUs <= limitUs && before(slot.atUs, slot.order, at, order)) {
+            event = nullptr;
+            timer = &slot;
+            at = slot.atUs;
+            order = slot.order;
+        }
+    }
+    if (event == nullptr && timer == nullptr) {
+        return false;
+    }
+
+    if (at > nowUs) {
+        nowUs = at;
+    }
+    if (event != nullptr) {
+        event->pending = false;
+        event->event(event->arg);
+    } else {
+        if (timer->periodUs > 0) {
+            timer->atUs += timer->periodUs;
+            timer->order = nextOrder++;
+        } else {
+            timer->armed = false;
+        }
+        timer->callback(timer->arg);
+    }
+    return true;
+}
+
+void hostAdvance(uint64_t us) {
+    uint64_t target = nowUs + us;
+    while (runNext(target)) {
+    }
+    nowUs = target;
+}
+
+void hostAdvanceMs(uint32_t ms) {
+    hostAdvance((uint64_t)ms * 1000);
+}
+
+unsigned long millis() {
+    return (unsigned long)(nowUs / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)nowUs;
+}
+
+void delay(uint32_t ms) {
+    hostAdvance((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(uint32_t us) {
+    hostAdvance(us);
+}
+
+void yield() {
+}
+
+// --- esp_timer ---
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle) {
+    for (esp_timer& timer : timers) {
+        if (!timer.used) {
+            timer = {};
+            timer.used = true;
+            timer.callback = args->callback;
+            timer.arg = args->arg;
+            *handle = &timer;
+            return ESP_OK;
+        }
+    }
+    return ESP_FAIL;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+    if (timer->armed) {
+        return ESP_FAIL; // ESP_ERR_INVALID_STATE on the device
+    }
+    timer->armed = true;
+    timer->atUs = nowUs + timeoutUs;
+    timer->periodUs = 0;
+    timer->order = nextOrder++;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs) {
+    if (timer->armed) {
+        return ESP_FAIL;
+    }
+    timer->armed = true;
+    timer->atUs = nowUs + periodUs;
+    timer->periodUs = periodUs;
+    timer->order = nextOrder++;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (!timer->armed) {
+        return ESP_FAIL;
+    }
+    timer->armed = false;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time() {
+    return (int64_t)nowUs;
+}
+
+// --- Pins ---
+
+#define HOST_PINS 40
+
+static uint8_t pinLevels[HOST_PINS];
+static uint32_t pinWrites[HOST_PINS];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < HOST_PINS) {
+        pinLevels[pin] = value;
+        pinWrites[pin]++;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < HOST_PINS ? pinLevels[pin] : LOW;
+}
+
+int hostPinLevel(uint8_t pin) {
+    return digitalRead(pin);
+}
+
+uint32_t hostPinWrites(uint8_t pin) {
+    return pin < HOST_PINS ? pinWrites[pin] : 0;
+}
+
+// --- Random ---
+
+static uint32_t randomState = 0x2545F491;
+
+void hostSeed(uint32_t seed) {
+    randomState = seed != 0 ? seed : 0x2545F491;
+}
+
+uint32_t esp_random() {
+    // xorshift32
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+long random(long howBig) {
+    return howBig > 0 ? (long)(esp_random() % (uint32_t)howBig) : 0;
+}
+
+long random(long howSmall, long howBig) {
+    return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+void randomSeed(unsigned long seed) {
+    hostSeed((uint32_t)seed);
+}
+
+// --- Wall Clock ---
+// configTime() starts the fake SNTP client: the first reply arrives
+// hostNtpSetDelay() ms after WiFi is up, and time() jumps to the epoch.
+
+static uint32_t epochAtBoot = 1767225600; // 2026-01-01
+static uint32_t ntpDelayMs = 1500;
+static bool sntpStarted = false;
+static bool sntpSynced = false;
+
+void hostSetEpoch(uint32_t epoch) {
+    epochAtBoot = epoch;
+}
+
+void hostNtpSetDelay(uint32_t ms) {
+    ntpDelayMs = ms;
+}
+
+static void sntpPoll(void* arg) {
+    if (hostWifiConnected()) {
+        sntpSynced = true;
+        return;
+    }
+    hostSchedule(nowUs + 15000000ULL, sntpPoll, nullptr); // lwIP's retry interval
+}
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec, const char* server1,
+                const char* server2, const char* server3) {
+    if (!sntpStarted) {
+        sntpStarted = true;
+        hostSchedule(nowUs + (uint64_t)ntpDelayMs * 1000, sntpPoll, nullptr);
+    }
+}
+
+// Replaces the C library's time() for the whole process. The sketch's clock
+// (ntp_clock.cpp) is the only caller that matters.
+extern "C" time_t time(time_t* out) {
+    time_t value = (time_t)(nowUs / 1000000);
+    if (sntpSynced) {
+        value += epochAtBoot;
+    }
+    if (out != nullptr) {
+        *out = value;
+    }
+    return value;
+}
+
+// --- Serial ---
+
+HardwareSerial Serial;
+static bool echoSerial = false;
+
+void hostEchoSerial(bool echo) {
+    echoSerial = echo;
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t size) {
+    if (echoSerial) {
+        fwrite(data, 1, size, stdout);
+    }
+    return size;
+}
+
+// --- ESP ---
+// The device heap is ~320 KB; the host reports that minus what the sketch
+// (and the fakes) hold, so the numbers move the same way.
+
+#define HOST_HEAP_SIZE (320 * 1024)
+
+EspClass ESP;
+static size_t minFreeHeap = HOST_HEAP_SIZE;
+
+uint32_t EspClass::getFreeHeap() {
+    HostAllocStats stats = hostAllocStats();
+    size_t free = stats.liveBytes < HOST_HEAP_SIZE ? HOST_HEAP_SIZE - stats.liveBytes : 0;
+    if (free < minFreeHeap) {
+        minFreeHeap = free;
+    }
+    return (uint32_t)free;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    getFreeHeap();
+    return (uint32_t)minFreeHeap;
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    return getFreeHeap();
+}
+
+uint32_t EspClass::getHeapSize() {
+    return HOST_HEAP_SIZE;
+}
+
+static uint64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Wall time in 240 MHz cycles. PerfScope reads it twice per scope, and on
+// the device that is one register read, so where there is a TSC it is
+// read instead of steady_clock and scaled by a rate measured once.
+#if defined(__x86_64__) || defined(__i386__)
+static double cyclesPerTick() {
+    static double rate = 0;
+    if (rate == 0) {
+        uint64_t startNs = steadyNs();
+        uint64_t startTicks = __rdtsc();
+        while (steadyNs() - startNs < 5000000) {
+        }
+        rate = (steadyNs() - startNs) * (ESP.getCpuFreqMHz() / 1000.0) / (double)(__rdtsc() - startTicks);
+    }
+    return rate;
+}
+
+uint32_t EspClass::getCycleCount() {
+    static const double rate = cyclesPerTick();
+    return (uint32_t)(uint64_t)(__rdtsc() * rate);
+}
+#else
+uint32_t EspClass::getCycleCount() {
+    return (uint32_t)(steadyNs() * getCpuFreqMHz() / 1000);
+}
+#endif
+
+void EspClass::restart() {
+    fflush(stdout);
+    fprintf(stderr, "ESP.restart() at %llu ms\n", (unsigned long long)(nowUs / 1000));
+    _exit(0);
+}
+
+void heap_caps_get_info(multi_heap_info_t* info, unsigned int caps) {
+    HostAllocStats stats = hostAllocStats();
+    memset(info, 0, sizeof(*info));
+    info->total_free_bytes = ESP.getFreeHeap();
+    info->total_allocated_bytes = stats.liveBytes;
+    info->largest_free_block = info->total_free_bytes;
+    info->minimum_free_bytes = ESP.getMinFreeHeap();
+    info->allocated_blocks = stats.allocations - stats.frees;
+}
+
+// --- FreeRTOS ---
+
+void hostEnterCritical(portMUX_TYPE* mux) {
+    if (mux->depth != 0) {
+        fprintf(stderr, "portENTER_CRITICAL on a held lock\n");
+        abort();
+    }
+    mux->depth++;
+}
+
+void hostExitCritical(portMUX_TYPE* mux) {
+    if (mux->depth != 1) {
+        fprintf(stderr, "portEXIT_CRITICAL without portENTER_CRITICAL\n");
+        abort();
+    }
+    mux->depth--;
+}
+
+static void noTasks(const char* call) {
+    fprintf(stderr, "%s: the host build has no tasks, build with RENDER_TASK 0\n", call);
+    abort();
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*task)(void*), const char* name, uint32_t stackDepth,
+                                   void* parameter, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core) {
+    noTasks("xTaskCreatePinnedToCore");
+    return pdFAIL;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    noTasks("vTaskDelete");
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks * portTICK_PERIOD_MS);
+}
+
+void xTaskNotifyGive(TaskHandle_t task) {
+    noTasks("xTaskNotifyGive");
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    noTasks("ulTaskNotifyTake");
+    return 0;
+}
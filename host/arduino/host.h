@@ -0,0 +1,142 @@
+#ifndef HOST_HOST_H
+#define HOST_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// --- Host Controls ---
+// The side of the fake Arduino layer that the simulation and the tests
+// drive: the virtual clock, the network the sketch sees, and counters for
+// what it did with the hardware. Nothing in main/ includes this file.
+
+// --- Virtual Clock ---
+// Starts at 0 like millis() after reset. hostAdvance() moves it forward
+// and runs, in time order, every esp_timer and scheduled event that falls
+// due on the way; delay() inside the sketch does the same.
+
+uint64_t hostNow();                        // Virtual microseconds since boot
+void hostAdvance(uint64_t us);
+void hostAdvanceMs(uint32_t ms);
+
+typedef void (*HostEvent)(void* arg);
+#define HOST_MAX_EVENTS 32
+
+// Runs 'event' once the clock reaches 'atUs'; false when the table is full
+bool hostSchedule(uint64_t atUs, HostEvent event, void* arg);
+void hostCancel(HostEvent event, void* arg);
+
+// esp_random() and random() are a fixed-seed PRNG, so runs repeat exactly
+void hostSeed(uint32_t seed);
+
+// Wall time the clock reports once SNTP syncs; until then time() counts
+// seconds since boot, like the device
+void hostSetEpoch(uint32_t epochAtBoot);
+
+// Serial output goes to stdout only when echoed
+void hostEchoSerial(bool echo);
+
+// Digital pins, as last written by the sketch
+int hostPinLevel(uint8_t pin);
+uint32_t hostPinWrites(uint8_t pin);
+
+// --- Allocation Counter ---
+// malloc(), free() and friends are wrapped for the whole process (and so
+// new/delete and String). Snapshot before and after the code of interest.
+
+struct HostAllocStats {
+    uint64_t allocations; // malloc/calloc/realloc calls that returned a new block
+    uint64_t frees;
+    size_t liveBytes;
+    size_t peakBytes;     // Since start, or since hostResetPeak()
+};
+
+HostAllocStats hostAllocStats();
+void hostResetPeak();
+
+// --- WiFi ---
+// The access point is in range by default; WiFi.begin() gets an IP after
+// the association delay.
+
+void hostWifiSetAvailable(bool available); // false drops a live association
+void hostWifiSetConnectDelay(uint32_t ms);
+void hostNtpSetDelay(uint32_t ms);          // From WiFi up to the first SNTP reply
+bool hostWifiConnected();
+uint32_t hostUdpPackets();
+uint64_t hostUdpBytes();
+
+// dns_gethostbyname() answers after the delay (20 ms by default) with the
+// loopback address, or with nothing while WiFi is down or DNS is not
+void hostDnsSetDelay(uint32_t ms);
+void hostDnsSetAvailable(bool available);
+uint32_t hostDnsLookups();
+
+// --- Home Assistant WebSocket ---
+// The far end of the ArduinoWebsockets client. connect() asks the peer;
+// sent text is handed to it right away, and whatever it queues with
+// hostHassDeliver() reaches onMessage() on the sketch's next poll().
+
+class HostHassPeer {
+public:
+    virtual ~HostHassPeer() {}
+    virtual bool accept(const char* host, uint16_t port, const char* path) = 0;
+    virtual void onOpened() = 0; // Accepted; hostHassDeliver() works from here
+    virtual void onText(const char* data, size_t length) = 0;
+    virtual void onClosed() = 0; // The sketch closed the connection
+};
+
+#define HOST_HASS_QUEUE        16
+#define HOST_HASS_MESSAGE_SIZE 8192
+
+void hostHassSetPeer(HostHassPeer* peer);
+bool hostHassDeliver(const char* data, size_t length); // false when the queue is full
+void hostHassDrop();                                   // The peer closes the connection
+bool hostHassOpen();
+
+// --- WebSocket Server (port 81) ---
+// In-process clients; their events reach the sketch on its next
+// webSocket.loop(). Each is a socket pair whose sketch end has a send
+// buffer the size of lwIP's, and the client reads it empty on every
+// webSocket.loop(). A stalled client stops reading: sends still go through
+// while they fit the buffer, one that does not blocks until the write
+// timeout and drops the client, as the library does. A client on a slow
+// link reads at most readRate bytes per second of virtual time, so sends
+// to it wait while its buffer drains.
+
+#define HOST_WS_CLIENTS          5    // WEBSOCKETS_SERVER_CLIENT_MAX
+#define HOST_WS_SEND_BUFFER      5744 // TCP_SND_BUF of the ESP32's lwIP
+#define HOST_WS_TEXT_KEEP        16384
+#define HOST_WS_BIN_KEEP         4096
+#define HOST_WS_WRITE_TIMEOUT_US 5000000
+
+struct HostWsClient {
+    bool connected;
+    bool stalled;
+    uint32_t readRate;  // Bytes per second, 0 for as fast as it arrives
+    uint64_t lastRead;  // Virtual time of the last read
+    int peer;           // The client's end of the socket pair
+    uint32_t texts;
+    uint32_t binaries;
+    uint64_t bytes;
+    uint64_t blockedUs; // Virtual time sends to it spent waiting for buffer space
+    size_t lastTextLength;
+    size_t lastBinLength;
+    char lastText[HOST_WS_TEXT_KEEP];
+    uint8_t lastBin[HOST_WS_BIN_KEEP];
+};
+
+class WiFiClient;
+WiFiClient hostAdoptSocket(int fd); // A WiFiClient over a socket the fake layer opened
+
+int hostWsConnect();                        // Client number, -1 when all are taken
+void hostWsSend(int num, const char* text); // Arrives as WStype_TEXT
+void hostWsClose(int num);
+void hostWsStall(int num, bool stalled);
+void hostWsSetReadRate(int num, uint32_t bytesPerSecond);
+const HostWsClient& hostWsClient(int num);
+
+// --- HTTP Server ---
+// WiFiServer listens on 127.0.0.1 on an ephemeral port
+
+uint16_t hostHttpPort();
+
+#endif // HOST_HOST_H
@@ -0,0 +1,32 @@
+#ifndef HOST_LWIP_IP_ADDR_H
+#define HOST_LWIP_IP_ADDR_H
+
+#include <stdint.h>
+
+// lwIP's dual-stack address, as the ESP32 builds it; IPv4 addresses are in
+// network byte order
+typedef struct {
+    uint32_t addr;
+} ip4_addr_t;
+
+typedef struct {
+    uint32_t addr[4];
+    uint8_t zone;
+} ip6_addr_t;
+
+#define IPADDR_TYPE_V4 0U
+#define IPADDR_TYPE_V6 6U
+
+typedef struct {
+    union {
+        ip6_addr_t ip6;
+        ip4_addr_t ip4;
+    } u_addr;
+    uint8_t type;
+} ip_addr_t;
+
+#define IP_IS_V4(ipaddr)         ((ipaddr)->type == IPADDR_TYPE_V4)
+#define ip_2_ip4(ipaddr)         (&((ipaddr)->u_addr.ip4))
+#define ip4_addr_get_u32(ip4)    ((ip4)->addr)
+
+#endif // HOST_LWIP_IP_ADDR_H
@@ -0,0 +1,9 @@
+#ifndef HOST_LWIP_SOCKETS_H
+#define HOST_LWIP_SOCKETS_H
+
+// select() and the socket calls, which lwIP provides on the device
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#endif // HOST_LWIP_SOCKETS_H
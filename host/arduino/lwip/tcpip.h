@@ -0,0 +1,12 @@
+#ifndef HOST_LWIP_TCPIP_H
+#define HOST_LWIP_TCPIP_H
+
+#include "lwip/err.h"
+
+// There is no TCP/IP task on the host: the function runs from the event
+// queue on the next advance of the virtual clock
+typedef void (*tcpip_callback_fn)(void* ctx);
+
+err_t tcpip_callback(tcpip_callback_fn function, void* ctx);
+
+#endif // HOST_LWIP_TCPIP_H
@@ -0,0 +1,39 @@
+#include "Adafruit_NeoPixel.h"
+#include "host.h"
+
+// Like the library, the pixel buffer is allocated by the constructor (the
+// global strip is built before setup())
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t count, int16_t pin, uint16_t type)
+    : count(count), brightness(0), showCount(0), lastShow(0) {
+    pixels = (uint32_t*)calloc(count, sizeof(uint32_t));
+    shown = (uint32_t*)calloc(count, sizeof(uint32_t));
+}
+
+Adafruit_NeoPixel::~Adafruit_NeoPixel() {
+    free(pixels);
+    free(shown);
+}
+
+void Adafruit_NeoPixel::show() {
+    memcpy(shown, pixels, count * sizeof(uint32_t));
+    showCount++;
+    lastShow = hostNow();
+}
+
+void Adafruit_NeoPixel::clear() {
+    memset(pixels, 0, count * sizeof(uint32_t));
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t index, uint32_t color) {
+    if (index < count) {
+        pixels[index] = color & 0xFFFFFF;
+    }
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    setPixelColor(index, Color(r, g, b));
+}
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t index) const {
+    return index < count ? pixels[index] : 0;
+}
@@ -0,0 +1,192 @@
+#include "LittleFS.h"
+#include "Preferences.h"
+
+// --- LittleFS ---
+
+struct HostFile {
+    bool used;
+    char path[32];
+    size_t size;
+    uint8_t data[HOST_FS_FILE_SIZE];
+};
+
+static HostFile files[HOST_FS_FILES];
+LittleFSFS LittleFS;
+
+static int findFile(const char* path) {
+    for (int i = 0; i < HOST_FS_FILES; i++) {
+        if (files[i].used && strcmp(files[i].path, path) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+File LittleFSFS::open(const char* path, const char* mode, bool create) {
+    File file;
+    int index = findFile(path);
+    bool write = mode[0] == 'w' || mode[0] == 'a';
+    if (index < 0 && write) {
+        for (int i = 0; i < HOST_FS_FILES && index < 0; i++) {
+            if (!files[i].used) {
+                index = i;
+                files[i].used = true;
+                snprintf(files[i].path, sizeof(files[i].path), "%s", path);
+                files[i].size = 0;
+            }
+        }
+    }
+    if (index < 0) {
+        return file;
+    }
+    if (mode[0] == 'w') {
+        files[index].size = 0;
+    }
+    file.index = index;
+    file.writable = write;
+    file.position = mode[0] == 'a' ? files[index].size : 0;
+    return file;
+}
+
+bool LittleFSFS::exists(const char* path) {
+    return findFile(path) >= 0;
+}
+
+bool LittleFSFS::remove(const char* path) {
+    int index = findFile(path);
+    if (index < 0) {
+        return false;
+    }
+    files[index].used = false;
+    return true;
+}
+
+bool LittleFSFS::format() {
+    memset(files, 0, sizeof(files));
+    return true;
+}
+
+size_t File::write(const uint8_t* data, size_t length) {
+    if (index < 0 || !writable) {
+        return 0;
+    }
+    HostFile& file = files[index];
+    size_t room = HOST_FS_FILE_SIZE - position;
+    size_t written = min(length, room); // A full flash cuts the write short
+    memcpy(file.data + position, data, written);
+    position += written;
+    if (position > file.size) {
+        file.size = position;
+    }
+    return written;
+}
+
+int File::available() {
+    return index >= 0 ? (int)(files[index].size - position) : 0;
+}
+
+size_t File::read(uint8_t* buffer, size_t length) {
+    if (index < 0) {
+        return 0;
+    }
+    size_t count = min(length, files[index].size - position);
+    memcpy(buffer, files[index].data + position, count);
+    position += count;
+    return count;
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek() {
+    return index >= 0 && position < files[index].size ? files[index].data[position] : -1;
+}
+
+size_t File::size() const {
+    return index >= 0 ? files[index].size : 0;
+}
+
+// --- NVS ---
+
+struct HostBlob {
+    bool used;
+    char space[16];
+    char key[16];
+    size_t length;
+    uint8_t data[HOST_NVS_BLOB_SIZE];
+};
+
+static HostBlob blobs[HOST_NVS_ENTRIES];
+
+static HostBlob* findBlob(const char* space, const char* key) {
+    for (HostBlob& blob : blobs) {
+        if (blob.used && strcmp(blob.space, space) == 0 && strcmp(blob.key, key) == 0) {
+            return &blob;
+        }
+    }
+    return nullptr;
+}
+
+bool Preferences::begin(const char* name, bool readOnly, const char* partition) {
+    space = name;
+    this->readOnly = readOnly;
+    return true;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length) {
+    if (space == nullptr || readOnly || length > HOST_NVS_BLOB_SIZE) {
+        return 0;
+    }
+    HostBlob* blob = findBlob(space, key);
+    for (int i = 0; i < HOST_NVS_ENTRIES && blob == nullptr; i++) {
+        if (!blobs[i].used) {
+            blob = &blobs[i];
+            blob->used = true;
+            snprintf(blob->space, sizeof(blob->space), "%s", space);
+            snprintf(blob->key, sizeof(blob->key), "%s", key);
+        }
+    }
+    if (blob == nullptr) {
+        return 0;
+    }
+    memcpy(blob->data, value, length);
+    blob->length = length;
+    return length;
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLength) {
+    HostBlob* blob = space != nullptr ? findBlob(space, key) : nullptr;
+    if (blob == nullptr || blob->length > maxLength) {
+        return 0;
+    }
+    memcpy(buffer, blob->data, blob->length);
+    return blob->length;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+    HostBlob* blob = space != nullptr ? findBlob(space, key) : nullptr;
+    return blob != nullptr ? blob->length : 0;
+}
+
+bool Preferences::remove(const char* key) {
+    HostBlob* blob = space != nullptr && !readOnly ? findBlob(space, key) : nullptr;
+    if (blob == nullptr) {
+        return false;
+    }
+    blob->used = false;
+    return true;
+}
+
+bool Preferences::clear() {
+    if (space == nullptr || readOnly) {
+        return false;
+    }
+    for (HostBlob& blob : blobs) {
+        if (blob.used && strcmp(blob.space, space) == 0) {
+            blob.used = false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,342 @@
+#include "ArduinoWebsockets.h"
+#include "WebSocketsServer.h"
+#include "host.h"
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// --- Home Assistant Link ---
+
+#define HOST_HASS_HANDSHAKE_MS 20 // connect() blocks for TCP and the upgrade
+
+struct QueuedMessage {
+    size_t length;
+    char data[HOST_HASS_MESSAGE_SIZE];
+};
+
+static HostHassPeer* hassPeer = nullptr;
+static bool hassOpen = false;
+static bool hassDropped = false;
+static QueuedMessage hassQueue[HOST_HASS_QUEUE];
+static int hassHead = 0;
+static int hassCount = 0;
+
+void hostHassSetPeer(HostHassPeer* peer) {
+    hassPeer = peer;
+}
+
+bool hostHassDeliver(const char* data, size_t length) {
+    if (!hassOpen || hassCount == HOST_HASS_QUEUE || length >= HOST_HASS_MESSAGE_SIZE) {
+        return false;
+    }
+    QueuedMessage& message = hassQueue[(hassHead + hassCount) % HOST_HASS_QUEUE];
+    memcpy(message.data, data, length);
+    message.data[length] = '\0';
+    message.length = length;
+    hassCount++;
+    return true;
+}
+
+void hostHassDrop() {
+    if (hassOpen) {
+        hassDropped = true;
+    }
+}
+
+bool hostHassOpen() {
+    return hassOpen;
+}
+
+namespace websockets {
+
+bool WebsocketsClient::connect(const char* host, int port, const char* path) {
+    delay(HOST_HASS_HANDSHAKE_MS);
+    if (hassOpen || hassPeer == nullptr || !hostWifiConnected() || !hassPeer->accept(host, port, path)) {
+        return false;
+    }
+    hassOpen = true;
+    hassDropped = false;
+    hassHead = 0;
+    hassCount = 0;
+    hassPeer->onOpened();
+    if (eventCallback) {
+        eventCallback(WebsocketsEvent::ConnectionOpened, WSInterfaceString());
+    }
+    return true;
+}
+
+void WebsocketsClient::closed() {
+    hassOpen = false;
+    hassDropped = false;
+    hassCount = 0;
+    if (eventCallback) {
+        eventCallback(WebsocketsEvent::ConnectionClosed, WSInterfaceString());
+    }
+}
+
+bool WebsocketsClient::poll() {
+    if (!hassOpen) {
+        return false;
+    }
+    if (hassDropped) {
+        closed();
+        return false;
+    }
+    // Only what had arrived when poll() started; replies the peer queues
+    // from onText() wait for the next one
+    for (int pending = hassCount; pending > 0 && hassOpen && !hassDropped; pending--) {
+        QueuedMessage& message = hassQueue[hassHead];
+        if (messageCallback) {
+            messageCallback(WebsocketsMessage(MessageType::Text, message.data, message.length));
+        }
+        hassHead = (hassHead + 1) % HOST_HASS_QUEUE;
+        hassCount--;
+    }
+    return hassOpen;
+}
+
+bool WebsocketsClient::send(const char* data, size_t length) {
+    if (!hassOpen || hassDropped) {
+        return false;
+    }
+    hassPeer->onText(data, length);
+    return true;
+}
+
+bool WebsocketsClient::available() const {
+    return hassOpen;
+}
+
+void WebsocketsClient::close() {
+    if (!hassOpen) {
+        return;
+    }
+    if (hassPeer != nullptr) {
+        hassPeer->onClosed();
+    }
+    closed();
+}
+
+} // namespace websockets
+
+// --- WebSocket Server ---
+
+#define HOST_WS_EVENTS    16
+#define HOST_WS_EVENT_MAX 128
+
+struct ServerEvent {
+    uint8_t num;
+    WStype_t type;
+    size_t length;
+    char text[HOST_WS_EVENT_MAX];
+};
+
+static HostWsClient wsClients[HOST_WS_CLIENTS];
+static WiFiClient wsSockets[HOST_WS_CLIENTS]; // The sketch's ends
+static ServerEvent wsEvents[HOST_WS_EVENTS];
+static int wsEventHead = 0;
+static int wsEventCount = 0;
+
+static bool queueServerEvent(int num, WStype_t type, const char* text) {
+    if (wsEventCount == HOST_WS_EVENTS) {
+        return false;
+    }
+    ServerEvent& event = wsEvents[(wsEventHead + wsEventCount) % HOST_WS_EVENTS];
+    event.num = num;
+    event.type = type;
+    snprintf(event.text, sizeof(event.text), "%s", text);
+    event.length = strlen(event.text);
+    wsEventCount++;
+    return true;
+}
+
+int hostWsConnect() {
+    for (int i = 0; i < HOST_WS_CLIENTS; i++) {
+        if (wsClients[i].connected) {
+            continue;
+        }
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, pair) < 0) {
+            return -1;
+        }
+        // Linux doubles what it is asked for
+        int size = HOST_WS_SEND_BUFFER / 2;
+        setsockopt(pair[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+        wsSockets[i] = hostAdoptSocket(pair[0]);
+        if (wsSockets[i].fd() < 0) {
+            close(pair[1]);
+            return -1;
+        }
+        memset(&wsClients[i], 0, sizeof(wsClients[i]));
+        wsClients[i].connected = true;
+        wsClients[i].peer = pair[1];
+        queueServerEvent(i, WStype_CONNECTED, "/");
+        return i;
+    }
+    return -1;
+}
+
+void hostWsSend(int num, const char* text) {
+    queueServerEvent(num, WStype_TEXT, text);
+}
+
+void hostWsClose(int num) {
+    queueServerEvent(num, WStype_DISCONNECTED, "");
+}
+
+void hostWsStall(int num, bool stalled) {
+    wsClients[num].stalled = stalled;
+}
+
+void hostWsSetReadRate(int num, uint32_t bytesPerSecond) {
+    wsClients[num].readRate = bytesPerSecond;
+    wsClients[num].lastRead = hostNow();
+}
+
+const HostWsClient& hostWsClient(int num) {
+    return wsClients[num];
+}
+
+WebSocketsServer::WebSocketsServer(uint16_t port) : started(false) {
+    for (int i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        _clients[i].tcp = &wsSockets[i];
+    }
+}
+
+#define HOST_WS_READ_WAIT_US 10000 // How long a send waits for a slow client between reads
+
+// The client reads what has arrived, as much as its rate allows since the
+// last read
+static void drain(HostWsClient& client) {
+    if (client.stalled) {
+        return;
+    }
+    uint64_t now = hostNow();
+    uint64_t budget = client.readRate > 0 ? (now - client.lastRead) * client.readRate / 1000000 : UINT64_MAX;
+    uint8_t scratch[2048];
+    while (budget > 0) {
+        ssize_t got = recv(client.peer, scratch, (size_t)min(budget, (uint64_t)sizeof(scratch)), MSG_DONTWAIT);
+        if (got <= 0) {
+            break;
+        }
+        budget -= got;
+    }
+    client.lastRead = now;
+}
+
+static void closeClient(int num) {
+    wsSockets[num].stop();
+    close(wsClients[num].peer);
+    wsClients[num].peer = -1;
+    wsClients[num].connected = false;
+}
+
+void WebSocketsServer::event(uint8_t num, WStype_t type, uint8_t* payload, size_t length) {
+    if (eventCallback) {
+        eventCallback(num, type, payload, length);
+    }
+}
+
+void WebSocketsServer::loop() {
+    if (!started) {
+        return;
+    }
+    for (HostWsClient& client : wsClients) {
+        if (client.connected) {
+            drain(client);
+        }
+    }
+    for (int pending = wsEventCount; pending > 0; pending--) {
+        ServerEvent& queued = wsEvents[wsEventHead];
+        wsEventHead = (wsEventHead + 1) % HOST_WS_EVENTS;
+        wsEventCount--;
+        if (queued.type == WStype_DISCONNECTED) {
+            if (!wsClients[queued.num].connected) {
+                continue;
+            }
+            closeClient(queued.num);
+        } else if (!wsClients[queued.num].connected) {
+            continue;
+        }
+        event(queued.num, queued.type, (uint8_t*)queued.text, queued.length);
+    }
+}
+
+// Writes the whole message like the library, waiting while the send buffer
+// is full; a client that does not read makes the write time out and is
+// dropped
+static bool transmit(WebSocketsServer& server, uint8_t num, const void* payload, size_t length) {
+    if (num >= HOST_WS_CLIENTS || !wsClients[num].connected) {
+        return false;
+    }
+    HostWsClient& client = wsClients[num];
+    int fd = wsSockets[num].fd();
+    size_t sent = 0;
+    while (sent < length) {
+        ssize_t result = send(fd, (const uint8_t*)payload + sent, length - sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (result > 0) {
+            sent += result;
+            continue;
+        }
+        bool full = result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        if (!full || client.stalled) {
+            if (full) {
+                hostAdvance(HOST_WS_WRITE_TIMEOUT_US);
+                client.blockedUs += HOST_WS_WRITE_TIMEOUT_US;
+            }
+            server.disconnect(num);
+            return false;
+        }
+        if (client.readRate > 0) {
+            hostAdvance(HOST_WS_READ_WAIT_US);
+            client.blockedUs += HOST_WS_READ_WAIT_US;
+        }
+        drain(client);
+    }
+    return true;
+}
+
+bool WebSocketsServer::sendTXT(uint8_t num, const char* payload, size_t length, bool headerToPayload) {
+    if (length == 0) {
+        length = strlen(payload);
+    }
+    if (!transmit(*this, num, payload, length)) {
+        return false;
+    }
+    HostWsClient& client = wsClients[num];
+    size_t kept = min(length, (size_t)HOST_WS_TEXT_KEEP - 1);
+    memcpy(client.lastText, payload, kept);
+    client.lastText[kept] = '\0';
+    client.lastTextLength = length;
+    client.texts++;
+    client.bytes += length;
+    return true;
+}
+
+bool WebSocketsServer::sendBIN(uint8_t num, const uint8_t* payload, size_t length, bool headerToPayload) {
+    if (!transmit(*this, num, payload, length)) {
+        return false;
+    }
+    HostWsClient& client = wsClients[num];
+    memcpy(client.lastBin, payload, min(length, (size_t)HOST_WS_BIN_KEEP));
+    client.lastBinLength = length;
+    client.binaries++;
+    client.bytes += length;
+    return true;
+}
+
+void WebSocketsServer::disconnect(uint8_t num) {
+    if (num >= HOST_WS_CLIENTS || !wsClients[num].connected) {
+        return;
+    }
+    closeClient(num);
+    event(num, WStype_DISCONNECTED, nullptr, 0);
+}
+
+int WebSocketsServer::connectedClients() {
+    int count = 0;
+    for (const HostWsClient& client : wsClients) {
+        count += client.connected ? 1 : 0;
+    }
+    return count;
+}
@@ -0,0 +1,441 @@
+#include "WiFi.h"
+#include "WiFiUdp.h"
+#include "ESPmDNS.h"
+#include "host.h"
+#include "lwip/dns.h"
+#include "lwip/tcpip.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+MDNSResponder MDNS;
+
+// --- Station ---
+
+static bool apAvailable = true;
+static uint32_t connectDelayMs = 800;
+static bool associated = false;
+static bool connecting = false;
+static WiFiEventFuncCb eventCallback = nullptr;
+static char hostname[32] = "esp32";
+static uint8_t bssid[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+static void sendEvent(WiFiEvent_t event) {
+    if (eventCallback != nullptr) {
+        WiFiEventInfo_t info = {};
+        eventCallback(event, info);
+    }
+}
+
+static void onAssociated(void* arg) {
+    connecting = false;
+    if (!apAvailable) {
+        sendEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+        return;
+    }
+    associated = true;
+    sendEvent(ARDUINO_EVENT_WIFI_STA_CONNECTED);
+    sendEvent(ARDUINO_EVENT_WIFI_STA_GOT_IP);
+}
+
+void hostWifiSetAvailable(bool available) {
+    apAvailable = available;
+    if (!available && associated) {
+        associated = false;
+        sendEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+}
+
+void hostWifiSetConnectDelay(uint32_t ms) {
+    connectDelayMs = ms;
+}
+
+bool hostWifiConnected() {
+    return associated;
+}
+
+wl_status_t WiFiClass::status() {
+    return associated ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+wl_status_t WiFiClass::begin(const char* ssid, const char* password, int32_t channel,
+                             const uint8_t* bssid) {
+    hostCancel(onAssociated, nullptr);
+    associated = false;
+    connecting = true;
+    // A missing access point takes a whole scan to report
+    uint32_t delayMs = apAvailable ? connectDelayMs : 3000;
+    hostSchedule(hostNow() + (uint64_t)delayMs * 1000, onAssociated, nullptr);
+    return WL_DISCONNECTED;
+}
+
+bool WiFiClass::disconnect(bool wifiOff) {
+    hostCancel(onAssociated, nullptr);
+    bool was = associated || connecting;
+    associated = false;
+    connecting = false;
+    if (was) {
+        sendEvent(ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+    }
+    return true;
+}
+
+bool WiFiClass::mode(wifi_mode_t mode) {
+    return true;
+}
+
+bool WiFiClass::setHostname(const char* name) {
+    snprintf(hostname, sizeof(hostname), "%s", name);
+    return true;
+}
+
+const char* WiFiClass::getHostname() {
+    return hostname;
+}
+
+bool WiFiClass::setAutoReconnect(bool autoReconnect) {
+    return true;
+}
+
+int WiFiClass::onEvent(WiFiEventFuncCb callback) {
+    eventCallback = callback;
+    return 1;
+}
+
+IPAddress WiFiClass::localIP() {
+    return associated ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+int32_t WiFiClass::channel() {
+    return associated ? 6 : 0;
+}
+
+uint8_t* WiFiClass::BSSID() {
+    return bssid;
+}
+
+int8_t WiFiClass::RSSI() {
+    return associated ? -55 : 0;
+}
+
+int WiFiClass::hostByName(const char* host, IPAddress& result) {
+    if (!associated) {
+        return 0;
+    }
+    result = IPAddress(127, 0, 0, 1);
+    return 1;
+}
+
+// --- DNS ---
+// One lookup at a time, answered from the event queue as lwIP answers from
+// its TCP/IP task
+
+struct DnsLookup {
+    bool pending;
+    dns_found_callback found;
+    void* arg;
+    char name[64];
+};
+
+static DnsLookup lookup;
+static uint32_t dnsDelayMs = 20;
+static bool dnsAvailable = true;
+static uint32_t dnsLookups = 0;
+
+void hostDnsSetDelay(uint32_t ms) {
+    dnsDelayMs = ms;
+}
+
+void hostDnsSetAvailable(bool available) {
+    dnsAvailable = available;
+}
+
+uint32_t hostDnsLookups() {
+    return dnsLookups;
+}
+
+static void answerLookup(void* arg) {
+    lookup.pending = false;
+    if (!associated || !dnsAvailable) {
+        lookup.found(lookup.name, nullptr, lookup.arg);
+        return;
+    }
+    ip_addr_t address = {};
+    address.type = IPADDR_TYPE_V4;
+    address.u_addr.ip4.addr = htonl(INADDR_LOOPBACK);
+    lookup.found(lookup.name, &address, lookup.arg);
+}
+
+err_t dns_gethostbyname(const char* hostname, ip_addr_t* addr, dns_found_callback found, void* callback_arg) {
+    if (hostname == nullptr || found == nullptr) {
+        return ERR_ARG;
+    }
+    if (lookup.pending) {
+        return ERR_MEM;
+    }
+    lookup.pending = true;
+    lookup.found = found;
+    lookup.arg = callback_arg;
+    snprintf(lookup.name, sizeof(lookup.name), "%s", hostname);
+    dnsLookups++;
+    hostSchedule(hostNow() + (uint64_t)dnsDelayMs * 1000, answerLookup, nullptr);
+    return ERR_INPROGRESS;
+}
+
+err_t tcpip_callback(tcpip_callback_fn function, void* ctx) {
+    return hostSchedule(hostNow(), function, ctx) ? ERR_OK : ERR_MEM;
+}
+
+// --- UDP ---
+
+static uint32_t udpPackets = 0;
+static uint64_t udpBytes = 0;
+
+uint32_t hostUdpPackets() {
+    return udpPackets;
+}
+
+uint64_t hostUdpBytes() {
+    return udpBytes;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port) {
+    open = true;
+    length = 0;
+    return 1;
+}
+
+int WiFiUDP::beginPacket(const char* host, uint16_t port) {
+    return beginPacket(IPAddress(), port);
+}
+
+int WiFiUDP::endPacket() {
+    if (!open || !associated) {
+        open = false;
+        return 0;
+    }
+    open = false;
+    udpPackets++;
+    udpBytes += length;
+    return 1;
+}
+
+size_t WiFiUDP::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t WiFiUDP::write(const uint8_t* data, size_t size) {
+    if (!open) {
+        return 0;
+    }
+    length += size;
+    return size;
+}
+
+// --- TCP ---
+// A fixed table of sockets with reference counts, so copying a WiFiClient
+// (as the sketch does when it stores one in a connection slot) costs no
+// heap; the core does allocate a handle per accepted connection.
+
+#define HOST_SOCKETS 16
+
+struct SharedSocket {
+    int fd;
+    int refs;
+};
+
+static SharedSocket sockets[HOST_SOCKETS];
+static uint16_t httpPort = 0;
+
+uint16_t hostHttpPort() {
+    return httpPort;
+}
+
+static int adoptSocket(int fd) {
+    for (int i = 0; i < HOST_SOCKETS; i++) {
+        if (sockets[i].refs == 0) {
+            sockets[i].fd = fd;
+            sockets[i].refs = 1;
+            return i;
+        }
+    }
+    close(fd);
+    return -1;
+}
+
+WiFiClient::WiFiClient() : slot(-1) {}
+
+WiFiClient::WiFiClient(int fd) : slot(adoptSocket(fd)) {}
+
+WiFiClient::WiFiClient(const WiFiClient& other) : slot(other.slot) {
+    if (slot >= 0) {
+        sockets[slot].refs++;
+    }
+}
+
+WiFiClient& WiFiClient::operator=(const WiFiClient& other) {
+    if (other.slot >= 0) {
+        sockets[other.slot].refs++;
+    }
+    release();
+    slot = other.slot;
+    return *this;
+}
+
+WiFiClient::~WiFiClient() {
+    release();
+}
+
+void WiFiClient::release() {
+    if (slot < 0) {
+        return;
+    }
+    if (--sockets[slot].refs == 0 && sockets[slot].fd >= 0) {
+        close(sockets[slot].fd);
+        sockets[slot].fd = -1;
+    }
+    slot = -1;
+}
+
+static int socketOf(int slot) {
+    return slot >= 0 ? sockets[slot].fd : -1;
+}
+
+WiFiClient hostAdoptSocket(int fd) {
+    return WiFiClient(fd);
+}
+
+int WiFiClient::fd() const {
+    return socketOf(slot);
+}
+
+uint8_t WiFiClient::connected() {
+    int fd = socketOf(slot);
+    if (fd < 0) {
+        return 0;
+    }
+    uint8_t probe;
+    ssize_t result = recv(fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (result > 0) {
+        return 1;
+    }
+    if (result == 0) {
+        return 0; // Closed by the peer, nothing left to read
+    }
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 1 : 0;
+}
+
+int WiFiClient::available() {
+    int fd = socketOf(slot);
+    int count = 0;
+    if (fd < 0 || ioctl(fd, FIONREAD, &count) < 0) {
+        return 0;
+    }
+    return count;
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    int fd = socketOf(slot);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t result = recv(fd, buffer, size, MSG_DONTWAIT);
+    return result > 0 ? (int)result : -1;
+}
+
+int WiFiClient::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::peek() {
+    int fd = socketOf(slot);
+    uint8_t c;
+    return fd >= 0 && recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+size_t WiFiClient::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+// Like the core: retries a full send buffer a few times before returning
+// what went out
+size_t WiFiClient::write(const uint8_t* data, size_t size) {
+    int fd = socketOf(slot);
+    if (fd < 0) {
+        return 0;
+    }
+    size_t sent = 0;
+    int retries = 10;
+    while (sent < size && retries > 0) {
+        ssize_t result = send(fd, data + sent, size - sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (result > 0) {
+            sent += result;
+            continue;
+        }
+        if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            break;
+        }
+        struct pollfd writable = { fd, POLLOUT, 0 };
+        poll(&writable, 1, 100);
+        retries--;
+    }
+    return sent;
+}
+
+void WiFiClient::stop() {
+    int fd = socketOf(slot);
+    if (fd >= 0) {
+        close(fd);
+        sockets[slot].fd = -1;
+    }
+    release();
+}
+
+// --- Server ---
+
+void WiFiServer::begin() {
+    listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    int on = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0; // 'port' is the device's; the host takes any free one
+    if (bind(listener, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 8) < 0) {
+        perror("WiFiServer::begin");
+        close(listener);
+        listener = -1;
+        return;
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listener, (struct sockaddr*)&address, &length);
+    httpPort = ntohs(address.sin_port);
+}
+
+bool WiFiServer::hasClient() {
+    if (pending < 0 && listener >= 0) {
+        pending = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK);
+        if (pending >= 0) {
+            int on = 1;
+            setsockopt(pending, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+    }
+    return pending >= 0;
+}
+
+WiFiClient WiFiServer::accept() {
+    if (!hasClient()) {
+        return WiFiClient();
+    }
+    int fd = pending;
+    pending = -1;
+    return WiFiClient(fd);
+}
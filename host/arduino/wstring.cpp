@@ -0,0 +1,333 @@
+#include "Arduino.h"
+#include <ctype.h>
+
+// --- String ---
+
+String::String(const char* text) : heap(nullptr), capacity(SSO_SIZE - 1), len(0) {
+    sso[0] = '\0';
+    if (text != nullptr) {
+        assign(text, strlen(text));
+    }
+}
+
+String::String(const String& other) : String("") {
+    assign(other.c_str(), other.len);
+}
+
+String::String(String&& other) : String("") {
+    *this = static_cast<String&&>(other);
+}
+
+String::String(char c) : String("") {
+    assign(&c, 1);
+}
+
+String::String(int value, unsigned char base) : String((long)value, base) {}
+
+String::String(unsigned int value, unsigned char base) : String((unsigned long)value, base) {}
+
+String::String(long value, unsigned char base) : String("") {
+    char text[24];
+    snprintf(text, sizeof(text), base == 16 ? "%lx" : "%ld", value);
+    assign(text, strlen(text));
+}
+
+String::String(unsigned long value, unsigned char base) : String("") {
+    char text[24];
+    snprintf(text, sizeof(text), base == 16 ? "%lx" : "%lu", value);
+    assign(text, strlen(text));
+}
+
+String::~String() {
+    release();
+}
+
+void String::release() {
+    free(heap);
+    heap = nullptr;
+    capacity = SSO_SIZE - 1;
+}
+
+String& String::operator=(const String& other) {
+    if (this != &other) {
+        assign(other.c_str(), other.len);
+    }
+    return *this;
+}
+
+String& String::operator=(String&& other) {
+    if (this == &other) {
+        return *this;
+    }
+    if (other.heap != nullptr) {
+        release();
+        heap = other.heap;
+        capacity = other.capacity;
+        len = other.len;
+        other.heap = nullptr;
+        other.capacity = SSO_SIZE - 1;
+        other.len = 0;
+        other.sso[0] = '\0';
+    } else {
+        assign(other.sso, other.len);
+    }
+    return *this;
+}
+
+String& String::operator=(const char* text) {
+    assign(text != nullptr ? text : "", text != nullptr ? strlen(text) : 0);
+    return *this;
+}
+
+bool String::reserve(unsigned int size) {
+    if (size <= capacity) {
+        return true;
+    }
+    char* grown = (char*)realloc(heap, size + 1);
+    if (grown == nullptr) {
+        return false;
+    }
+    if (heap == nullptr) {
+        memcpy(grown, sso, len + 1);
+    }
+    heap = grown;
+    capacity = size;
+    return true;
+}
+
+void String::assign(const char* text, unsigned int length) {
+    if (!reserve(length)) {
+        return;
+    }
+    memmove(buffer(), text, length);
+    len = length;
+    buffer()[len] = '\0';
+}
+
+bool String::concat(const char* text, unsigned int length) {
+    if (!reserve(len + length)) {
+        return false;
+    }
+    memmove(buffer() + len, text, length);
+    len += length;
+    buffer()[len] = '\0';
+    return true;
+}
+
+bool String::concat(const char* text) {
+    return text == nullptr || concat(text, strlen(text));
+}
+
+bool String::equals(const char* text) const {
+    return strcmp(c_str(), text != nullptr ? text : "") == 0;
+}
+
+bool String::equalsIgnoreCase(const String& other) const {
+    return len == other.len && strcasecmp(c_str(), other.c_str()) == 0;
+}
+
+bool String::startsWith(const String& prefix) const {
+    return prefix.len <= len && strncmp(c_str(), prefix.c_str(), prefix.len) == 0;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    if (from >= len) {
+        return -1;
+    }
+    const char* found = strchr(c_str() + from, c);
+    return found != nullptr ? (int)(found - c_str()) : -1;
+}
+
+int String::indexOf(const char* text, unsigned int from) const {
+    if (from > len) {
+        return -1;
+    }
+    const char* found = strstr(c_str() + from, text);
+    return found != nullptr ? (int)(found - c_str()) : -1;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) {
+        unsigned int swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from > len) {
+        return String();
+    }
+    if (to > len) {
+        to = len;
+    }
+    String out;
+    out.assign(c_str() + from, to - from);
+    return out;
+}
+
+long String::toInt() const {
+    return strtol(c_str(), nullptr, 10);
+}
+
+void String::toUpperCase() {
+    for (unsigned int i = 0; i < len; i++) {
+        buffer()[i] = toupper((unsigned char)buffer()[i]);
+    }
+}
+
+void String::toLowerCase() {
+    for (unsigned int i = 0; i < len; i++) {
+        buffer()[i] = tolower((unsigned char)buffer()[i]);
+    }
+}
+
+void String::trim() {
+    const char* text = c_str();
+    unsigned int start = 0;
+    unsigned int end = len;
+    while (start < end && isspace((unsigned char)text[start])) {
+        start++;
+    }
+    while (end > start && isspace((unsigned char)text[end - 1])) {
+        end--;
+    }
+    assign(text + start, end - start);
+}
+
+String operator+(const String& a, const String& b) {
+    String out(a);
+    out.concat(b);
+    return out;
+}
+
+String operator+(const String& a, const char* b) {
+    String out(a);
+    out.concat(b);
+    return out;
+}
+
+// --- Print ---
+
+size_t Print::write(const uint8_t* data, size_t size) {
+    size_t written = 0;
+    while (size-- > 0) {
+        written += write(*data++);
+    }
+    return written;
+}
+
+size_t Print::write(const char* text) {
+    return text != nullptr ? write((const uint8_t*)text, strlen(text)) : 0;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char localBuffer[64];
+    char* text = localBuffer;
+    va_list args;
+    va_list copy;
+    va_start(args, format);
+    va_copy(copy, args);
+    int length = vsnprintf(text, sizeof(localBuffer), format, copy);
+    va_end(copy);
+    if (length < 0) {
+        va_end(args);
+        return 0;
+    }
+    if (length >= (int)sizeof(localBuffer)) {
+        text = (char*)malloc(length + 1);
+        if (text == nullptr) {
+            va_end(args);
+            return 0;
+        }
+        length = vsnprintf(text, length + 1, format, args);
+    }
+    va_end(args);
+    size_t written = write((const uint8_t*)text, length);
+    if (text != localBuffer) {
+        free(text);
+    }
+    return written;
+}
+
+size_t Print::printNumber(unsigned long value, int base, bool negative) {
+    char text[24];
+    char* end = text + sizeof(text);
+    char* start = end;
+    if (base < 2) {
+        base = 10;
+    }
+    do {
+        int digit = value % base;
+        *--start = digit < 10 ? '0' + digit : 'A' + digit - 10;
+        value /= base;
+    } while (value > 0);
+    if (negative) {
+        *--start = '-';
+    }
+    return write((const uint8_t*)start, end - start);
+}
+
+size_t Print::print(const __FlashStringHelper* text) {
+    return write(reinterpret_cast<const char*>(text));
+}
+
+size_t Print::print(const String& text) {
+    return write((const uint8_t*)text.c_str(), text.length());
+}
+
+size_t Print::print(const char* text) {
+    return write(text);
+}
+
+size_t Print::print(char c) {
+    return write((uint8_t)c);
+}
+
+size_t Print::print(int value, int base) {
+    return print((long)value, base);
+}
+
+size_t Print::print(unsigned int value, int base) {
+    return printNumber(value, base, false);
+}
+
+size_t Print::print(long value, int base) {
+    if (value < 0 && base == 10) {
+        return printNumber(-(unsigned long)value, base, true);
+    }
+    return printNumber((unsigned long)value, base, false);
+}
+
+size_t Print::print(unsigned long value, int base) {
+    return printNumber(value, base, false);
+}
+
+size_t Print::print(double value, int digits) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.*f", digits, value);
+    return write(text);
+}
+
+size_t Print::println() {
+    return write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper* text) { return print(text) + println(); }
+size_t Print::println(const String& text) { return print(text) + println(); }
+size_t Print::println(const char* text) { return print(text) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(int value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned int value, int base) { return print(value, base) + println(); }
+size_t Print::println(long value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned long value, int base) { return print(value, base) + println(); }
+size_t Print::println(double value, int digits) { return print(value, digits) + println(); }
+
+// --- IPAddress ---
+
+bool IPAddress::operator==(const IPAddress& other) const {
+    return memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+}
+
+String IPAddress::toString() const {
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+    return String(text);
+}
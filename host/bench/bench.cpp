@@ -0,0 +1,411 @@
+// --- Host Benchmarks ---
+// Times the sketch's hot paths on the host build and counts their heap
+// allocations, then compares both with a checked-in baseline. A benchmark
+// fails when its time per operation is more than --threshold percent above
+// the baseline, or when it allocates more than the baseline says.
+//
+//   charger_bench [--baseline FILE] [--threshold PCT] [--allocations-only]
+//                 [--update] [--filter TEXT]
+//
+// --update rewrites the baseline from this run. Times depend on the machine,
+// so refresh the baseline on the machine that checks it; allocation counts
+// do not. --allocations-only still prints the times but fails only on
+// allocations, which is what ctest runs.
+
+#include "declarations.h"
+#include "display.h"
+#include "status.h"
+#include "logging.h"
+#include "hass.h"
+#include "http_request.h"
+#include "http_server.h"
+#include "harness.h"
+#include "http_probe.h"
+#include <chrono>
+
+#define BENCH_REPEATS      5  // Best of, for the time; worst of, for allocations
+#define BENCH_TARGET_NS    20000000 // One repeat
+#define BENCH_MAX          16
+#define DEFAULT_THRESHOLD  25
+
+typedef void (*BenchFunction)(uint32_t iterations);
+
+struct Benchmark {
+    const char* name;
+    BenchFunction run;
+};
+
+struct BenchResult {
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+static uint64_t wallNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// --- Benchmarks ---
+
+static volatile size_t sink; // Keeps results the compiler could drop
+
+// One frame of the steady look: composeLook() into displayArray, then
+// drawMatrix() through the RGB frame to the strip
+static void benchCompose(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        setLookStep(i);
+        composeLook();
+        drawMatrix();
+    }
+}
+
+// A full rebuild of the /status document and its text, as after any change
+static void benchStatusJson(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        notifyStatusChanged();
+        size_t length;
+        getStatusJson(length);
+        sink = length;
+    }
+}
+
+static void benchLogMessage(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        _logMessage(LOG_INFO, "HTTP 404 Not Found: /favicon.ico");
+    }
+}
+
+// Recorded from a subscribe_entities subscription; %d is the subscription
+// id and %s the bound entity. The two state changes alternate, so every
+// one of them is a real change.
+
+static const char attributeEvent[] =
+    "{\"id\":%d,\"type\":\"event\",\"event\":{\"c\":{\"%s\":{\"+\":{\"a\":{\"power\":181.3},"
+    "\"c\":\"01JA6Z3Q4XW2M8R5T7YVKNB0CE\",\"lu\":1760659261.482}}}}}";
+
+static const char chargingEvent[] =
+    "{\"id\":%d,\"type\":\"event\",\"event\":{\"c\":{\"%s\":{\"+\":{\"s\":\"charging\","
+    "\"a\":{\"power\":180.5},\"c\":\"01JA6Z41C9D3F6H8K1M4P7R0TV\",\"lc\":1760659307.115}}}}}";
+
+static const char disconnectedEvent[] =
+    "{\"id\":%d,\"type\":\"event\",\"event\":{\"c\":{\"%s\":{\"+\":{\"s\":\"disconnected\","
+    "\"a\":{\"power\":0.0},\"c\":\"01JA6Z4B2E5G7J9L2N5Q8S1U3W\",\"lc\":1760659412.907}}}}}";
+
+// Every entity at once, as after (re)subscribing
+static const char addedEntity[] =
+    "\"%s\":{\"s\":\"charging\",\"a\":{\"friendly_name\":\"Charger\",\"icon\":\"mdi:ev-station\","
+    "\"device_class\":\"enum\",\"options\":[\"charging\",\"disconnected\",\"complete\"],"
+    "\"power\":180.5},\"c\":\"01JA6Y0P3R6T9V2X5Z8B1D4F7H\",\"lc\":1760655600.031}";
+
+#define PAYLOAD_SIZE 2048
+
+static char attributePayload[PAYLOAD_SIZE];
+static char changePayload[2][PAYLOAD_SIZE];
+static char fullPayload[PAYLOAD_SIZE];
+
+static void preparePayloads(int subscription) {
+    const char* entity = entityBindings[0].entityId;
+    snprintf(attributePayload, PAYLOAD_SIZE, attributeEvent, subscription, entity);
+    snprintf(changePayload[0], PAYLOAD_SIZE, chargingEvent, subscription, entity);
+    snprintf(changePayload[1], PAYLOAD_SIZE, disconnectedEvent, subscription, entity);
+
+    int length = snprintf(fullPayload, PAYLOAD_SIZE, "{\"id\":%d,\"type\":\"event\",\"event\":{\"a\":{", subscription);
+    for (int i = 0; i < entityCount; i++) {
+        if (i > 0) {
+            fullPayload[length++] = ',';
+        }
+        length += snprintf(fullPayload + length, PAYLOAD_SIZE - length, addedEntity, entityBindings[i].entityId);
+    }
+    snprintf(fullPayload + length, PAYLOAD_SIZE - length, "}}}");
+}
+
+static void deliver(const char* payload) {
+    onMessage(WebsocketsMessage(MessageType::Text, payload, strlen(payload)));
+}
+
+static void benchHassAttributes(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        deliver(attributePayload);
+    }
+}
+
+static void benchHassChange(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        deliver(changePayload[i % 2]);
+    }
+}
+
+static void benchHassAll(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        deliver(fullPayload);
+    }
+}
+
+// Parsing a request and finding its route, as dispatchRequest() does; the
+// patterns are those of routes[] in http_server.cpp, in the same order
+static const char* const routePatterns[] = {
+    "/", "/status", "/metrics", "/history", "/beep",
+    "/config/display_brightness/{int}", "/config/log_level/{str}",
+    "/config/update_state/{int}/{str}", "/boot",
+};
+
+static const char* const requests[] = {
+    "GET /status HTTP/1.1\r\nHost: charger.local\r\nIf-None-Match: \"3f2a91c7-1842\"\r\n"
+    "Accept-Encoding: gzip, deflate\r\nConnection: keep-alive\r\n\r\n",
+    "GET /config/update_state/2/charging HTTP/1.1\r\nHost: charger.local\r\nUser-Agent: curl/8.5.0\r\n"
+    "Accept: */*\r\n\r\n",
+    "GET /favicon.ico HTTP/1.1\r\nHost: charger.local\r\nAccept: image/avif,image/webp,*/*\r\n"
+    "Referer: http://charger.local/\r\n\r\n",
+};
+
+static void benchHttpRoute(uint32_t iterations) {
+    HttpRequestParser parser;
+    RouteParams params;
+    for (uint32_t i = 0; i < iterations; i++) {
+        const char* request = requests[i % 3];
+        parser.reset();
+        parser.feed(request, strlen(request));
+        size_t matched = 0;
+        for (const char* pattern : routePatterns) {
+            if (matchRoute(pattern, parser.path, params)) {
+                break;
+            }
+            matched++;
+        }
+        sink = matched;
+    }
+}
+
+// GET / through handleHttpRequests() on a loopback socket, from sending
+// the request to the connection closing after the last byte: what a page
+// load costs the network pass as sent plain, gzipped and revalidated. The
+// bytes on the wire are printed after the table.
+
+enum IndexVariant { INDEX_PLAIN, INDEX_GZIP, INDEX_REVALIDATE, INDEX_VARIANTS };
+
+static HttpProbe probe;
+static char indexHeaders[INDEX_VARIANTS][128];
+static size_t indexBytes[INDEX_VARIANTS];
+
+static void fetchIndex(const char* headers) {
+    probe.start("/", headers);
+    while (!probe.poll()) {
+        handleHttpRequests();
+    }
+}
+
+static void prepareIndex() {
+    snprintf(indexHeaders[INDEX_PLAIN], sizeof(indexHeaders[0]), "Accept-Encoding: identity\r\n");
+    snprintf(indexHeaders[INDEX_GZIP], sizeof(indexHeaders[0]), "Accept-Encoding: gzip, deflate\r\n");
+    // Revalidates the gzipped page with the ETag it came with
+    fetchIndex(indexHeaders[INDEX_GZIP]);
+    char etag[64] = "";
+    const char* line = strstr(probe.response(), "ETag: ");
+    if (line != nullptr) {
+        sscanf(line, "ETag: %63s", etag);
+    }
+    snprintf(indexHeaders[INDEX_REVALIDATE], sizeof(indexHeaders[0]),
+             "Accept-Encoding: gzip, deflate\r\nIf-None-Match: %s\r\n", etag);
+}
+
+static void serveIndex(IndexVariant variant, uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        fetchIndex(indexHeaders[variant]);
+    }
+    indexBytes[variant] = probe.length();
+}
+
+static void benchServePlain(uint32_t iterations) {
+    serveIndex(INDEX_PLAIN, iterations);
+}
+
+static void benchServeGzip(uint32_t iterations) {
+    serveIndex(INDEX_GZIP, iterations);
+}
+
+static void benchServe304(uint32_t iterations) {
+    serveIndex(INDEX_REVALIDATE, iterations);
+}
+
+static const Benchmark benchmarks[] = {
+    { "compose_draw",    benchCompose },
+    { "status_json",     benchStatusJson },
+    { "log_message",     benchLogMessage },
+    { "hass_attributes", benchHassAttributes },
+    { "hass_change",     benchHassChange },
+    { "hass_all_states", benchHassAll },
+    { "http_route",      benchHttpRoute },
+    { "serve_index",     benchServePlain },
+    { "serve_index_gz",  benchServeGzip },
+    { "serve_index_304", benchServe304 },
+};
+
+// --- Measuring ---
+
+static BenchResult measure(const Benchmark& benchmark) {
+    // Size the batch so one repeat takes about BENCH_TARGET_NS
+    uint32_t iterations = 1;
+    for (;;) {
+        uint64_t start = wallNs();
+        benchmark.run(iterations);
+        uint64_t elapsed = wallNs() - start;
+        if (elapsed >= BENCH_TARGET_NS / 10 || iterations >= (1U << 24)) {
+            iterations = (uint32_t)max((uint64_t)1, (uint64_t)iterations * BENCH_TARGET_NS / max(elapsed, (uint64_t)1));
+            break;
+        }
+        iterations *= 4;
+    }
+
+    BenchResult result = { 1e18, 0 };
+    for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        HostAllocStats before = hostAllocStats();
+        uint64_t start = wallNs();
+        benchmark.run(iterations);
+        uint64_t elapsed = wallNs() - start;
+        uint64_t allocations = hostAllocStats().allocations - before.allocations;
+        result.nsPerOp = min(result.nsPerOp, (double)elapsed / iterations);
+        result.allocsPerOp = max(result.allocsPerOp, (double)allocations / iterations);
+    }
+    return result;
+}
+
+// --- Baseline ---
+
+struct BaselineEntry {
+    char name[32];
+    BenchResult result;
+};
+
+static BaselineEntry baseline[BENCH_MAX];
+static int baselineCount = 0;
+
+static void loadBaseline(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        return;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), file) != nullptr && baselineCount < BENCH_MAX) {
+        BaselineEntry& entry = baseline[baselineCount];
+        if (line[0] == '#' || sscanf(line, "%31s %lf %lf", entry.name, &entry.result.nsPerOp, &entry.result.allocsPerOp) != 3) {
+            continue;
+        }
+        baselineCount++;
+    }
+    fclose(file);
+}
+
+static const BenchResult* findBaseline(const char* name) {
+    for (int i = 0; i < baselineCount; i++) {
+        if (strcmp(baseline[i].name, name) == 0) {
+            return &baseline[i].result;
+        }
+    }
+    return nullptr;
+}
+
+static bool saveBaseline(const char* path, const BenchResult* results, const bool* ran) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    fprintf(file, "# charger_bench baseline: name ns/op allocs/op (charger_bench --update)\n");
+    for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        const BenchResult* result = ran[i] ? &results[i] : findBaseline(benchmarks[i].name);
+        if (result != nullptr) {
+            fprintf(file, "%-16s %10.1f %8.3f\n", benchmarks[i].name, result->nsPerOp, result->allocsPerOp);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* baselinePath = "host/bench/baseline.txt";
+    const char* filter = nullptr;
+    double threshold = DEFAULT_THRESHOLD;
+    bool update = false;
+    bool allocationsOnly = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--allocations-only") == 0) {
+            allocationsOnly = true;
+        } else if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else {
+            fprintf(stderr, "usage: %s [--baseline FILE] [--threshold PCT] [--allocations-only] [--update] "
+                    "[--filter TEXT]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    FakeHass hass(1);
+    if (!bootSketch(hass, 5, 60000)) {
+        fprintf(stderr, "the sketch did not finish booting\n");
+        return 1;
+    }
+    // Only what a benchmark does should reach the log ring
+    logRuntimeLevel = LOG_INFO;
+    preparePayloads(hass.subscription());
+    prepareIndex();
+    loadBaseline(baselinePath);
+
+    const size_t count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+    BenchResult results[count];
+    bool ran[count] = {};
+    int regressions = 0;
+
+    printf("%-16s %10s %9s %10s %9s %8s\n", "benchmark", "ns/op", "allocs/op", "base ns", "base al", "change");
+    for (size_t i = 0; i < count; i++) {
+        const Benchmark& benchmark = benchmarks[i];
+        if (filter != nullptr && strstr(benchmark.name, filter) == nullptr) {
+            continue;
+        }
+        results[i] = measure(benchmark);
+        ran[i] = true;
+
+        const BenchResult* base = findBaseline(benchmark.name);
+        if (base == nullptr) {
+            printf("%-16s %10.1f %9.3f %10s %9s %8s\n", benchmark.name, results[i].nsPerOp,
+                   results[i].allocsPerOp, "-", "-", "new");
+            continue;
+        }
+        double change = (results[i].nsPerOp / base->nsPerOp - 1) * 100;
+        bool slower = !allocationsOnly && change > threshold;
+        bool allocates = results[i].allocsPerOp > base->allocsPerOp + 0.0005;
+        printf("%-16s %10.1f %9.3f %10.1f %9.3f %+7.1f%%%s%s\n", benchmark.name, results[i].nsPerOp,
+               results[i].allocsPerOp, base->nsPerOp, base->allocsPerOp, change,
+               slower ? "  SLOWER" : "", allocates ? "  ALLOCATES" : "");
+        if (!update && (slower || allocates)) {
+            regressions++;
+        }
+    }
+
+    if (indexBytes[INDEX_PLAIN] + indexBytes[INDEX_GZIP] + indexBytes[INDEX_REVALIDATE] > 0) {
+        printf("bytes on the wire for /: %u plain, %u gzipped, %u revalidated\n", (unsigned)indexBytes[INDEX_PLAIN],
+               (unsigned)indexBytes[INDEX_GZIP], (unsigned)indexBytes[INDEX_REVALIDATE]);
+    }
+
+    if (update) {
+        if (!saveBaseline(baselinePath, results, ran)) {
+            fprintf(stderr, "cannot write %s\n", baselinePath);
+            return 1;
+        }
+        printf("baseline written to %s\n", baselinePath);
+        return 0;
+    }
+    if (regressions > 0) {
+        if (allocationsOnly) {
+            printf("%d regression(s) in allocations\n", regressions);
+        } else {
+            printf("%d regression(s) past %.0f%% or in allocations\n", regressions, threshold);
+        }
+        return 1;
+    }
+    return 0;
+}
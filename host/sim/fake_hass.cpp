@@ -0,0 +1,171 @@
+#include "fake_hass.h"
+#include "declarations.h"
+#include <math.h>
+
+static const char* const chargerStates[] = { "charging", "disconnected" };
+static const char* const switchStates[] = { "off", "on" };
+
+static const char* stateText(int index, uint8_t state) {
+    return entityBindings[index].sound == SOUND_ON_OFF ? switchStates[state] : chargerStates[state];
+}
+
+FakeHass::FakeHass(uint32_t seed) : random(seed != 0 ? seed : 1), subscriptionId(-1), downUntilUs(0), wifiBackUs(0) {
+    memset(&counters, 0, sizeof(counters));
+    nextRestartUs = exponential(HA_RESTART_MEAN_S);
+    nextWifiDropUs = exponential(WIFI_DROP_MEAN_S);
+    nextAttributeUs = (uint64_t)HA_ATTRIBUTE_PERIOD_S * 1000000;
+    for (int i = 0; i < MAX_ENTITIES; i++) {
+        state[i] = next() % 2;
+        nextChangeUs[i] = exponential(HA_CHANGE_MEAN_S);
+    }
+}
+
+uint32_t FakeHass::next() {
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    return random;
+}
+
+uint64_t FakeHass::exponential(uint32_t meanS) {
+    double uniform = (next() + 1.0) / 4294967297.0;
+    return hostNow() + (uint64_t)(-log(uniform) * meanS * 1000000.0);
+}
+
+double FakeHass::epoch() const {
+    return 1767225600.0 + hostNow() / 1000000.0;
+}
+
+void FakeHass::deliver(const char* text, int length) {
+    if (length > 0 && hostHassDeliver(text, length)) {
+        counters.messagesOut++;
+    }
+}
+
+// --- Connection ---
+
+bool FakeHass::accept(const char* host, uint16_t port, const char* path) {
+    if (hostNow() < downUntilUs || strcmp(path, "/api/websocket") != 0) {
+        counters.refused++;
+        return false;
+    }
+    return true;
+}
+
+void FakeHass::onOpened() {
+    counters.connections++;
+    subscriptionId = -1;
+    static const char hello[] = "{\"type\":\"auth_required\",\"ha_version\":\"2026.10.1\"}";
+    deliver(hello, sizeof(hello) - 1);
+}
+
+void FakeHass::onClosed() {
+    subscriptionId = -1;
+}
+
+void FakeHass::onText(const char* data, size_t length) {
+    counters.messagesIn++;
+    char text[HOST_HASS_MESSAGE_SIZE];
+    if (length >= sizeof(text)) {
+        return;
+    }
+    memcpy(text, data, length);
+    text[length] = '\0';
+
+    if (strstr(text, "\"type\":\"auth\"") != nullptr) {
+        static const char ok[] = "{\"type\":\"auth_ok\",\"ha_version\":\"2026.10.1\"}";
+        deliver(ok, sizeof(ok) - 1);
+    } else if (strstr(text, "\"type\":\"subscribe_entities\"") != nullptr) {
+        const char* id = strstr(text, "\"id\":");
+        subscriptionId = id != nullptr ? atoi(id + 5) : 0;
+        char reply[96];
+        int replyLength = snprintf(reply, sizeof(reply),
+                                   "{\"id\":%d,\"type\":\"result\",\"success\":true,\"result\":null}", subscriptionId);
+        deliver(reply, replyLength);
+        sendAllStates();
+    }
+}
+
+// --- Events ---
+// Compressed states as subscribe_entities sends them: "a" with every
+// state, attributes and context once, then "c" with diffs under "+"
+
+void FakeHass::sendAllStates() {
+    char event[HOST_HASS_MESSAGE_SIZE];
+    int length = snprintf(event, sizeof(event), "{\"id\":%d,\"type\":\"event\",\"event\":{\"a\":{", subscriptionId);
+    for (int i = 0; i < entityCount; i++) {
+        length += snprintf(event + length, sizeof(event) - length,
+                           "%s\"%s\":{\"s\":\"%s\",\"a\":{\"friendly_name\":\"Charger %d\","
+                           "\"icon\":\"mdi:ev-station\",\"device_class\":\"enum\","
+                           "\"options\":[\"charging\",\"disconnected\",\"complete\"],\"power\":%.1f},"
+                           "\"c\":\"01J%08X%08XQZ\",\"lc\":%.3f}",
+                           i > 0 ? "," : "", entityBindings[i].entityId, stateText(i, state[i]), i + 1,
+                           state[i] == 0 ? 180.5 : 0.0, next(), next(), epoch());
+    }
+    length += snprintf(event + length, sizeof(event) - length, "}}}");
+    deliver(event, length);
+}
+
+void FakeHass::sendChange(int index) {
+    char event[512];
+    int length = snprintf(event, sizeof(event),
+                          "{\"id\":%d,\"type\":\"event\",\"event\":{\"c\":{\"%s\":{\"+\":{\"s\":\"%s\","
+                          "\"c\":\"01J%08X%08XQZ\",\"lc\":%.3f}}}}}",
+                          subscriptionId, entityBindings[index].entityId, stateText(index, state[index]),
+                          next(), next(), epoch());
+    deliver(event, length);
+}
+
+void FakeHass::sendAttributes(int index) {
+    char event[512];
+    int length = snprintf(event, sizeof(event),
+                          "{\"id\":%d,\"type\":\"event\",\"event\":{\"c\":{\"%s\":{\"+\":{"
+                          "\"a\":{\"power\":%.1f},\"c\":\"01J%08X%08XQZ\",\"lu\":%.3f}}}}}",
+                          subscriptionId, entityBindings[index].entityId,
+                          state[index] == 0 ? 170.0 + next() % 200 / 10.0 : 0.0, next(), next(), epoch());
+    deliver(event, length);
+}
+
+// --- Script ---
+
+void FakeHass::step() {
+    uint64_t now = hostNow();
+
+    if (now >= nextRestartUs) {
+        counters.restarts++;
+        hostHassDrop();
+        subscriptionId = -1;
+        downUntilUs = now + (uint64_t)HA_RESTART_DOWN_S * 1000000;
+        nextRestartUs = exponential(HA_RESTART_MEAN_S);
+    }
+
+    if (wifiBackUs == 0 && now >= nextWifiDropUs) {
+        counters.wifiDrops++;
+        hostWifiSetAvailable(false);
+        wifiBackUs = now + (uint64_t)WIFI_DROP_DOWN_S * 1000000;
+    } else if (wifiBackUs != 0 && now >= wifiBackUs) {
+        hostWifiSetAvailable(true);
+        wifiBackUs = 0;
+        nextWifiDropUs = exponential(WIFI_DROP_MEAN_S);
+    }
+
+    // Sensors keep changing while nobody listens; a new subscription gets
+    // the current values in its "a" event
+    for (int i = 0; i < entityCount; i++) {
+        if (now >= nextChangeUs[i]) {
+            state[i] ^= 1;
+            counters.changes++;
+            nextChangeUs[i] = exponential(HA_CHANGE_MEAN_S);
+            if (subscribed()) {
+                sendChange(i);
+            }
+        }
+    }
+
+    if (now >= nextAttributeUs) {
+        nextAttributeUs = now + (uint64_t)HA_ATTRIBUTE_PERIOD_S * 1000000;
+        if (subscribed()) {
+            sendAttributes(0);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef FAKE_HASS_H
+#define FAKE_HASS_H
+
+#include "host.h"
+#include <stdint.h>
+
+// --- Scripted Home Assistant ---
+// Answers the auth handshake and subscribe_entities like a real instance,
+// then plays a seeded script: the bound sensors change state every so often
+// (HA_CHANGE_MEAN_S), an attribute-only update arrives every
+// HA_ATTRIBUTE_PERIOD_S, HA restarts and WiFi drops out now and then. The
+// script uses its own PRNG, so it does not depend on what the sketch draws
+// from esp_random().
+
+#define HA_CHANGE_MEAN_S       1200  // Mean time between two changes of one sensor
+#define HA_ATTRIBUTE_PERIOD_S  60
+#define HA_RESTART_MEAN_S      10800 // Mean time between two HA restarts
+#define HA_RESTART_DOWN_S      45    // HA refuses connections this long after one
+#define WIFI_DROP_MEAN_S       14400
+#define WIFI_DROP_DOWN_S       60
+
+struct FakeHassStats {
+    uint32_t connections;
+    uint32_t refused;
+    uint32_t messagesIn;  // From the sketch
+    uint32_t messagesOut; // To the sketch
+    uint32_t changes;
+    uint32_t restarts;
+    uint32_t wifiDrops;
+};
+
+class FakeHass : public HostHassPeer {
+public:
+    explicit FakeHass(uint32_t seed);
+
+    // Plays the script up to the current virtual time
+    void step();
+
+    const FakeHassStats& stats() const { return counters; }
+    bool subscribed() const { return subscriptionId >= 0; }
+    int subscription() const { return subscriptionId; } // Message id of subscribe_entities
+
+    bool accept(const char* host, uint16_t port, const char* path) override;
+    void onOpened() override;
+    void onText(const char* data, size_t length) override;
+    void onClosed() override;
+
+private:
+    uint32_t random;
+    int subscriptionId;
+    uint64_t downUntilUs;
+    uint64_t wifiBackUs;
+    uint64_t nextRestartUs;
+    uint64_t nextWifiDropUs;
+    uint64_t nextAttributeUs;
+    uint64_t nextChangeUs[16];
+    uint8_t state[16]; // Index into the sensor's state list
+    FakeHassStats counters;
+
+    uint32_t next();
+    uint64_t exponential(uint32_t meanS);
+    void deliver(const char* text, int length);
+    void sendAllStates();
+    void sendChange(int index);
+    void sendAttributes(int index);
+    double epoch() const;
+};
+
+#endif // FAKE_HASS_H
@@ -0,0 +1,24 @@
+#include "harness.h"
+#include "boot.h"
+
+bool bootSketch(FakeHass& hass, uint32_t stepMs, uint32_t timeoutMs) {
+    hostHassSetPeer(&hass);
+    setup();
+    uint64_t deadline = hostNow() + (uint64_t)timeoutMs * 1000;
+    while (!bootStageDone(BOOT_STATE)) {
+        if (hostNow() >= deadline) {
+            return false;
+        }
+        runSketch(hass, stepMs, stepMs);
+    }
+    return true;
+}
+
+void runSketch(FakeHass& hass, uint32_t ms, uint32_t stepMs) {
+    uint64_t end = hostNow() + (uint64_t)ms * 1000;
+    while (hostNow() < end) {
+        loop();
+        hostAdvanceMs(stepMs);
+        hass.step();
+    }
+}
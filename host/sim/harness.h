@@ -0,0 +1,20 @@
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include "fake_hass.h"
+
+// --- Sketch Harness ---
+// What the simulation, the benchmarks and the host tests share: boot the
+// sketch against a FakeHass and keep it running on the virtual clock.
+
+void setup();
+void loop();
+
+// setup(), then loop() every stepMs until every boot stage is done;
+// false when that takes longer than timeoutMs
+bool bootSketch(FakeHass& hass, uint32_t stepMs, uint32_t timeoutMs);
+
+// loop() every stepMs for ms of virtual time, playing the HA script
+void runSketch(FakeHass& hass, uint32_t ms, uint32_t stepMs);
+
+#endif // HARNESS_H
@@ -0,0 +1,87 @@
+#include "http_probe.h"
+#include "host.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+HttpProbe::HttpProbe() : requests(0), failures(0), fd(-1), received(0) {
+    buffer[0] = '\0';
+}
+
+HttpProbe::~HttpProbe() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool HttpProbe::start(const char* path, const char* headers) {
+    if (fd >= 0 || hostHttpPort() == 0) {
+        return false;
+    }
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(hostHttpPort());
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        close(fd);
+        fd = -1;
+        failures++;
+        return false;
+    }
+
+    char request[512];
+    int length = snprintf(request, sizeof(request),
+                          "GET %s HTTP/1.1\r\nHost: charger.local\r\n%sConnection: close\r\n\r\n", path, headers);
+    send(fd, request, length, MSG_NOSIGNAL);
+    received = 0;
+    buffer[0] = '\0';
+    requests++;
+    return true;
+}
+
+bool HttpProbe::poll() {
+    if (fd < 0) {
+        return false;
+    }
+    for (;;) {
+        ssize_t result = recv(fd, buffer + received, sizeof(buffer) - 1 - received, MSG_DONTWAIT);
+        if (result > 0) {
+            received += result;
+            buffer[received] = '\0';
+            if (received == sizeof(buffer) - 1) {
+                finish();
+                return true;
+            }
+            continue;
+        }
+        if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;
+        }
+        finish();
+        return true;
+    }
+}
+
+void HttpProbe::finish() {
+    close(fd);
+    fd = -1;
+    if (status() != 200) {
+        failures++;
+    }
+}
+
+int HttpProbe::status() const {
+    int code = 0;
+    return sscanf(buffer, "HTTP/1.1 %d", &code) == 1 ? code : 0;
+}
+
+const char* HttpProbe::body() const {
+    const char* end = strstr(buffer, "\r\n\r\n");
+    return end != nullptr ? end + 4 : buffer + received;
+}
@@ -0,0 +1,41 @@
+#ifndef HTTP_PROBE_H
+#define HTTP_PROBE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// --- HTTP Probe ---
+// One request at a time to the sketch's WiFiServer over a real socket.
+// start() sends it; poll() collects the response between loop() passes
+// and returns true once the server closed the connection. The response
+// is kept in a fixed buffer, so probing does not show up in the
+// allocation counts.
+
+#define HTTP_PROBE_BUFFER 65536
+
+class HttpProbe {
+public:
+    HttpProbe();
+    ~HttpProbe();
+
+    bool start(const char* path, const char* headers = ""); // headers: "Name: value\r\n" lines
+    bool poll();
+    bool busy() const { return fd >= 0; }
+
+    int status() const;           // 0 when nothing parseable came back
+    const char* response() const { return buffer; } // Status line on, nul terminated
+    const char* body() const;     // After the blank line, nul terminated
+    size_t length() const { return received; }
+
+    uint32_t requests;
+    uint32_t failures; // Non-200 answers or dropped connections
+
+private:
+    int fd;
+    size_t received;
+    char buffer[HTTP_PROBE_BUFFER];
+
+    void finish();
+};
+
+#endif // HTTP_PROBE_H
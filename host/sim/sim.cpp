@@ -0,0 +1,225 @@
+// --- Host Simulation ---
+// Runs the sketch's setup() and loop() against the fake hardware for a
+// number of simulated hours: a scripted Home Assistant (fake_hass.h), a
+// WebSocket subscriber on port 81, and /status and /metrics fetched over a
+// real socket. Between two loop() passes the virtual clock advances by
+// --step-ms. Prints, per simulated hour, the wall time loop() took, the
+// frames shown and pushed, and the heap allocations made.
+//
+//   charger_sim [--hours H] [--step-ms MS] [--seed N] [--serial]
+
+#include "declarations.h"
+#include "boot.h"
+#include "http_server.h"
+#include "host.h"
+#include "harness.h"
+#include "http_probe.h"
+#include <chrono>
+
+#define PROBE_INTERVAL_S 10   // /status and /metrics, alternately
+#define PROBE_TIMEOUT_MS 2000
+
+// --- Latency Histogram ---
+// 100 ns buckets up to 1 ms, then 10 us buckets up to 101 ms
+
+#define FINE_BUCKETS   10000
+#define COARSE_BUCKETS 10000
+
+struct LatencyHistogram {
+    uint64_t buckets[FINE_BUCKETS + COARSE_BUCKETS + 1];
+    uint64_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    void add(uint64_t ns) {
+        size_t index;
+        if (ns < 100ULL * FINE_BUCKETS) {
+            index = ns / 100;
+        } else {
+            index = min((size_t)(FINE_BUCKETS + (ns - 100ULL * FINE_BUCKETS) / 10000), (size_t)(FINE_BUCKETS + COARSE_BUCKETS));
+        }
+        buckets[index]++;
+        count++;
+        totalNs += ns;
+        maxNs = max(maxNs, ns);
+    }
+
+    double percentileUs(double fraction) const {
+        uint64_t target = (uint64_t)(count * fraction);
+        uint64_t seen = 0;
+        for (size_t i = 0; i <= FINE_BUCKETS + COARSE_BUCKETS; i++) {
+            seen += buckets[i];
+            if (seen > target) {
+                return i < FINE_BUCKETS ? (i + 1) * 0.1 : 1000.0 + (i - FINE_BUCKETS + 1) * 10.0;
+            }
+        }
+        return maxNs / 1000.0;
+    }
+
+    double averageUs() const {
+        return count > 0 ? totalNs / 1000.0 / count : 0;
+    }
+};
+
+static LatencyHistogram hourly;
+static LatencyHistogram overall;
+static HttpProbe probe;
+
+struct Options {
+    double hours = 24;
+    uint32_t stepMs = 5;
+    uint32_t seed = 1;
+    bool serial = false;
+};
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--hours") == 0 && i + 1 < argc) {
+            options.hours = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--step-ms") == 0 && i + 1 < argc) {
+            options.stepMs = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--serial") == 0) {
+            options.serial = true;
+        } else {
+            fprintf(stderr, "usage: %s [--hours H] [--step-ms MS] [--seed N] [--serial]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint64_t wallNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void printBootTime(const char* label, BootStage stage) {
+    const BootTiming& timing = getBootTiming(stage);
+    if (timing.done) {
+        printf("  %-16s %8lu ms\n", label, timing.doneMs);
+    } else {
+        printf("  %-16s %8s\n", label, "never");
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+    setvbuf(stdout, nullptr, _IOLBF, 0);
+
+    hostSeed(options.seed);
+    hostEchoSerial(options.serial);
+    FakeHass hass(options.seed * 2654435761U);
+    hostHassSetPeer(&hass);
+
+    uint64_t wallStart = wallNs();
+    setup();
+
+    int subscriber = hostWsConnect();
+    hostWsSend(subscriber, "subscribe");
+
+    uint64_t endUs = (uint64_t)(options.hours * 3600e6);
+    uint64_t nextHourUs = 3600000000ULL;
+    uint64_t nextProbeUs = (uint64_t)PROBE_INTERVAL_S * 1000000;
+    uint64_t probeStartedUs = 0;
+    bool probeStatus = true;
+    int hour = 0;
+
+    HostAllocStats allocStart = hostAllocStats();
+    uint64_t allocations = 0;       // Made by loop() and the timers, this hour
+    uint64_t steadyAllocations = 0; // Same, once every boot stage was done
+    uint64_t totalAllocations = 0;
+    uint32_t hourShows = strip.shows();
+    uint32_t hourPushed = getFramesPushed();
+    uint32_t hourProbes = 0;
+    hourly.clear();
+    overall.clear();
+
+    printf("charger_sim: %.2f simulated hours, %u ms per step, seed %u\n",
+           options.hours, options.stepMs, options.seed);
+    printf("%5s %10s %8s %8s %8s %9s %7s %7s %8s %6s %6s\n", "hour", "passes", "avg_us", "p50_us",
+           "p99_us", "max_us", "shown", "pushed", "allocs", "ha_con", "probes");
+
+    while (hostNow() < endUs) {
+        HostAllocStats before = hostAllocStats();
+        uint64_t start = wallNs();
+        loop();
+        uint64_t elapsed = wallNs() - start;
+        hostAdvanceMs(options.stepMs);
+        uint64_t made = hostAllocStats().allocations - before.allocations;
+
+        hourly.add(elapsed);
+        overall.add(elapsed);
+        allocations += made;
+        totalAllocations += made;
+        if (bootStageDone(BOOT_STATE)) {
+            steadyAllocations += made;
+        }
+
+        hass.step();
+
+        if (probe.busy()) {
+            if (probe.poll()) {
+                // Done
+            } else if (hostNow() - probeStartedUs > (uint64_t)PROBE_TIMEOUT_MS * 1000) {
+                fprintf(stderr, "HTTP probe timed out at %llu ms\n", (unsigned long long)(hostNow() / 1000));
+                probe.failures++;
+                probe.~HttpProbe();
+                new (&probe) HttpProbe();
+            }
+        } else if (hostNow() >= nextProbeUs && bootStageDone(BOOT_HTTP)) {
+            probe.start(probeStatus ? "/status" : "/metrics");
+            probeStatus = !probeStatus;
+            probeStartedUs = hostNow();
+            nextProbeUs += (uint64_t)PROBE_INTERVAL_S * 1000000;
+        }
+
+        if (hostNow() >= nextHourUs || hostNow() >= endUs) {
+            hour++;
+            printf("%5d %10llu %8.2f %8.1f %8.1f %9.1f %7u %7u %8llu %6u %6u\n", hour,
+                   (unsigned long long)hourly.count, hourly.averageUs(), hourly.percentileUs(0.5),
+                   hourly.percentileUs(0.99), hourly.maxNs / 1000.0, strip.shows() - hourShows,
+                   getFramesPushed() - hourPushed, (unsigned long long)allocations,
+                   hass.stats().connections, probe.requests - hourProbes);
+            hourly.clear();
+            allocations = 0;
+            hourShows = strip.shows();
+            hourPushed = getFramesPushed();
+            hourProbes = probe.requests;
+            nextHourUs += 3600000000ULL;
+        }
+    }
+
+    double wallMinutes = (wallNs() - wallStart) / 60e9;
+    const FakeHassStats& ha = hass.stats();
+    printf("\nloop(): %llu passes, avg %.2f us, p50 %.1f us, p99 %.1f us, max %.1f us (wall time)\n",
+           (unsigned long long)overall.count, overall.averageUs(), overall.percentileUs(0.5),
+           overall.percentileUs(0.99), overall.maxNs / 1000.0);
+    printf("frames: %u shown, %u pushed to the subscriber (%u binary messages, %llu bytes on port 81)\n",
+           strip.shows(), getFramesPushed(), hostWsClient(subscriber).binaries,
+           (unsigned long long)hostWsClient(subscriber).bytes);
+    printf("heap: %llu allocations in loop(), %llu after boot; %llu since start, %zu bytes live\n",
+           (unsigned long long)totalAllocations, (unsigned long long)steadyAllocations,
+           (unsigned long long)(hostAllocStats().allocations - allocStart.allocations),
+           hostAllocStats().liveBytes);
+    printf("home assistant: %u connections, %u refused, %u restarts, %u state changes, %u messages in, %u out\n",
+           ha.connections, ha.refused, ha.restarts, ha.changes, ha.messagesIn, ha.messagesOut);
+    printf("wifi: %u drops; http: %u requests, %u failed; udp log: %u datagrams\n",
+           ha.wifiDrops, probe.requests, probe.failures, hostUdpPackets());
+    printf("boot:\n");
+    printBootTime("first frame", BOOT_DISPLAY);
+    printBootTime("network", BOOT_WIFI);
+    printBootTime("valid state", BOOT_STATE);
+    printf("speed: %.1f simulated hours per wall minute\n", wallMinutes > 0 ? options.hours / wallMinutes : 0.0);
+
+    bool ok = bootStageDone(BOOT_STATE) && probe.failures == 0;
+    return ok ? 0 : 1;
+}
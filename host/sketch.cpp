@@ -0,0 +1,7 @@
+// The sketch as one translation unit, the way the Arduino builder sees it:
+// the prototypes it generates for main.ino, then main.ino itself
+
+void networkPass();
+void networkTask(void* parameter);
+
+#include "main.ino"
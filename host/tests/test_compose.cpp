@@ -0,0 +1,265 @@
+// composeLook() draws every look exactly as the draw functions it replaced
+// did: each link state, every pair of bike states, every charging row.
+// Keyframes go out as palette frames and move the status version, blends
+// only as RLE frames. Also times both ways of drawing the connected look.
+
+#include "declarations.h"
+#include "display.h"
+#include "render.h"
+#include "animation.h"
+#include "status.h"
+#include "frame_codec.h"
+#include "perf.h"
+#include "harness.h"
+#include "check.h"
+#include <chrono>
+
+// --- Draw Functions Before The Sprites ---
+// As display.cpp had them, drawing into their own array
+
+namespace before {
+
+static uint8_t look[MATRIX_HEIGHT][MATRIX_WIDTH];
+
+static void updateItem(int row, int col, Color color) {
+    if (row >= 0 && row < MATRIX_HEIGHT && col >= 0 && col < MATRIX_WIDTH) {
+        look[row][col] = color;
+    }
+}
+
+static void drawBorder() {
+    updateItem(0, 1, CYAN);
+    updateItem(0, 2, CYAN);
+    updateItem(7, 1, CYAN);
+    updateItem(7, 2, CYAN);
+    updateItem(0, 5, MAGENTA);
+    updateItem(0, 6, MAGENTA);
+    updateItem(7, 5, MAGENTA);
+    updateItem(7, 6, MAGENTA);
+
+    for (int i = 0; i < 8; i++) {
+        updateItem(i, 0, CYAN);
+        updateItem(i, 3, CYAN);
+        updateItem(i, 4, MAGENTA);
+        updateItem(i, 7, MAGENTA);
+    }
+}
+
+static void state_unknown(int bike, int row) {
+    int colStart = (bike == 1) ? 0 : 4;
+    int rowStart = (row % 2 == 0) ? 2 : 3;
+    updateItem(rowStart, colStart + 1, RED);
+    updateItem(rowStart, colStart + 2, RED);
+
+    updateItem(rowStart + 2, colStart + 1, RED);
+    updateItem(rowStart + 2, colStart + 2, RED);
+}
+
+static void state_charging(int bike, int row) {
+    int colStart = (bike == 1) ? 0 : 4;
+    updateItem(row, colStart + 1, BLUE);
+    updateItem(row, colStart + 2, BLUE);
+}
+
+static void state_disconnected(int bike, int row) {
+    int colStart = (bike == 1) ? 0 : 4;
+    for (int i = 1; i < 7; i++) {
+        int col = ((i + row) % 2 == 0) ? 1 : 2;
+        updateItem(i, colStart + col, YELLOW);
+    }
+}
+
+static void noWifi(int row) {
+    Color pixelColor = (row % 2 == 0) ? BLUE : RED;
+    updateItem(0, 0, pixelColor);
+
+    for (int r = 1; r < 8; r += 2) {
+        for (int c = r; c < 8; c++) {
+            updateItem(c, (7 - r), RED);
+        }
+    }
+}
+
+static void noHass(int row) {
+    Color pixelColor = (row % 2 == 0) ? GREEN : YELLOW;
+    updateItem(0, 0, pixelColor);
+
+    for (int r = 1; r < 8; r += 2) {
+        for (int c = r; c < 8; c++) {
+            updateItem(c, (7 - r), BLUE);
+        }
+    }
+}
+
+static void composeLook(bool wifi, bool hass, const EntityState* states, int row) {
+    memset(look, BLACK, sizeof(look));
+    if (wifi && hass) {
+        drawBorder();
+        for (int i = 0; i < entityCount; i++) {
+            int8_t slot = entityBindings[i].slot;
+            if (slot < 0) {
+                continue;
+            }
+            switch (states[i]) {
+                case STATE_CHARGING:
+                    state_charging(slot + 1, row);
+                    break;
+                case STATE_DISCONNECTED:
+                    state_disconnected(slot + 1, row);
+                    break;
+                case STATE_UNKNOWN:
+                    state_unknown(slot + 1, row);
+                    break;
+                default:
+                    break;
+            }
+        }
+    } else if (wifi) {
+        noHass(row);
+    } else {
+        noWifi(row);
+    }
+}
+
+} // namespace before
+
+// Hands the link flags and states to the render side, as the network pass does
+static void publish(bool wifi, bool hass, const EntityState* states) {
+    wifi_connected = wifi;
+    ws_connected = hass;
+    statesStale = false;
+    memcpy(entityStates, states, sizeof(EntityState) * MAX_ENTITIES);
+    publishDisplayState();
+    renderPass();
+}
+
+static int firstSlotted(int skip) {
+    for (int i = 0; i < entityCount; i++) {
+        if (entityBindings[i].slot >= 0 && i != skip) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void testSameLooks() {
+    int first = firstSlotted(-1);
+    int second = firstSlotted(first);
+    CHECK(first >= 0 && second >= 0);
+
+    int compared = 0;
+    for (int link = 0; link < 3; link++) {
+        bool wifi = link > 0;
+        bool hass = link > 1;
+        for (int a = 0; a < STATE_COUNT; a++) {
+            for (int b = 0; b < STATE_COUNT; b++) {
+                EntityState states[MAX_ENTITIES] = {};
+                states[first] = (EntityState)a;
+                states[second] = (EntityState)b;
+                publish(wifi, hass, states);
+                for (uint32_t step = 0; step < 6; step++) {
+                    setLookStep(step);
+                    composeLook();
+                    before::composeLook(wifi, hass, states, chargingRow);
+                    if (memcmp(displayArray, before::look, sizeof(displayArray)) != 0) {
+                        fprintf(stderr, "look differs: wifi %d hass %d states %d/%d row %d\n",
+                                wifi, hass, a, b, chargingRow);
+                        checkFailures++;
+                    }
+                    compared++;
+                }
+            }
+        }
+    }
+    CHECK_EQ(compared, 3 * STATE_COUNT * STATE_COUNT * 6);
+}
+
+static void testKeyframes() {
+    EntityState states[MAX_ENTITIES] = {};
+    states[firstSlotted(-1)] = STATE_CHARGING;
+    publish(true, true, states);
+
+    uint8_t out[FRAME_RLE_RGB_MAX_SIZE(MATRIX_WIDTH, MATRIX_HEIGHT)];
+    unsigned long start = 100 * interval;
+    renderAnimationFrame(start - ANIMATION_FRAME_US / 1000);
+    uint32_t version = getStatusVersion();
+    int versions = 0;
+    int palette = 0;
+    int shown = 0;
+    for (unsigned long now = start; now < start + 4 * interval; now += ANIMATION_FRAME_US / 1000) {
+        unsigned long before = framesShown;
+        renderAnimationFrame(now);
+        if (framesShown == before) {
+            continue;
+        }
+        shown++;
+        ShownFrame frame;
+        readShownFrame(frame);
+        size_t length = encodeDisplayFrame(out, sizeof(out), shown);
+        CHECK(length > 0);
+        CHECK_EQ(out[0], frame.keyframe ? FRAME_FORMAT_PALETTE4 : FRAME_FORMAT_RLE_RGB);
+        palette += frame.keyframe;
+        if (getStatusVersion() != version) {
+            versions++;
+            version = getStatusVersion();
+            CHECK(frame.keyframe);
+        }
+
+        // What the client decodes is what was shown
+        DecodedFrame decoded;
+        CHECK(decodeFrame(out, length, decoded));
+        for (int i = 0; i < MATRIX_HEIGHT * MATRIX_WIDTH; i++) {
+            int row = i / MATRIX_WIDTH;
+            int col = i % MATRIX_WIDTH;
+            if (frame.keyframe) {
+                CHECK_EQ(decoded.index[i], frame.look.cells[row][col]);
+            } else {
+                CHECK_EQ(decoded.rgb[i], frame.rgb[row][col]);
+            }
+        }
+    }
+    // One keyframe and one version per step, the blends in between only move frames
+    CHECK_EQ(palette, 4);
+    CHECK_EQ(versions, 4);
+    CHECK(shown > 4 * 8);
+}
+
+static double timeLooks(bool sprites, int count) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        setLookStep(i);
+        if (sprites) {
+            composeLook();
+        } else {
+            // composeLook() times itself, so this pays for the same scope
+            PerfScope perf(PERF_COMPOSE);
+            before::composeLook(true, true, entityStates, chargingRow);
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / count;
+}
+
+static void benchmarkLooks() {
+    EntityState states[MAX_ENTITIES] = {};
+    states[firstSlotted(-1)] = STATE_CHARGING;
+    states[firstSlotted(firstSlotted(-1))] = STATE_DISCONNECTED;
+    publish(true, true, states);
+
+    const int count = 200000;
+    double drawn = 1e9;
+    double painted = 1e9;
+    for (int repeat = 0; repeat < 3; repeat++) {
+        drawn = min(drawn, timeLooks(false, count));
+        painted = min(painted, timeLooks(true, count));
+    }
+    printf("connected look: draw functions %.1f ns, sprites %.1f ns\n", drawn, painted);
+}
+
+int main() {
+    setup();
+    testSameLooks();
+    testKeyframes();
+    benchmarkLooks();
+    return checkResult("test_compose");
+}
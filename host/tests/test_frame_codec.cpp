@@ -0,0 +1,198 @@
+// Binary frames: both formats decode to what was encoded, malformed input
+// is refused, and a frame is much smaller than the displayArray JSON the
+// status document used to carry for the same picture.
+
+#include "frame_codec.h"
+#include "check.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define W 8
+#define H 8
+
+static const uint32_t palette[] = {
+    0x000000, 0xFFFFFF, 0xFF0000, 0x00FF00, 0x0000FF, 0xFFFF00, 0x00FFFF, 0xFF00FF,
+};
+
+static uint32_t seed = 12345;
+
+static uint32_t nextRandom() {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+// The steady look: a border around mostly black, two charger icons
+static void lookCells(uint8_t* cells) {
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            bool edge = x == 0 || y == 0 || x == W - 1 || y == H - 1;
+            cells[y * W + x] = edge ? 4 : 0;
+        }
+    }
+    for (int y = 2; y < 6; y++) {
+        cells[y * W + 2] = 3;
+        cells[y * W + 5] = 2;
+    }
+}
+
+// displayArray as ArduinoJson wrote it: rows of decimal colors
+static size_t jsonSize(const uint32_t* rgb, int width, int height) {
+    char text[4096];
+    size_t length = snprintf(text, sizeof(text), "\"displayArray\":[");
+    for (int y = 0; y < height; y++) {
+        length += snprintf(text + length, sizeof(text) - length, "%s[", y > 0 ? "," : "");
+        for (int x = 0; x < width; x++) {
+            length += snprintf(text + length, sizeof(text) - length, "%s%lu", x > 0 ? "," : "",
+                               (unsigned long)rgb[y * width + x]);
+        }
+        length += snprintf(text + length, sizeof(text) - length, "]");
+    }
+    length += snprintf(text + length, sizeof(text) - length, "]");
+    return length;
+}
+
+static void testPaletteRoundTrip() {
+    uint8_t cells[W * H];
+    uint8_t out[FRAME_PALETTE4_SIZE(W, H)];
+    DecodedFrame frame;
+
+    for (int round = 0; round < 100; round++) {
+        for (int i = 0; i < W * H; i++) {
+            cells[i] = nextRandom() % 16;
+        }
+        uint32_t number = nextRandom();
+        size_t length = encodeFramePalette4(cells, W, H, round % W, FRAME_NO_HIGHLIGHT, number, out, sizeof(out));
+        CHECK_EQ(length, 41);
+        CHECK(decodeFrame(out, length, frame));
+        CHECK_EQ(frame.format, FRAME_FORMAT_PALETTE4);
+        CHECK_EQ(frame.frameNumber, number);
+        CHECK_EQ(frame.width, W);
+        CHECK_EQ(frame.height, H);
+        CHECK_EQ(frame.highlightX, round % W);
+        CHECK_EQ(frame.highlightY, FRAME_NO_HIGHLIGHT);
+        CHECK(memcmp(frame.index, cells, W * H) == 0);
+    }
+
+    // Odd pixel counts leave the last low nibble empty
+    uint8_t odd[15];
+    for (int i = 0; i < 15; i++) {
+        odd[i] = i;
+    }
+    size_t length = encodeFramePalette4(odd, 5, 3, FRAME_NO_HIGHLIGHT, FRAME_NO_HIGHLIGHT, 7, out, sizeof(out));
+    CHECK_EQ(length, FRAME_PALETTE4_SIZE(5, 3));
+    CHECK(decodeFrame(out, length, frame));
+    CHECK(memcmp(frame.index, odd, 15) == 0);
+}
+
+static void testRleRoundTrip() {
+    uint32_t rgb[FRAME_MAX_PIXELS];
+    uint8_t out[FRAME_RLE_RGB_MAX_SIZE(16, 16)];
+    DecodedFrame frame;
+
+    for (int round = 0; round < 200; round++) {
+        int width = 1 + nextRandom() % 16;
+        int height = 1 + nextRandom() % 16;
+        // Runs of random length, so both short and long ones occur
+        int colors = 1 + round % 8;
+        for (int i = 0; i < width * height;) {
+            uint32_t color = (nextRandom() % colors) * 0x1F3D5B;
+            for (int run = 1 + nextRandom() % 20; run > 0 && i < width * height; run--) {
+                rgb[i++] = color & 0xFFFFFF;
+            }
+        }
+        uint32_t number = nextRandom();
+        size_t length = encodeFrameRleRgb(rgb, width, height, number, out, sizeof(out));
+        CHECK(length >= FRAME_HEADER_SIZE + 4);
+        CHECK(length <= (size_t)FRAME_RLE_RGB_MAX_SIZE(width, height));
+        CHECK(decodeFrame(out, length, frame));
+        CHECK_EQ(frame.format, FRAME_FORMAT_RLE_RGB);
+        CHECK_EQ(frame.frameNumber, number);
+        CHECK_EQ(frame.width, width);
+        CHECK_EQ(frame.height, height);
+        CHECK(memcmp(frame.rgb, rgb, width * height * sizeof(uint32_t)) == 0);
+    }
+
+    // Runs longer than 255 pixels are split
+    for (int i = 0; i < 256; i++) {
+        rgb[i] = 0x123456;
+    }
+    size_t length = encodeFrameRleRgb(rgb, 16, 16, 1, out, sizeof(out));
+    CHECK_EQ(length, FRAME_HEADER_SIZE + 8);
+    CHECK(decodeFrame(out, length, frame));
+    CHECK_EQ(frame.rgb[255], 0x123456);
+}
+
+static void testMalformed() {
+    uint8_t cells[W * H] = {};
+    uint8_t out[FRAME_RLE_RGB_MAX_SIZE(W, H)];
+    DecodedFrame frame;
+
+    size_t length = encodeFramePalette4(cells, W, H, 0, 0, 1, out, sizeof(out));
+    for (size_t cut = 0; cut < length; cut++) {
+        CHECK(!decodeFrame(out, cut, frame));
+    }
+    cells[3] = 16;
+    CHECK_EQ(encodeFramePalette4(cells, W, H, 0, 0, 1, out, sizeof(out)), 0);
+    CHECK_EQ(encodeFramePalette4(cells, W, H, 0, 0, 1, out, FRAME_PALETTE4_SIZE(W, H) - 1), 0);
+
+    uint32_t rgb[W * H];
+    for (int i = 0; i < W * H; i++) {
+        rgb[i] = i;
+    }
+    length = encodeFrameRleRgb(rgb, W, H, 1, out, sizeof(out));
+    CHECK_EQ(length, FRAME_RLE_RGB_MAX_SIZE(W, H));
+    for (size_t cut = 0; cut < length; cut++) {
+        CHECK(!decodeFrame(out, cut, frame));
+    }
+    CHECK_EQ(encodeFrameRleRgb(rgb, W, H, 1, out, length - 1), 0);
+
+    // A zero-length run, a run past the end, an unknown format, too many pixels
+    out[FRAME_HEADER_SIZE] = 0;
+    CHECK(!decodeFrame(out, length, frame));
+    out[FRAME_HEADER_SIZE] = 65;
+    CHECK(!decodeFrame(out, length, frame));
+    out[0] = 3;
+    CHECK(!decodeFrame(out, length, frame));
+    out[0] = FRAME_FORMAT_RLE_RGB;
+    out[5] = 255;
+    out[6] = 255;
+    CHECK(!decodeFrame(out, length, frame));
+}
+
+static void testSizeAgainstJson() {
+    uint8_t cells[W * H];
+    uint32_t rgb[W * H];
+    lookCells(cells);
+    for (int i = 0; i < W * H; i++) {
+        rgb[i] = palette[cells[i]];
+    }
+
+    uint8_t out[FRAME_RLE_RGB_MAX_SIZE(W, H)];
+    size_t json = jsonSize(rgb, W, H);
+    size_t palette4 = encodeFramePalette4(cells, W, H, 3, 0, 1, out, sizeof(out));
+    size_t rle = encodeFrameRleRgb(rgb, W, H, 1, out, sizeof(out));
+
+    // Every pixel a different color is the worst case for RLE
+    uint32_t noisy[W * H];
+    for (int i = 0; i < W * H; i++) {
+        noisy[i] = nextRandom() & 0xFFFFFF;
+    }
+    size_t noisyJson = jsonSize(noisy, W, H);
+    size_t noisyRle = encodeFrameRleRgb(noisy, W, H, 1, out, sizeof(out));
+
+    printf("8x8 look: JSON %zu bytes, palette %zu, RLE %zu; noise: JSON %zu, RLE %zu\n",
+           json, palette4, rle, noisyJson, noisyRle);
+    CHECK(palette4 * 5 < json);
+    CHECK(rle * 2 < json);
+    CHECK(noisyRle < noisyJson);
+}
+
+int main() {
+    testPaletteRoundTrip();
+    testRleRoundTrip();
+    testMalformed();
+    testSizeAgainstJson();
+    return checkResult("test_frame_codec");
+}
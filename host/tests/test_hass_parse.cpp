@@ -0,0 +1,205 @@
+// Parsing Home Assistant messages over recorded subscribe_entities
+// payloads: onMessage() applies the states they carry, and the filtered
+// parse into the static arena needs a fraction of the memory the full
+// document took on the heap. Prints the parse time and peak memory of
+// both ways for each payload.
+
+#include "declarations.h"
+#include "hass.h"
+#include "logging.h"
+#include "pools.h"
+#include "harness.h"
+#include "check.h"
+#include <chrono>
+
+// %d is the subscription id, %s a bound entity. Attributes as a charger
+// integration reports them; they are what the filter leaves out.
+static const char chargerAttributes[] =
+    "\"a\":{\"friendly_name\":\"Garage Charger\",\"icon\":\"mdi:ev-station\",\"device_class\":\"enum\","
+    "\"options\":[\"charging\",\"disconnected\",\"complete\",\"error\",\"waiting_for_car\",\"ready\"],"
+    "\"power\":7.36,\"energy_session\":12.84,\"energy_total\":4821.5,\"current_l1\":16.1,"
+    "\"current_l2\":15.9,\"current_l3\":16.0,\"voltage_l1\":231.2,\"voltage_l2\":229.8,"
+    "\"voltage_l3\":230.5,\"max_current\":16,\"phases\":3,\"cable_locked\":true,"
+    "\"rfid_tag\":\"04A2B9C2D11280\",\"firmware\":\"5.2.11\",\"serial\":\"WB-2023-001842\","
+    "\"session_start\":\"2026-10-16T18:02:11+00:00\",\"schedule\":{\"enabled\":true,"
+    "\"start\":\"01:00\",\"end\":\"06:00\",\"days\":[\"mon\",\"tue\",\"wed\",\"thu\",\"fri\"]},"
+    "\"attribution\":\"Data provided by the wallbox cloud\"}";
+
+static const char stateChange[] =
+    "{\"id\":%d,\"type\":\"event\",\"event\":{\"c\":{\"%s\":{\"+\":{\"s\":\"%s\","
+    "\"a\":{\"power\":7.36,\"energy_session\":0.02},\"c\":\"01JA6Z41C9D3F6H8K1M4P7R0TV\","
+    "\"lc\":1760659307.115}}}}}";
+
+static const char attributeChange[] =
+    "{\"id\":%d,\"type\":\"event\",\"event\":{\"c\":{\"%s\":{\"+\":{\"a\":{\"power\":7.41,"
+    "\"energy_session\":12.91,\"current_l1\":16.2},\"c\":\"01JA6Z3Q4XW2M8R5T7YVKNB0CE\","
+    "\"lu\":1760659261.482}}}}}";
+
+static const char resultMessage[] =
+    "{\"id\":%d,\"type\":\"result\",\"success\":true,\"result\":null}";
+
+#define PAYLOAD_SIZE 8192
+
+struct Payload {
+    const char* name;
+    char text[PAYLOAD_SIZE];
+    size_t length;
+};
+
+static Payload payloads[5];
+static int payloadCount = 0;
+
+static Payload& addPayload(const char* name) {
+    Payload& payload = payloads[payloadCount++];
+    payload.name = name;
+    return payload;
+}
+
+// Every bound entity with full attributes, in the given state
+static void fullStates(Payload& payload, int subscription, const char* state) {
+    int length = snprintf(payload.text, PAYLOAD_SIZE, "{\"id\":%d,\"type\":\"event\",\"event\":{\"a\":{", subscription);
+    for (int i = 0; i < entityCount; i++) {
+        length += snprintf(payload.text + length, PAYLOAD_SIZE - length,
+                           "%s\"%s\":{\"s\":\"%s\",%s,\"c\":\"01JA6Y0P3R6T9V2X5Z8B1D4F7H\",\"lc\":1760655600.031}",
+                           i > 0 ? "," : "", entityBindings[i].entityId, state, chargerAttributes);
+    }
+    length += snprintf(payload.text + length, PAYLOAD_SIZE - length, "}}}");
+    payload.length = length;
+}
+
+static void preparePayloads(int subscription) {
+    const char* entity = entityBindings[0].entityId;
+    Payload* payload = &addPayload("all states (a)");
+    fullStates(*payload, subscription, "disconnected");
+    payload = &addPayload("state change (c)");
+    payload->length = snprintf(payload->text, PAYLOAD_SIZE, stateChange, subscription, entity, "charging");
+    payload = &addPayload("attributes only (c)");
+    payload->length = snprintf(payload->text, PAYLOAD_SIZE, attributeChange, subscription, entity);
+    payload = &addPayload("result");
+    payload->length = snprintf(payload->text, PAYLOAD_SIZE, resultMessage, subscription);
+}
+
+static void deliver(const char* text, size_t length) {
+    onMessage(WebsocketsMessage(MessageType::Text, text, length));
+}
+
+static void testStatesApplied(int subscription) {
+    Payload all;
+    fullStates(all, subscription, "charging");
+    deliver(all.text, all.length);
+    for (int i = 0; i < entityCount; i++) {
+        CHECK_EQ(entityStates[i], STATE_CHARGING);
+    }
+
+    char text[PAYLOAD_SIZE];
+    size_t length = snprintf(text, sizeof(text), stateChange, subscription, entityBindings[0].entityId, "disconnected");
+    deliver(text, length);
+    CHECK_EQ(entityStates[0], STATE_DISCONNECTED);
+
+    // Attributes alone leave the state as it is
+    length = snprintf(text, sizeof(text), attributeChange, subscription, entityBindings[0].entityId);
+    deliver(text, length);
+    CHECK_EQ(entityStates[0], STATE_DISCONNECTED);
+
+    // Events from another subscription are not ours
+    length = snprintf(text, sizeof(text), stateChange, subscription + 100, entityBindings[0].entityId, "charging");
+    deliver(text, length);
+    CHECK_EQ(entityStates[0], STATE_DISCONNECTED);
+
+    // Nothing is left on the heap, whatever the message
+    HostAllocStats before = hostAllocStats();
+    for (int i = 0; i < payloadCount; i++) {
+        deliver(payloads[i].text, payloads[i].length);
+    }
+    deliver("{not json", 9);
+    CHECK_EQ(hostAllocStats().allocations - before.allocations, 0);
+}
+
+// --- Before And After ---
+// Before: the payload copied into a String and parsed in full into a
+// JsonDocument on the heap. After: the same filter hass.cpp builds in
+// setupFilters(), parsing straight from the receive buffer into an arena.
+
+static StaticJsonArena<HASS_ARENA_SIZE> testArena("test_json");
+static JsonDocument filter;
+
+static void buildFilter() {
+    filter["type"] = true;
+    filter["id"] = true;
+    filter["success"] = true;
+    filter["error"]["message"] = true;
+    JsonObject event = filter["event"].to<JsonObject>();
+    event["a"]["*"]["s"] = true;
+    event["c"]["*"]["+"]["s"] = true;
+    event["r"] = true;
+}
+
+static volatile bool kept;
+
+static size_t parseBefore(const Payload& payload) {
+    size_t live = hostAllocStats().liveBytes;
+    hostResetPeak();
+    {
+        String copy(payload.text);
+        JsonDocument doc;
+        kept = deserializeJson(doc, copy.c_str(), copy.length()) == DeserializationError::Ok;
+    }
+    return hostAllocStats().peakBytes - live;
+}
+
+static size_t parseAfter(const Payload& payload) {
+    // The test owns this arena, so its high-water mark can start over
+    testArena.reset();
+    testArena.highWater = 0;
+    {
+        JsonDocument doc(&testArena);
+        kept = deserializeJson(doc, payload.text, payload.length, DeserializationOption::Filter(filter)) ==
+               DeserializationError::Ok;
+        CHECK(!doc.overflowed());
+    }
+    return testArena.highWater;
+}
+
+template <typename Parse>
+static double timeParse(Parse parse, const Payload& payload) {
+    const int count = 2000;
+    double best = 1e18;
+    for (int repeat = 0; repeat < 3; repeat++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) {
+            parse(payload);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = min(best, elapsed.count() / count);
+    }
+    return best / 1000;
+}
+
+static void benchmarkParse() {
+    buildFilter();
+    logRuntimeLevel = LOG_INFO;
+
+    printf("%-20s %6s | %-18s | %-18s | %s\n", "payload", "bytes", "full, on the heap", "filtered, arena", "onMessage()");
+    for (int i = 0; i < payloadCount; i++) {
+        const Payload& payload = payloads[i];
+        size_t beforeBytes = parseBefore(payload);
+        size_t afterBytes = parseAfter(payload);
+        double beforeUs = timeParse(parseBefore, payload);
+        double afterUs = timeParse(parseAfter, payload);
+        double handledUs = timeParse([](const Payload& p) { deliver(p.text, p.length); }, payload);
+        printf("%-20s %6zu | %6.2f us %6zu B | %6.2f us %6zu B | %6.2f us\n", payload.name, payload.length,
+               beforeUs, beforeBytes, afterUs, afterBytes, handledUs);
+        CHECK(afterBytes < beforeBytes);
+        CHECK(afterBytes <= HASS_ARENA_SIZE);
+    }
+    logRuntimeLevel = LOG_DEBUG;
+}
+
+int main() {
+    FakeHass hass(1);
+    CHECK(bootSketch(hass, 5, 60000));
+    preparePayloads(hass.subscription());
+    testStatesApplied(hass.subscription());
+    benchmarkParse();
+    return checkResult("test_hass_parse");
+}
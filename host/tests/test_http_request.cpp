@@ -0,0 +1,215 @@
+// The incremental HTTP parser gives the same result however the bytes are
+// split: whole, byte by byte, at every single split point and in random
+// fragments, including pipelined requests and bodies. Also the error
+// statuses, and route and query matching.
+
+#include "http_request.h"
+#include "check.h"
+#include <string.h>
+
+struct Expected {
+    HttpMethod method;
+    const char* path;
+    const char* query;
+    const char* ifNoneMatch;
+    bool keepAlive;
+    bool acceptsGzip;
+};
+
+struct Stream {
+    const char* data;
+    int count;
+    Expected requests[3];
+};
+
+static const Stream streams[] = {
+    { "GET /status HTTP/1.1\r\nHost: charger.local\r\nIf-None-Match: \"3f2a91c7-18\"\r\n"
+      "Accept-Encoding: gzip, deflate, br\r\n\r\n",
+      1, { { HTTP_METHOD_GET, "/status", "", "\"3f2a91c7-18\"", true, true } } },
+
+    { "GET /history?since=1760659200 HTTP/1.0\r\nConnection: keep-alive\r\n\r\n",
+      1, { { HTTP_METHOD_GET, "/history", "since=1760659200", "", true, false } } },
+
+    // Pipelined, the middle one with a body that must be skipped, bare \n
+    // line ends and an empty line before the last request line
+    { "GET / HTTP/1.1\r\nConnection: close\r\n\r\n"
+      "POST /boot HTTP/1.1\nContent-Length: 11\n\nhello=world"
+      "\r\nHEAD /metrics HTTP/1.1\r\nX-Long: "
+      "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+      "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\r\n"
+      "accept-encoding: gzip\r\n\r\n",
+      3, { { HTTP_METHOD_GET, "/", "", "", false, false },
+           { HTTP_METHOD_POST, "/boot", "", "", true, false },
+           { HTTP_METHOD_HEAD, "/metrics", "", "", true, true } } },
+};
+
+struct Parsed {
+    int count;
+    HttpMethod method[4];
+    char path[4][HTTP_MAX_PATH];
+    char query[4][HTTP_MAX_QUERY];
+    char ifNoneMatch[4][HTTP_MAX_ETAG];
+    bool keepAlive[4];
+    bool acceptsGzip[4];
+    bool error;
+};
+
+// Feeds 'data' in the fragments 'cuts' marks, as a connection would see it
+static void parseFragments(const char* data, size_t length, const bool* cuts, Parsed& parsed) {
+    memset(&parsed, 0, sizeof(parsed));
+    HttpRequestParser parser;
+    size_t start = 0;
+    while (start < length) {
+        size_t end = start + 1;
+        while (end < length && !cuts[end]) {
+            end++;
+        }
+        size_t offset = start;
+        while (offset < end) {
+            offset += parser.feed(data + offset, end - offset);
+            if (parser.isError()) {
+                parsed.error = true;
+                return;
+            }
+            if (parser.isComplete()) {
+                int i = parsed.count++;
+                if (i < 4) {
+                    parsed.method[i] = parser.method;
+                    strcpy(parsed.path[i], parser.path);
+                    strcpy(parsed.query[i], parser.query);
+                    strcpy(parsed.ifNoneMatch[i], parser.ifNoneMatch);
+                    parsed.keepAlive[i] = parser.keepAlive;
+                    parsed.acceptsGzip[i] = parser.acceptsGzip;
+                }
+                parser.reset();
+            }
+        }
+        start = end;
+    }
+}
+
+static bool matches(const Parsed& parsed, const Stream& stream) {
+    if (parsed.error || parsed.count != stream.count) {
+        return false;
+    }
+    for (int i = 0; i < stream.count; i++) {
+        const Expected& expected = stream.requests[i];
+        if (parsed.method[i] != expected.method || strcmp(parsed.path[i], expected.path) != 0 ||
+            strcmp(parsed.query[i], expected.query) != 0 ||
+            strcmp(parsed.ifNoneMatch[i], expected.ifNoneMatch) != 0 ||
+            parsed.keepAlive[i] != expected.keepAlive || parsed.acceptsGzip[i] != expected.acceptsGzip) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t seed = 2463534242U;
+
+static uint32_t nextRandom() {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static void testFragments() {
+    bool cuts[2048];
+    for (const Stream& stream : streams) {
+        size_t length = strlen(stream.data);
+        CHECK(length < sizeof(cuts));
+        Parsed parsed;
+
+        memset(cuts, 0, sizeof(cuts));
+        parseFragments(stream.data, length, cuts, parsed);
+        CHECK(matches(parsed, stream));
+
+        memset(cuts, 1, sizeof(cuts));
+        parseFragments(stream.data, length, cuts, parsed);
+        CHECK(matches(parsed, stream));
+
+        for (size_t split = 1; split < length; split++) {
+            memset(cuts, 0, sizeof(cuts));
+            cuts[split] = true;
+            parseFragments(stream.data, length, cuts, parsed);
+            if (!matches(parsed, stream)) {
+                fprintf(stderr, "split at %zu of \"%.20s...\" parses differently\n", split, stream.data);
+                checkFailures++;
+            }
+        }
+
+        for (int round = 0; round < 500; round++) {
+            for (size_t i = 0; i < length; i++) {
+                cuts[i] = nextRandom() % 8 == 0;
+            }
+            parseFragments(stream.data, length, cuts, parsed);
+            if (!matches(parsed, stream)) {
+                fprintf(stderr, "random fragments (round %d) of \"%.20s...\" parse differently\n", round, stream.data);
+                checkFailures++;
+            }
+        }
+    }
+}
+
+static int errorStatus(const char* data) {
+    HttpRequestParser parser;
+    size_t length = strlen(data);
+    // Byte by byte, so errors are found wherever a fragment ends
+    for (size_t i = 0; i < length && !parser.isError(); i++) {
+        parser.feed(data + i, 1);
+    }
+    return parser.isError() ? parser.errorStatus() : 0;
+}
+
+static void testErrors() {
+    CHECK_EQ(errorStatus("GET /status HTTP/1.1\r\n\r\n"), 0);
+    CHECK_EQ(errorStatus("PUT /status HTTP/1.1\r\n\r\n"), 501);
+    CHECK_EQ(errorStatus("GET /status HTTP/2\r\n\r\n"), 400);
+    CHECK_EQ(errorStatus("GET /status\r\n\r\n"), 400);
+    CHECK_EQ(errorStatus("GET status HTTP/1.1\r\n\r\n"), 400);
+    CHECK_EQ(errorStatus("GET /status HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"), 501);
+    CHECK_EQ(errorStatus("GET /status?since=1&filter=aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa HTTP/1.1\r\n\r\n"), 414);
+
+    char longPath[256] = "GET /";
+    memset(longPath + 5, 'p', 120);
+    strcpy(longPath + 125, " HTTP/1.1\r\n\r\n");
+    CHECK_EQ(errorStatus(longPath), 414);
+    memset(longPath + 5, 'p', HTTP_MAX_PATH);
+    strcpy(longPath + 5 + HTTP_MAX_PATH, " HTTP/1.1\r\n\r\n");
+    CHECK_EQ(errorStatus(longPath), 414);
+}
+
+static void testRoutes() {
+    RouteParams params;
+    CHECK(matchRoute("/status", "/status", params) && params.count == 0);
+    CHECK(!matchRoute("/status", "/status/", params));
+    CHECK(!matchRoute("/", "/status", params));
+
+    CHECK(matchRoute("/config/update_state/{int}/{str}", "/config/update_state/2/charging", params));
+    CHECK_EQ(params.count, 2);
+    CHECK_EQ(params.number[0], 2);
+    CHECK(strcmp(params.text[1], "charging") == 0);
+
+    CHECK(matchRoute("/config/display_brightness/{int}", "/config/display_brightness/-5", params));
+    CHECK_EQ(params.number[0], -5);
+    CHECK(!matchRoute("/config/display_brightness/{int}", "/config/display_brightness/5x", params));
+    CHECK(!matchRoute("/config/display_brightness/{int}", "/config/display_brightness/-", params));
+    CHECK(!matchRoute("/config/display_brightness/{int}", "/config/display_brightness/", params));
+    CHECK(!matchRoute("/config/log_level/{str}", "/config/log_level/info/more", params));
+    CHECK(!matchRoute("/config/log_level/{str}", "/config/log_level/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", params));
+
+    char value[16];
+    CHECK(queryParam("since=1760659200&limit=5", "limit", value, sizeof(value)) && strcmp(value, "5") == 0);
+    CHECK(queryParam("since=1760659200&limit=5", "since", value, sizeof(value)) &&
+          strcmp(value, "1760659200") == 0);
+    CHECK(!queryParam("sinceX=1", "since", value, sizeof(value)));
+    CHECK(!queryParam("since=17606592001760659200", "since", value, sizeof(value)));
+    CHECK(!queryParam("", "since", value, sizeof(value)));
+}
+
+int main() {
+    testFragments();
+    testErrors();
+    testRoutes();
+    return checkResult("test_http_request");
+}
@@ -0,0 +1,76 @@
+// Log lines shipped over UDP: the log server's name is looked up without
+// holding up the network pass, a name that does not resolve is tried again
+// LOG_SHIP_RESOLVE_RETRY later, lines logged in the meantime go out once
+// it resolves, and it is resolved only once.
+
+#include "declarations.h"
+#include "logging.h"
+#include "harness.h"
+#include "check.h"
+
+#define STEP_MS      5
+#define DNS_DELAY_MS 3000
+
+// One loop() pass and one step of the clock; how long the pass itself took
+static uint64_t step(FakeHass& hass) {
+    uint64_t start = hostNow();
+    loop();
+    uint64_t pass = hostNow() - start;
+    hostAdvanceMs(STEP_MS);
+    hass.step();
+    return pass;
+}
+
+// Runs until the sketch has started 'lookups' lookups
+static void runUntilLookups(FakeHass& hass, uint32_t lookups, uint32_t timeoutMs) {
+    for (uint32_t elapsed = 0; hostDnsLookups() < lookups && elapsed < timeoutMs; elapsed += STEP_MS) {
+        step(hass);
+    }
+    CHECK_EQ(hostDnsLookups(), lookups);
+}
+
+static void testFailedLookupRetried(FakeHass& hass) {
+    runUntilLookups(hass, 1, 60000);
+    runSketch(hass, DNS_DELAY_MS + 100, STEP_MS);
+    CHECK_EQ(hostUdpPackets(), (uint32_t)0);
+
+    hostDnsSetAvailable(true);
+    runSketch(hass, LOG_SHIP_RESOLVE_RETRY / 2, STEP_MS);
+    CHECK_EQ(hostDnsLookups(), (uint32_t)1);
+    runUntilLookups(hass, 2, LOG_SHIP_RESOLVE_RETRY);
+}
+
+// Lines wait for the answer; no pass does
+static void testSlowLookup(FakeHass& hass) {
+    uint64_t longest = 0;
+    for (uint32_t elapsed = 0; elapsed < DNS_DELAY_MS - 100; elapsed += STEP_MS) {
+        longest = max(longest, step(hass));
+    }
+    CHECK_EQ(hostUdpPackets(), (uint32_t)0);
+    CHECK(longest < (uint64_t)STEP_MS * 1000);
+
+    runSketch(hass, 1000, STEP_MS);
+    CHECK(hostUdpPackets() > 0);
+}
+
+static void testResolvedOnce(FakeHass& hass) {
+    uint32_t lookups = hostDnsLookups();
+    uint32_t packets = hostUdpPackets();
+    for (int i = 0; i < 5; i++) {
+        logWarning("Logged after the log server resolved");
+        runSketch(hass, 2000, STEP_MS);
+    }
+    CHECK(hostUdpPackets() > packets);
+    CHECK_EQ(hostDnsLookups(), lookups);
+}
+
+int main() {
+    hostDnsSetDelay(DNS_DELAY_MS);
+    hostDnsSetAvailable(false);
+    FakeHass hass(1);
+    CHECK(bootSketch(hass, STEP_MS, 60000));
+    testFailedLookupRetried(hass);
+    testSlowLookup(hass);
+    testResolvedOnce(hass);
+    return checkResult("test_log_shipping");
+}
@@ -0,0 +1,161 @@
+// The printf-style log front end: what reaches the ring, what the runtime
+// level skips without evaluating arguments, and that a call allocates
+// nothing. Also times a call against the String concatenation the call
+// sites did before.
+
+#include "declarations.h"
+#include "logging.h"
+#include "harness.h"
+#include "check.h"
+#include <chrono>
+
+static int evaluated = 0;
+
+static const char* counted(const char* text) {
+    evaluated++;
+    return text;
+}
+
+static LogEntry newest() {
+    LogEntry entry = {};
+    CHECK(readLogEntry(logSequence, entry));
+    return entry;
+}
+
+static void testRing() {
+    logRuntimeLevel = LOG_DEBUG;
+    unsigned long before = logSequence;
+
+    logInfo("Subscription successful for ID: %d", 42);
+    CHECK_EQ(logSequence, before + 1);
+    CHECK_EQ(newest().level, LOG_INFO);
+    CHECK(strcmp(newest().message, "Subscription successful for ID: 42") == 0);
+
+    logWarning("two\nlines\r");
+    CHECK(strcmp(newest().message, "two lines ") == 0);
+
+    char longText[300];
+    memset(longText, 'x', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = '\0';
+    logError("%s", longText);
+    CHECK_EQ(strlen(newest().message), LOG_MESSAGE_SIZE - 1);
+    _logMessage(LOG_ERROR, longText);
+    CHECK_EQ(strlen(newest().message), LOG_MESSAGE_SIZE - 1);
+
+    char line[LOG_LINE_SIZE];
+    logInfo("Auth OK!");
+    formatLogEntry(newest(), line, sizeof(line));
+    CHECK(strstr(line, " INFO: Auth OK!") != nullptr);
+
+    // Entries that are gone or not there yet are refused, not handed out
+    LogEntry entry;
+    CHECK(!readLogEntry(0, entry));
+    CHECK(!readLogEntry(logSequence + 1, entry));
+    for (int i = 0; i < LOG_BUFFER_SIZE; i++) {
+        logDebug("filler %d", i);
+    }
+    CHECK(!readLogEntry(firstLogSequence() - 1, entry));
+    CHECK(readLogEntry(firstLogSequence(), entry));
+}
+
+static void testRuntimeLevel() {
+    logRuntimeLevel = LOG_WARNING;
+    unsigned long before = logSequence;
+    evaluated = 0;
+
+    logDebug("Got Message: %s", counted("{}"));
+    logInfo("Got Message: %s", counted("{}"));
+    CHECK_EQ(logSequence, before);
+    CHECK_EQ(evaluated, 0);
+
+    logWarning("HA message without %s", counted("type"));
+    CHECK_EQ(logSequence, before + 1);
+    CHECK_EQ(evaluated, 1);
+
+    LogLevel level;
+    CHECK(parseLogLevel("info", level) && level == LOG_INFO);
+    CHECK(!parseLogLevel("verbose", level));
+    logRuntimeLevel = LOG_DEBUG;
+}
+
+static void testNoAllocations() {
+    const char* payload = "{\"id\":3,\"type\":\"event\",\"event\":{\"c\":{}}}";
+    HostAllocStats before = hostAllocStats();
+    for (int i = 0; i < 1000; i++) {
+        logDebug("Got Message: %s", payload);
+        logInfo("HTTP %d %s: %s", 404, "Not Found", "/favicon.ico");
+        _logMessage(LOG_INFO, "Websocket connection opened");
+    }
+    CHECK_EQ(hostAllocStats().allocations - before.allocations, 0);
+}
+
+// --- Benchmark ---
+
+static volatile size_t kept; // So the String is not optimized away
+
+struct CallCost {
+    double ns;
+    double allocations;
+};
+
+template <typename Call>
+static CallCost measure(Call call) {
+    const int count = 200000;
+    CallCost cost = { 1e9, 0 };
+    for (int repeat = 0; repeat < 3; repeat++) {
+        HostAllocStats before = hostAllocStats();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) {
+            call(i);
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        cost.ns = min(cost.ns, elapsed.count() / count);
+        cost.allocations = (double)(hostAllocStats().allocations - before.allocations) / count;
+    }
+    return cost;
+}
+
+static void report(const char* name, CallCost before, CallCost after) {
+    printf("%-22s String %7.1f ns %4.1f allocs   printf %7.1f ns %4.1f allocs\n",
+           name, before.ns, before.allocations, after.ns, after.allocations);
+}
+
+static void benchmarkCalls() {
+    static const char payload[] =
+        "{\"id\":3,\"type\":\"event\",\"event\":{\"c\":{\"sensor.charger_1\":{\"+\":{\"s\":\"charging\"}}}}}";
+    volatile int status = 404;
+
+    logRuntimeLevel = LOG_DEBUG;
+    report("message with payload",
+           measure([&](int i) {
+               String message = "Got Message: " + String(payload);
+               _logMessage(LOG_DEBUG, message.c_str());
+           }),
+           measure([&](int i) { logDebug("Got Message: %s", payload); }));
+
+    report("number and text",
+           measure([&](int i) {
+               String message = "HTTP " + String(status) + " Not Found: " + String("/favicon.ico");
+               _logMessage(LOG_WARNING, message.c_str());
+           }),
+           measure([&](int i) { logWarning("HTTP %d Not Found: %s", status, "/favicon.ico"); }));
+
+    // Before, a call below the wanted level still built its String
+    logRuntimeLevel = LOG_INFO;
+    report("debug while at info",
+           measure([&](int i) {
+               String message = "Got Message: " + String(payload);
+               kept = message.length();
+           }),
+           measure([&](int i) { logDebug("Got Message: %s", payload); }));
+    logRuntimeLevel = LOG_DEBUG;
+}
+
+int main() {
+    setup();
+    testRing();
+    testRuntimeLevel();
+    testNoAllocations();
+    benchmarkCalls();
+    return checkResult("test_logging");
+}
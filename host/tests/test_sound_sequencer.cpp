@@ -0,0 +1,130 @@
+// The beep sequencer against a fake clock: when the buzzer is on for a
+// pattern, how queued patterns follow each other, merging and dropping,
+// catching up after a late timer and millis() wrapping around.
+
+#include "sound_sequencer.h"
+#include "check.h"
+
+// Steps the clock 1 ms at a time and records every on/off edge
+struct Timeline {
+    unsigned long edges[32];
+    int count;
+};
+
+static void run(SoundSequencer& sequencer, unsigned long from, unsigned long to, Timeline& timeline) {
+    timeline.count = 0;
+    bool on = sequencer.isOn();
+    for (unsigned long now = from; now != to; now++) {
+        bool next = sequencer.update(now);
+        if (next != on && timeline.count < 32) {
+            timeline.edges[timeline.count++] = now - from;
+        }
+        on = next;
+    }
+}
+
+static void testPattern() {
+    SoundSequencer sequencer;
+    CHECK(!sequencer.isBusy());
+    CHECK(sequencer.enqueue({ 3, 100, 50 }, 0));
+    CHECK(sequencer.isOn());
+    CHECK_EQ(sequencer.nextDeadline(), 50UL);
+
+    // On 0-50, 150-200, 300-350, then the pause before going idle
+    Timeline timeline;
+    run(sequencer, 0, 1000, timeline);
+    CHECK_EQ(timeline.count, 5);
+    CHECK_EQ(timeline.edges[0], 50UL);
+    CHECK_EQ(timeline.edges[1], 150UL);
+    CHECK_EQ(timeline.edges[2], 200UL);
+    CHECK_EQ(timeline.edges[3], 300UL);
+    CHECK_EQ(timeline.edges[4], 350UL);
+    CHECK(!sequencer.isBusy());
+    CHECK_EQ(sequencer.played, 1U);
+
+    CHECK(!sequencer.enqueue({ 0, 100, 50 }, 1000));
+    CHECK(!sequencer.isBusy());
+}
+
+static void testQueued() {
+    SoundSequencer sequencer;
+    sequencer.enqueue({ 1, 0, 100 }, 0);
+    sequencer.enqueue({ 2, 50, 20 }, 10);
+
+    // The second starts after the first one's pause
+    Timeline timeline;
+    run(sequencer, 0, 1000, timeline);
+    CHECK_EQ(timeline.count, 5);
+    CHECK_EQ(timeline.edges[0], 100UL);
+    CHECK_EQ(timeline.edges[1], 100UL + SOUND_PATTERN_PAUSE);
+    CHECK_EQ(timeline.edges[2], 120UL + SOUND_PATTERN_PAUSE);
+    CHECK_EQ(timeline.edges[3], 170UL + SOUND_PATTERN_PAUSE);
+    CHECK_EQ(timeline.edges[4], 190UL + SOUND_PATTERN_PAUSE);
+    CHECK_EQ(sequencer.played, 2U);
+}
+
+static void testMergeAndDrop() {
+    SoundSequencer sequencer;
+    SoundPattern beep = { 1, 0, 100 };
+    CHECK(sequencer.enqueue(beep, 0));
+    CHECK(!sequencer.enqueue(beep, 10)); // Same as the one sounding
+    CHECK_EQ(sequencer.merged, 1U);
+
+    // Fill the queue behind it; the oldest waiting patterns give way
+    for (uint8_t beeps = 2; beeps < 2 + SOUND_QUEUE_SIZE + 2; beeps++) {
+        CHECK(sequencer.enqueue({ beeps, 10, 10 }, 20));
+        CHECK(!sequencer.enqueue({ beeps, 10, 10 }, 20));
+    }
+    CHECK_EQ(sequencer.dropped, 2U);
+    CHECK_EQ(sequencer.merged, 1U + SOUND_QUEUE_SIZE + 2);
+
+    Timeline timeline;
+    run(sequencer, 20, 20000, timeline);
+    CHECK(!sequencer.isBusy());
+    CHECK_EQ(sequencer.played, 1U + SOUND_QUEUE_SIZE);
+}
+
+static void testLateUpdate() {
+    // One update long after the deadline ends up where stepping would have
+    SoundSequencer stepped;
+    SoundSequencer late;
+    stepped.enqueue({ 3, 40, 30 }, 0);
+    late.enqueue({ 3, 40, 30 }, 0);
+    stepped.enqueue({ 2, 20, 20 }, 0);
+    late.enqueue({ 2, 20, 20 }, 0);
+
+    Timeline timeline;
+    run(stepped, 0, 265, timeline);
+    CHECK_EQ(late.update(264), stepped.isOn());
+    CHECK_EQ(late.nextDeadline(), stepped.nextDeadline());
+    CHECK_EQ(late.played, stepped.played);
+
+    // Zero length phases still move forward
+    SoundSequencer zero;
+    zero.enqueue({ 2, 0, 0 }, 0);
+    zero.update(1000);
+    CHECK(!zero.isBusy());
+}
+
+static void testWraparound() {
+    SoundSequencer sequencer;
+    unsigned long start = (unsigned long)-120;
+    sequencer.enqueue({ 2, 100, 50 }, start);
+
+    Timeline timeline;
+    run(sequencer, start, start + 1000, timeline);
+    CHECK_EQ(timeline.count, 3);
+    CHECK_EQ(timeline.edges[0], 50UL);
+    CHECK_EQ(timeline.edges[1], 150UL);
+    CHECK_EQ(timeline.edges[2], 200UL);
+    CHECK(!sequencer.isBusy());
+}
+
+int main() {
+    testPattern();
+    testQueued();
+    testMergeAndDrop();
+    testLateUpdate();
+    testWraparound();
+    return checkResult("test_sound_sequencer");
+}
@@ -0,0 +1,98 @@
+// Once every boot stage is done, loop() (the network and render passes and
+// the timers they arm) never calls malloc: not while serving every HTTP
+// route, pushing frames to a WebSocket subscriber, or following Home
+// Assistant through state changes, restarts and WiFi drops.
+//
+// The fake Arduino layer does not allocate, so what the real libraries
+// allocate on their own is not counted here; pools.h lists those.
+
+#include "declarations.h"
+#include "http_server.h"
+#include "harness.h"
+#include "http_probe.h"
+#include "check.h"
+
+#define STEP_MS 5
+
+static const char* const routes[] = {
+    "/status",
+    "/metrics",
+    "/history",
+    "/beep",
+    "/config/display_brightness/20",
+    "/config/log_level/debug",
+    "/config/update_state/1/charging",
+};
+static const int routeCount = sizeof(routes) / sizeof(routes[0]);
+
+static HttpProbe probe;
+static uint64_t routeAllocations[routeCount];
+
+// loop() and the timers for one step; returns the allocations they made
+static uint64_t step(FakeHass& hass) {
+    HostAllocStats before = hostAllocStats();
+    loop();
+    hostAdvanceMs(STEP_MS);
+    uint64_t made = hostAllocStats().allocations - before.allocations;
+    hass.step();
+    return made;
+}
+
+// Every route once, each fetched to the end
+static void fetchRoutes(FakeHass& hass) {
+    for (int i = 0; i < routeCount; i++) {
+        CHECK(probe.start(routes[i]));
+        for (int wait = 0; probe.busy() && wait < 2000; wait++) {
+            routeAllocations[i] += step(hass);
+            probe.poll();
+        }
+        CHECK(!probe.busy());
+    }
+}
+
+int main() {
+    FakeHass hass(7);
+    CHECK(bootSketch(hass, STEP_MS, 60000));
+    int subscriber = hostWsConnect();
+    hostWsSend(subscriber, "subscribe");
+
+    // Warm up: first use of every route and a minute of frames
+    fetchRoutes(hass);
+    runSketch(hass, 60000, STEP_MS);
+    memset(routeAllocations, 0, sizeof(routeAllocations));
+
+    uint64_t allocations = 0;
+    uint32_t connections = hass.stats().connections;
+    uint32_t pushed = getFramesPushed();
+    for (int minute = 1; minute <= 60; minute++) {
+        // Home Assistant goes away, then WiFi, besides what the script does
+        if (minute % 20 == 5) {
+            hostHassDrop();
+        } else if (minute % 20 == 15) {
+            hostWifiSetAvailable(false);
+        } else if (minute % 20 == 16) {
+            hostWifiSetAvailable(true);
+        }
+        for (int i = 0; i < 60000 / STEP_MS; i++) {
+            allocations += step(hass);
+        }
+        fetchRoutes(hass);
+    }
+
+    for (int i = 0; i < routeCount; i++) {
+        if (routeAllocations[i] > 0) {
+            fprintf(stderr, "%s: %llu allocations\n", routes[i], (unsigned long long)routeAllocations[i]);
+            checkFailures++;
+        }
+    }
+    CHECK_EQ(allocations, 0ULL);
+
+    // The run covered what it should have
+    CHECK(hass.stats().connections > connections);
+    CHECK(getFramesPushed() > pushed);
+    CHECK_EQ(probe.failures, 0U);
+    printf("%u HTTP requests, %u HA connections, %u frames pushed, %llu allocations\n", probe.requests,
+           hass.stats().connections - connections, getFramesPushed() - pushed,
+           (unsigned long long)allocations);
+    return checkResult("test_steady_heap");
+}
@@ -0,0 +1,129 @@
+// WebSocket push to subscribers that do not keep up: a client that stops
+// reading is skipped without blocking the network pass and dropped once its
+// send buffer stays full, one that reads again is resynced with a full
+// snapshot, one on a slow link keeps its subscription, and the others get
+// their frames on time throughout.
+
+#include "declarations.h"
+#include "logging.h"
+#include "harness.h"
+#include "check.h"
+
+#define STEP_MS        5
+#define SLOW_READ_RATE 2000 // Bytes per second
+
+struct Counts {
+    uint32_t texts;
+    uint32_t binaries;
+};
+
+static Counts counts(int num) {
+    const HostWsClient& client = hostWsClient(num);
+    return { client.texts, client.binaries };
+}
+
+static int subscribe() {
+    int num = hostWsConnect();
+    CHECK(num >= 0);
+    hostWsSend(num, "subscribe");
+    return num;
+}
+
+static bool isDelta(int num) {
+    return strstr(hostWsClient(num).lastText, "\"type\":\"delta\"") != nullptr;
+}
+
+static void testStalledClientDropped(FakeHass& hass) {
+    int fast = subscribe();
+    int slow = subscribe();
+    runSketch(hass, 5000, STEP_MS);
+    CHECK(counts(fast).binaries > 0 && counts(slow).binaries > 0);
+    uint32_t usual = counts(fast).binaries;
+    runSketch(hass, 10000, STEP_MS);
+    usual = counts(fast).binaries - usual;
+
+    Counts fastBefore = counts(fast);
+    hostWsStall(slow, true);
+    runSketch(hass, 10000, STEP_MS);
+
+    // Skipped once its buffer filled, never waited on, then gone
+    CHECK(!hostWsClient(slow).connected);
+    CHECK_EQ(hostWsClient(slow).blockedUs, (uint64_t)0);
+
+    // The other client got about as many frames as without it
+    uint32_t got = counts(fast).binaries - fastBefore.binaries;
+    printf("frames to the other client in 10 s: %u while one stalled, %u before\n", got, usual);
+    CHECK(got * 10 >= usual * 9);
+    CHECK_EQ(hostWsClient(fast).blockedUs, (uint64_t)0);
+    hostWsClose(fast);
+    runSketch(hass, 100, STEP_MS);
+}
+
+static void testStalledClientResynced(FakeHass& hass) {
+    int client = subscribe();
+    runSketch(hass, 3000, STEP_MS);
+    CHECK(isDelta(client));
+
+    // Stops reading until sends to it stop, then reads again
+    hostWsStall(client, true);
+    Counts last = counts(client);
+    for (int i = 0; i < 1000; i++) {
+        runSketch(hass, 200, STEP_MS);
+        Counts now = counts(client);
+        if (now.texts == last.texts && now.binaries == last.binaries) {
+            break;
+        }
+        last = now;
+    }
+    // Misses a delta with a log line in it, but is not stalled long enough
+    // to be dropped
+    logWarning("Logged while a subscriber is stalled");
+    runSketch(hass, 2000, STEP_MS);
+    hostWsStall(client, false);
+
+    // What it missed comes as one full snapshot instead of the deltas
+    Counts held = counts(client);
+    for (int i = 0; i < 1000 && counts(client).texts == held.texts; i++) {
+        runSketch(hass, STEP_MS, STEP_MS);
+    }
+    CHECK_EQ(counts(client).texts, held.texts + 1);
+    CHECK(!isDelta(client));
+
+    runSketch(hass, 3000, STEP_MS);
+    CHECK(hostWsClient(client).connected);
+    CHECK(isDelta(client));
+    hostWsClose(client);
+    runSketch(hass, 100, STEP_MS);
+}
+
+// A healthy client behind a slow link reads slower than a snapshot and a
+// few frames arrive, so its buffer is full now and then; it is held back
+// but kept, and ends up on deltas again
+static void testSlowLinkKept(FakeHass& hass) {
+    int num = hostWsConnect();
+    CHECK(num >= 0);
+    hostWsSetReadRate(num, SLOW_READ_RATE);
+    hostWsSend(num, "subscribe");
+    runSketch(hass, 20000, STEP_MS);
+
+    const HostWsClient& client = hostWsClient(num);
+    printf("slow link: %u texts, %u frames, %llu bytes in 20 s\n", client.texts, client.binaries,
+           (unsigned long long)client.bytes);
+    CHECK(client.connected);
+    CHECK(client.bytes <= 20 * SLOW_READ_RATE + HOST_WS_SEND_BUFFER);
+    Counts before = counts(num);
+    runSketch(hass, 3000, STEP_MS);
+    CHECK(counts(num).binaries > before.binaries);
+    CHECK(isDelta(num));
+    hostWsClose(num);
+    runSketch(hass, 100, STEP_MS);
+}
+
+int main() {
+    FakeHass hass(5);
+    CHECK(bootSketch(hass, STEP_MS, 60000));
+    testStalledClientDropped(hass);
+    testStalledClientResynced(hass);
+    testSlowLinkKept(hass);
+    return checkResult("test_ws_push");
+}
@@ -0,0 +1,72 @@
+import asyncio
+import json
+import random
+import time
+from aiohttp import web, WSMsgType
+
+# Minimal stand-in for the Home Assistant WebSocket API, enough for the
+# firmware's subscribe_entities flow (see main/hass.cpp). Point HASS_HOST and
+# HASS_PORT in secrets.h at this machine.
+#
+# For every connection it prints how many messages the device sent and how
+# long it took from the socket opening to the initial states being sent.
+HTTP_PORT = 8123
+TOKEN = "TOKEN"
+STATES = ["charging", "disconnected", "unknown"]
+CHANGE_INTERVAL = 10  # seconds between random state changes
+
+
+async def websocket_handler(request):
+    ws = web.WebSocketResponse()
+    await ws.prepare(request)
+    opened = time.monotonic()
+    received = 0
+    subscription = None
+    states = {}
+
+    await ws.send_json({"type": "auth_required", "ha_version": "mock"})
+
+    async def change_states():
+        while True:
+            await asyncio.sleep(CHANGE_INTERVAL)
+            entity_id = random.choice(list(states))
+            states[entity_id] = random.choice(STATES)
+            await ws.send_json({"id": subscription, "type": "event", "event": {
+                "c": {entity_id: {"+": {"s": states[entity_id], "lc": time.time()}}}}})
+            print(f"{entity_id} -> {states[entity_id]}")
+
+    changer = None
+    try:
+        async for msg in ws:
+            if msg.type != WSMsgType.TEXT:
+                continue
+            received += 1
+            data = json.loads(msg.data)
+            print(f"<- {data}")
+
+            if data.get("type") == "auth":
+                ok = data.get("access_token") == TOKEN
+                await ws.send_json({"type": "auth_ok" if ok else "auth_invalid"})
+            elif data.get("type") == "subscribe_entities":
+                subscription = data["id"]
+                states = {entity_id: random.choice(STATES) for entity_id in data.get("entity_ids", [])}
+                await ws.send_json({"id": subscription, "type": "result", "success": True, "result": None})
+                await ws.send_json({"id": subscription, "type": "event", "event": {
+                    "a": {entity_id: {"s": state, "a": {"friendly_name": entity_id}, "c": "mock", "lc": time.time()}
+                          for entity_id, state in states.items()}}})
+                elapsed = (time.monotonic() - opened) * 1000
+                print(f"Initial states for {len(states)} entities sent {elapsed:.0f} ms after connecting, "
+                      f"{received} messages received so far")
+                if changer is None and states:
+                    changer = asyncio.create_task(change_states())
+    finally:
+        if changer is not None:
+            changer.cancel()
+        print(f"Connection closed, {received} messages received")
+    return ws
+
+
+if __name__ == "__main__":
+    app = web.Application()
+    app.router.add_get('/api/websocket', websocket_handler)
+    web.run_app(app, port=HTTP_PORT)
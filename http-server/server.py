@@ -10,29 +10,90 @@ HTTP_PORT = 8080
 HEARTBEAT_INTERVAL = 5  # seconds
 
 # -------- UDP Server --------
+# Datagrams are either a single plain log line, or a batch sent by the
+# firmware (see shipLogs() in main/logging.cpp):
+#
+#   @<hostname> 1 <first seq> <last seq>
+#   <seq> <line>
+#   ...
+BATCH_MAGIC = "@"
+
+# A sequence number at or below the last one is a duplicated or reordered
+# datagram, unless it is back near the start (the device rebooted) or far
+# below the last one (rebooted after logging more than that before WiFi)
+RESTART_SEQ = 100
+STALE_WINDOW = 1000
+
+
+def parse_batch(text):
+    """Returns (source, [(seq, line), ...]) for a batch, or None for a plain line."""
+    if not text.startswith(BATCH_MAGIC):
+        return None
+    header, _, body = text.partition("\n")
+    parts = header[1:].split()
+    if len(parts) != 4 or parts[1] != "1":
+        return None
+    entries = []
+    for row in body.splitlines():
+        seq, _, line = row.partition(" ")
+        if seq.isdigit():
+            entries.append((int(seq), line))
+    return parts[0], entries
+
+
 class UDPServerProtocol:
     def __init__(self, clients):
         self.clients = clients
+        self.last_seq = {}  # source -> last sequence number received
+        self.lines_received = 0
+        self.lines_missing = 0
+        self.lines_stale = 0
 
     def connection_made(self, transport):
         self.transport = transport
         print(f"UDP server listening on port {UDP_PORT}")
 
     def datagram_received(self, data, addr):
-        message = data.decode().strip()
-        print(f"Received from {addr}: {message}")
-        asyncio.create_task(self.write_and_broadcast(message))
-
-    async def write_and_broadcast(self, message):
+        text = data.decode(errors="replace")
+        batch = parse_batch(text)
+        if batch is None:
+            message = text.strip()
+            print(f"Received from {addr}: {message}")
+            asyncio.create_task(self.write_and_broadcast([message]))
+            return
+
+        source, entries = batch
+        messages = []
+        for seq, line in entries:
+            last = self.last_seq.get(source)
+            if last is not None and seq > last + 1:
+                missing = seq - last - 1
+                self.lines_missing += missing
+                messages.append(f"[{source}] ... {missing} log lines missing ({last + 1}-{seq - 1})")
+            elif last is not None and seq <= last:
+                if seq > RESTART_SEQ and last - seq <= STALE_WINDOW:
+                    self.lines_stale += 1
+                    continue
+                # Sequence restarted, the device rebooted
+                messages.append(f"[{source}] ... sequence restarted at {seq}")
+            self.last_seq[source] = seq
+            messages.append(f"[{source}] {line}")
+            self.lines_received += 1
+        print(f"Received batch from {addr}: {len(entries)} lines "
+              f"(total {self.lines_received}, missing {self.lines_missing}, stale {self.lines_stale})")
+        asyncio.create_task(self.write_and_broadcast(messages))
+
+    async def write_and_broadcast(self, messages):
         timestamp = datetime.now().isoformat()
-        log_message = f"{timestamp} - {message}"
+        log_messages = [f"{timestamp} - {message}" for message in messages]
         # Write to file
         async with aiofiles.open(LOG_FILE, "a") as f:
-            await f.write(log_message + "\n")
+            await f.write("".join(line + "\n" for line in log_messages))
 
         # Broadcast to all connected HTTP clients
         for queue in self.clients:
-            queue.put_nowait(log_message + "\n")
+            for line in log_messages:
+                queue.put_nowait(line + "\n")
 
 # -------- HTTP Server --------
 async def tail_handler(request):
@@ -0,0 +1,169 @@
+#include "animation.h"
+#include "logging.h"
+#include "perf.h"
+
+static AnimationStats animationStats;
+
+// Keyframes for the current step and the one after it
+static RgbFrame keyFrom;
+static RgbFrame keyTo;
+static LookCells keyLook; // keyFrom in palette form
+static uint32_t keyStep = 0;
+static bool keysValid = false;
+
+// Cross-fade after a state change
+static RgbFrame fadeFrom;
+static unsigned long fadeStart = 0;
+static bool fading = false;
+
+static RgbFrame lastOutput;
+static bool anyOutput = false;
+
+static uint32_t stepOffset = 0;
+
+static uint8_t overrunStreak = 0;
+static uint8_t onTimeStreak = 0;
+
+uint16_t easeQ8(uint16_t t) {
+    // Smoothstep, 3t^2 - 2t^3 scaled to 0..256
+    uint32_t t32 = t;
+    return (uint16_t)((t32 * t32 * (768 - 2 * t32)) >> 16);
+}
+
+uint32_t blendRgb(uint32_t from, uint32_t to, uint16_t t) {
+    if (from == to || t == 0) return from;
+    if (t >= 256) return to;
+
+    uint32_t out = 0;
+    for (int shift = 0; shift <= 16; shift += 8) {
+        int a = (from >> shift) & 0xFF;
+        int b = (to >> shift) & 0xFF;
+        out |= (uint32_t)(a + (((b - a) * (int)t) >> 8)) << shift;
+    }
+    return out;
+}
+
+void blendFrames(const RgbFrame& from, const RgbFrame& to, uint16_t t, RgbFrame& out) {
+    for (int i = 0; i < MATRIX_HEIGHT; i++) {
+        for (int j = 0; j < MATRIX_WIDTH; j++) {
+            out[i][j] = blendRgb(from[i][j], to[i][j], t);
+        }
+    }
+}
+
+static void composeKeyframe(uint32_t step, RgbFrame& frame) {
+    setLookStep(step);
+    composeLook();
+    lookToRgb(frame);
+}
+
+static void updateKeyframes(uint32_t step) {
+    if (keysValid && step == keyStep) {
+        return;
+    }
+    // Next step first, so displayArray and the highlight end up on the
+    // current step for /status
+    composeKeyframe(step + 1, keyTo);
+    composeKeyframe(step, keyFrom);
+    captureLook(keyLook);
+    keyStep = step;
+    keysValid = true;
+}
+
+// Position inside the blend window at the end of the step, 0..256
+static uint16_t stepBlend(unsigned long nowMs) {
+    unsigned long phase = nowMs % interval;
+    unsigned long blendStart = interval > ANIMATION_BLEND_MS ? interval - ANIMATION_BLEND_MS : 0;
+    if (phase < blendStart) {
+        return 0;
+    }
+    return (uint16_t)(((phase - blendStart) << 8) / (interval - blendStart));
+}
+
+void startStateFade(unsigned long nowMs) {
+    // The keyframes depend on the state, recompose them on the next frame
+    keysValid = false;
+    if (!anyOutput || animationStats.degraded) {
+        return;
+    }
+    memcpy(fadeFrom, lastOutput, sizeof(fadeFrom));
+    fadeStart = nowMs;
+    fading = true;
+}
+
+bool animationFading() {
+    return fading;
+}
+
+static void recordFrame(uint32_t frameUs) {
+    animationStats.frames++;
+    animationStats.lastFrameUs = frameUs;
+    animationStats.avgFrameUs = (int32_t)animationStats.avgFrameUs + ((int32_t)frameUs - (int32_t)animationStats.avgFrameUs) / 16;
+    if (frameUs > animationStats.maxFrameUs) {
+        animationStats.maxFrameUs = frameUs;
+    }
+
+    if (frameUs > ANIMATION_FRAME_BUDGET_US) {
+        animationStats.overruns++;
+        onTimeStreak = 0;
+        if (!animationStats.degraded && ++overrunStreak >= ANIMATION_DEGRADE_AFTER) {
+            animationStats.degraded = true;
+            fading = false;
+            logWarning("Animation frames over budget (%lu us), blending disabled", (unsigned long)frameUs);
+        }
+    } else {
+        overrunStreak = 0;
+        if (animationStats.degraded && ++onTimeStreak >= ANIMATION_RECOVER_AFTER) {
+            animationStats.degraded = false;
+            onTimeStreak = 0;
+            logInfo("Animation frames back within budget, blending enabled");
+        }
+    }
+}
+
+void renderAnimationFrame(unsigned long nowMs) {
+    PerfScope perf(PERF_ANIMATION_FRAME);
+    unsigned long startUs = micros();
+
+    updateKeyframes(getAnimationStep(nowMs));
+
+    RgbFrame frame;
+    const LookCells* look = &keyLook; // Until a blend makes it something else
+    if (animationStats.degraded) {
+        memcpy(frame, keyFrom, sizeof(frame));
+    } else {
+        uint16_t blend = easeQ8(stepBlend(nowMs));
+        blendFrames(keyFrom, keyTo, blend, frame);
+        if (blend > 0) {
+            look = nullptr;
+        }
+        if (fading) {
+            unsigned long elapsed = nowMs - fadeStart;
+            if (elapsed >= ANIMATION_FADE_MS) {
+                fading = false;
+            } else {
+                uint16_t t = (uint16_t)((elapsed << 8) / ANIMATION_FADE_MS);
+                blendFrames(fadeFrom, frame, easeQ8(t), frame);
+                look = nullptr;
+            }
+        }
+    }
+
+    showFrame(frame, look);
+    memcpy(lastOutput, frame, sizeof(lastOutput));
+    anyOutput = true;
+
+    recordFrame(micros() - startUs);
+}
+
+uint32_t getAnimationStep(unsigned long nowMs) {
+    return nowMs / interval + stepOffset;
+}
+
+void setAnimationStep(uint32_t step) {
+    stepOffset = step - millis() / interval;
+}
+
+const AnimationStats& getAnimationStats() {
+    return animationStats;
+}
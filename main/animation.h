@@ -0,0 +1,56 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "display.h"
+
+// --- Animation ---
+// The looks in display.cpp are keyframes: setLookStep(n) + composeLook()
+// draws step n, and a step lasts `interval` ms. Frames in between are
+// rendered at ANIMATION_FPS by blending the current keyframe into the next
+// one during the last ANIMATION_BLEND_MS of each step, so the charging row
+// and the border highlight glide instead of jumping. A change of state
+// cross-fades from whatever was on the display over ANIMATION_FADE_MS.
+//
+// All blending is 8.8 fixed point on 0xRRGGBB values; gamma correction and
+// brightness are applied afterwards by showFrame() through a single LUT.
+//
+// A frame that takes longer than ANIMATION_FRAME_BUDGET_US counts as an
+// overrun. After ANIMATION_DEGRADE_AFTER overruns in a row the engine stops
+// blending and shows plain keyframes until ANIMATION_RECOVER_AFTER frames in
+// a row fit the budget again.
+
+#define ANIMATION_FPS              40
+#define ANIMATION_FRAME_US         (1000000UL / ANIMATION_FPS)
+#define ANIMATION_BLEND_MS         300
+#define ANIMATION_FADE_MS          400
+#define ANIMATION_FRAME_BUDGET_US  8000
+#define ANIMATION_DEGRADE_AFTER    3
+#define ANIMATION_RECOVER_AFTER    80
+
+struct AnimationStats {
+    uint32_t frames;
+    uint32_t lastFrameUs;
+    uint32_t avgFrameUs; // Moving average over ~16 frames
+    uint32_t maxFrameUs;
+    uint32_t overruns;
+    bool degraded;
+};
+
+// Fixed-point helpers, t is 0..256
+uint16_t easeQ8(uint16_t t);
+uint32_t blendRgb(uint32_t from, uint32_t to, uint16_t t);
+void blendFrames(const RgbFrame& from, const RgbFrame& to, uint16_t t, RgbFrame& out);
+
+// The step shown at nowMs. Counts from boot unless setAnimationStep() moved
+// it, which the warm start does before the render task runs.
+uint32_t getAnimationStep(unsigned long nowMs);
+void setAnimationStep(uint32_t step);
+
+// Render side
+void startStateFade(unsigned long nowMs);
+void renderAnimationFrame(unsigned long nowMs);
+bool animationFading();
+
+const AnimationStats& getAnimationStats();
+
+#endif // ANIMATION_H
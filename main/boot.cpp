@@ -0,0 +1,123 @@
+#include "boot.h"
+#include "logging.h"
+#include "display.h"
+#include "render.h"
+#include "hass.h"
+#include "connection.h"
+#include "http_server.h"
+#include "status.h"
+
+// --- Stage Actions ---
+
+static void startDisplay() {
+    setupDisplay();
+    publishDisplayState();
+    renderPass();
+}
+
+static void startNetwork() {
+    // WiFi and the HA websocket are then driven by loopConnection()
+    setupHass();
+    setupConnection();
+}
+
+static void startClock() {
+    timeClient.begin(NTP_SERVER);
+}
+
+static bool wifiReady() {
+    return wifi_connected;
+}
+
+static bool clockReady() {
+    return timeClient.isTimeSet();
+}
+
+static bool hassReady() {
+    return ws_connected;
+}
+
+// --- Stage Table ---
+
+#define AFTER(stage) (1U << (stage))
+
+struct BootStageInfo {
+    const char* name;
+    uint32_t after;  // AFTER() bits of the stages that must be done first
+    void (*start)(); // Must not block; nullptr when something else drives the stage
+    bool (*ready)(); // Polled until true; nullptr when start() completes it
+};
+
+// Indexed by BootStage
+static const BootStageInfo stages[BOOT_STAGE_COUNT] = {
+    { "display", 0,                    startDisplay,    nullptr },
+    { "network", 0,                    startNetwork,    nullptr },
+    { "http",    AFTER(BOOT_NETWORK),  setupHttpServer, nullptr },
+    { "wifi",    AFTER(BOOT_NETWORK),  nullptr,         wifiReady },
+    { "ntp",     AFTER(BOOT_WIFI),     startClock,      clockReady },
+    { "hass",    AFTER(BOOT_WIFI),     nullptr,         hassReady },
+    { "state",   AFTER(BOOT_HASS),     nullptr,         hassStatesSynced },
+};
+
+static BootTiming timings[BOOT_STAGE_COUNT];
+static uint32_t doneMask = 0;
+
+static void completeStage(int stage, unsigned long now) {
+    timings[stage].done = true;
+    timings[stage].doneMs = now;
+    doneMask |= AFTER(stage);
+    logInfo("Boot stage %s done after %lu ms", stages[stage].name, now);
+    notifyStatusChanged();
+}
+
+// One sweep over the table; returns true when a stage completed, since
+// that may unblock stages earlier in the table
+static bool advance() {
+    bool progress = false;
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        const BootStageInfo& stage = stages[i];
+        BootTiming& timing = timings[i];
+        if (timing.done || (stage.after & doneMask) != stage.after) {
+            continue;
+        }
+        if (!timing.started) {
+            timing.started = true;
+            timing.startedMs = millis();
+            if (stage.start != nullptr) {
+                stage.start();
+            }
+        }
+        if (stage.ready == nullptr || stage.ready()) {
+            completeStage(i, millis());
+            progress = true;
+        }
+    }
+    return progress;
+}
+
+void setupBoot() {
+    memset(timings, 0, sizeof(timings));
+    doneMask = 0;
+    while (advance()) {
+    }
+}
+
+void loopBoot() {
+    if (doneMask == AFTER(BOOT_STAGE_COUNT) - 1) {
+        return;
+    }
+    while (advance()) {
+    }
+}
+
+bool bootStageDone(BootStage stage) {
+    return timings[stage].done;
+}
+
+const BootTiming& getBootTiming(BootStage stage) {
+    return timings[stage];
+}
+
+const char* bootStageName(BootStage stage) {
+    return stage < BOOT_STAGE_COUNT ? stages[stage].name : "unknown";
+}
@@ -0,0 +1,49 @@
+#ifndef BOOT_H
+#define BOOT_H
+
+#include "declarations.h"
+
+// --- Boot Stages ---
+// Boot is split into stages with declared dependencies instead of one
+// sequence in setup(). A stage starts as soon as the stages it depends on
+// are done; starting never blocks, and a stage that completes later
+// (WiFi, the clock, Home Assistant) is polled from the network pass. So the
+// display and the HTTP server are up within milliseconds, while WiFi, NTP
+// and the HA sync progress in the background.
+//
+// When each stage first completed is kept in ms since boot and reported in
+// /status ("boot") and /metrics, so boot times can be compared between
+// releases: first frame (BOOT_DISPLAY), network (BOOT_WIFI) and valid
+// state (BOOT_STATE).
+
+enum BootStage : uint8_t {
+    BOOT_DISPLAY = 0, // First frame shown, from the warm-start cache if any
+    BOOT_NETWORK,     // WiFi driver and TCP/IP stack initialized
+    BOOT_HTTP,        // HTTP and WebSocket servers listening
+    BOOT_WIFI,        // Got an IP address
+    BOOT_NTP,         // Clock set
+    BOOT_HASS,        // HA WebSocket connected
+    BOOT_STATE,       // Entity states received from HA
+    BOOT_STAGE_COUNT
+};
+
+struct BootTiming {
+    bool started;
+    bool done;
+    unsigned long startedMs;
+    unsigned long doneMs;
+};
+
+// Runs every stage that can start right away; call at the end of setup()'s
+// local initialization (entities, history, warm start)
+void setupBoot();
+
+// Starts stages whose dependencies completed and polls the running ones.
+// Costs nothing once every stage is done.
+void loopBoot();
+
+bool bootStageDone(BootStage stage);
+const BootTiming& getBootTiming(BootStage stage);
+const char* bootStageName(BootStage stage);
+
+#endif // BOOT_H
@@ -0,0 +1,97 @@
+#include "buffered_print.h"
+#include <stdarg.h>
+
+BufferedPrint::BufferedPrint(Print& target) : target(target), length(0) {}
+
+BufferedPrint::~BufferedPrint() {
+    flushBuffer();
+}
+
+size_t BufferedPrint::write(uint8_t c) {
+    if (length == BUFFERED_PRINT_SIZE) {
+        flushBuffer();
+    }
+    buffer[length++] = c;
+    return 1;
+}
+
+size_t BufferedPrint::write(const uint8_t* data, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        if (length == BUFFERED_PRINT_SIZE) {
+            flushBuffer();
+        }
+        size_t chunk = min(size - written, (size_t)(BUFFERED_PRINT_SIZE - length));
+        memcpy(buffer + length, data + written, chunk);
+        length += chunk;
+        written += chunk;
+    }
+    return written;
+}
+
+void BufferedPrint::flushBuffer() {
+    if (length > 0) {
+        target.write(buffer, length);
+        length = 0;
+    }
+}
+
+#define CHUNK_HEAD 6
+
+ChunkedPrint::ChunkedPrint(Print& target) : target(target), length(0), finished(false) {}
+
+ChunkedPrint::~ChunkedPrint() {
+    finish();
+}
+
+size_t ChunkedPrint::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t ChunkedPrint::write(const uint8_t* data, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        if (length == BUFFERED_PRINT_SIZE) {
+            flushChunk();
+        }
+        size_t chunk = min(size - written, (size_t)(BUFFERED_PRINT_SIZE - length));
+        memcpy(buffer + CHUNK_HEAD + length, data + written, chunk);
+        length += chunk;
+        written += chunk;
+    }
+    return written;
+}
+
+void ChunkedPrint::flushChunk() {
+    if (length == 0) {
+        return;
+    }
+    // Fixed-width size with leading zeros, so the data never has to move
+    char head[CHUNK_HEAD + 1];
+    snprintf(head, sizeof(head), "%04x\r\n", (unsigned)length);
+    memcpy(buffer, head, CHUNK_HEAD);
+    buffer[CHUNK_HEAD + length] = '\r';
+    buffer[CHUNK_HEAD + length + 1] = '\n';
+    target.write(buffer, CHUNK_HEAD + length + 2);
+    length = 0;
+}
+
+void ChunkedPrint::finish() {
+    if (finished) {
+        return;
+    }
+    flushChunk();
+    target.write((const uint8_t*)"0\r\n\r\n", 5);
+    finished = true;
+}
+
+void printLine(Print& out, const char* format, ...) {
+    char line[PRINT_LINE_SIZE];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length > 0) {
+        out.write((const uint8_t*)line, min((size_t)length, sizeof(line) - 1));
+    }
+}
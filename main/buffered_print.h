@@ -0,0 +1,58 @@
+#ifndef BUFFERED_PRINT_H
+#define BUFFERED_PRINT_H
+
+#include <Arduino.h>
+
+#define BUFFERED_PRINT_SIZE 512
+#define PRINT_LINE_SIZE     160
+
+// Collects small writes (e.g. from serializeJson) into a fixed stack buffer
+// and forwards them to the target in large blocks, so a socket sees a few
+// full segments instead of one write per character.
+class BufferedPrint : public Print {
+public:
+    explicit BufferedPrint(Print& target);
+    ~BufferedPrint();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+
+    // Send whatever is buffered to the target
+    void flushBuffer();
+
+private:
+    Print& target;
+    uint8_t buffer[BUFFERED_PRINT_SIZE];
+    size_t length;
+};
+
+// HTTP/1.1 chunked transfer encoding, for bodies whose length is not known
+// up front. Writes are collected like BufferedPrint and each full buffer
+// goes out as one chunk; finish() (or the destructor) sends the last one.
+class ChunkedPrint : public Print {
+public:
+    explicit ChunkedPrint(Print& target);
+    ~ChunkedPrint();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    using Print::write;
+
+    void finish();
+
+private:
+    Print& target;
+    // "hhhh\r\n" + data + "\r\n", sent with a single write
+    uint8_t buffer[6 + BUFFERED_PRINT_SIZE + 2];
+    size_t length;
+    bool finished;
+
+    void flushChunk();
+};
+
+// printf into a stack buffer; Print::printf() falls back to the heap for
+// lines over 64 bytes. Output is cut at PRINT_LINE_SIZE - 1 characters.
+void printLine(Print& out, const char* format, ...);
+
+#endif // BUFFERED_PRINT_H
@@ -0,0 +1,248 @@
+#include "connection.h"
+#include "logging.h"
+#include "status.h"
+#include "entities.h"
+#include "hass.h"
+#include "warmstart.h"
+#include <ESPmDNS.h>
+
+static LinkStats wifiStats;
+static LinkStats hassStats;
+
+// Written from the WiFi event task, read from loop()
+static volatile bool wifiUp = false;
+static volatile bool wifiLost = false;
+
+static void onWifiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            wifiUp = true;
+            break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+        case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+            wifiUp = false;
+            wifiLost = true;
+            break;
+        default:
+            break;
+    }
+}
+
+unsigned long backoffDelay(uint32_t attempt, unsigned long base, unsigned long cap, uint32_t random) {
+    unsigned long delay = cap;
+    if (attempt < 16 && (base << attempt) < cap) {
+        delay = base << attempt;
+    }
+    return delay / 2 + random % (delay / 2 + 1);
+}
+
+static void enterState(LinkStats& stats, LinkState state, unsigned long now) {
+    stats.state = state;
+    stats.stateSince = now;
+    notifyStatusChanged();
+}
+
+static void markUp(LinkStats& stats, unsigned long now) {
+    if (stats.totalAttempts > stats.attempts) {
+        // Not the first connection since boot
+        stats.reconnects++;
+        stats.lastOutage = now - stats.downSince;
+        stats.totalOutage += stats.lastOutage;
+    }
+    stats.attempts = 0;
+    enterState(stats, LINK_UP, now);
+}
+
+static void markDown(LinkStats& stats, unsigned long now) {
+    stats.downSince = now;
+    enterState(stats, LINK_DOWN, now);
+}
+
+static void scheduleRetry(LinkStats& stats, unsigned long now, unsigned long base, unsigned long cap) {
+    unsigned long wait = backoffDelay(stats.attempts, base, cap, esp_random());
+    stats.nextAttemptAt = now + wait;
+    enterState(stats, LINK_BACKOFF, now);
+    logInfo("Retrying in %lu ms (attempt %lu)", wait, (unsigned long)stats.attempts + 1);
+}
+
+static void startAttempt(LinkStats& stats, unsigned long now) {
+    stats.attempts++;
+    stats.totalAttempts++;
+    enterState(stats, LINK_CONNECTING, now);
+}
+
+// --- WiFi ---
+
+static void startWifiAttempt(unsigned long now) {
+    // The first attempt after boot goes straight to the last access point,
+    // skipping the scan; later ones scan as usual
+    uint8_t channel;
+    uint8_t bssid[6];
+    bool hinted = wifiStats.totalAttempts == 0 && getWifiHint(channel, bssid);
+
+    logInfo("Connecting to WiFi %s%s...", WIFI_SSID, hinted ? " (last channel and BSSID)" : "");
+    startAttempt(wifiStats, now);
+    wifiLost = false;
+    if (hinted) {
+        WiFi.begin(WIFI_SSID, WIFI_PASSWORD, channel, bssid);
+    } else {
+        WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+    }
+}
+
+static void onWifiConnected(unsigned long now) {
+    markUp(wifiStats, now);
+    wifiLastConnectAttempt = now;
+    wifi_connected = true;
+    IPAddress ip = WiFi.localIP();
+    logInfo("WiFi connected! IP address: %u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+    if (wifiStats.reconnects > 0) {
+        logInfo("WiFi was down for %lu ms", wifiStats.lastOutage);
+    }
+
+    if (!MDNS.begin("charger")) {
+        logError("Error starting mDNS");
+    } else {
+        logInfo("mDNS responder started: charger.local");
+    }
+}
+
+static void onWifiLost(unsigned long now) {
+    logWarning("WiFi disconnected");
+    wifi_connected = false;
+    markDown(wifiStats, now);
+}
+
+static void loopWifi(unsigned long now) {
+    switch (wifiStats.state) {
+        case LINK_DOWN:
+            startWifiAttempt(now);
+            break;
+        case LINK_CONNECTING:
+            if (wifiUp) {
+                onWifiConnected(now);
+            } else if (wifiLost || now - wifiStats.stateSince >= WIFI_CONNECT_TIMEOUT) {
+                logWarning("WiFi attempt failed");
+                WiFi.disconnect();
+                scheduleRetry(wifiStats, now, WIFI_BACKOFF_BASE, WIFI_BACKOFF_MAX);
+            }
+            break;
+        case LINK_UP:
+            if (!wifiUp) {
+                onWifiLost(now);
+            }
+            break;
+        case LINK_BACKOFF:
+            if ((long)(now - wifiStats.nextAttemptAt) >= 0) {
+                startWifiAttempt(now);
+            }
+            break;
+    }
+}
+
+// --- Home Assistant ---
+
+static void onHassLost(unsigned long now) {
+    logWarning("Websocket disconnected");
+    ws_connected = false;
+    resetEntityStates();
+    endStaleStates();
+    markDown(hassStats, now);
+}
+
+static void startHassAttempt(unsigned long now) {
+    logInfo("Websocket connecting");
+    startAttempt(hassStats, now);
+    // connectHass() blocks for the TCP and WebSocket handshake; a refused or
+    // unreachable host fails here and goes straight to backoff
+    if (!connectHass()) {
+        logWarning("Websocket connection failed");
+        scheduleRetry(hassStats, millis(), HASS_BACKOFF_BASE, HASS_BACKOFF_MAX);
+    }
+}
+
+static void loopHassLink(unsigned long now) {
+    if (wifiStats.state != LINK_UP) {
+        if (hassStats.state == LINK_UP) {
+            client.close();
+            onHassLost(now);
+        } else if (hassStats.state != LINK_DOWN) {
+            if (hassStats.state == LINK_CONNECTING) {
+                // The handshake may already have opened the socket; the next
+                // attempt would otherwise start on top of it
+                client.close();
+                ws_connected = false;
+            }
+            enterState(hassStats, LINK_DOWN, now);
+        }
+        return;
+    }
+
+    switch (hassStats.state) {
+        case LINK_DOWN:
+            startHassAttempt(now);
+            break;
+        case LINK_CONNECTING:
+            if (ws_connected) {
+                markUp(hassStats, now);
+                if (hassStats.reconnects > 0) {
+                    logInfo("Websocket was down for %lu ms", hassStats.lastOutage);
+                }
+            } else if (now - hassStats.stateSince >= HASS_CONNECT_TIMEOUT) {
+                logWarning("Websocket connection timed out");
+                client.close();
+                scheduleRetry(hassStats, now, HASS_BACKOFF_BASE, HASS_BACKOFF_MAX);
+            }
+            break;
+        case LINK_UP:
+            if (!ws_connected) {
+                onHassLost(now);
+                // Retry soon, but still through the backoff so a server that
+                // accepts and drops connections is not hammered
+                scheduleRetry(hassStats, now, HASS_BACKOFF_BASE, HASS_BACKOFF_MAX);
+            }
+            break;
+        case LINK_BACKOFF:
+            if ((long)(now - hassStats.nextAttemptAt) >= 0) {
+                startHassAttempt(now);
+            }
+            break;
+    }
+}
+
+// --- Public ---
+
+void setupConnection() {
+    memset(&wifiStats, 0, sizeof(wifiStats));
+    memset(&hassStats, 0, sizeof(hassStats));
+
+    WiFi.onEvent(onWifiEvent);
+    WiFi.mode(WIFI_STA);
+    WiFi.setHostname("charger");
+    // Retries are scheduled here, with backoff
+    WiFi.setAutoReconnect(false);
+}
+
+void loopConnection() {
+    unsigned long now = millis();
+    loopWifi(now);
+    loopHassLink(now);
+}
+
+const LinkStats& getWifiStats() {
+    return wifiStats;
+}
+
+const LinkStats& getHassStats() {
+    return hassStats;
+}
+
+const char* linkStateName(LinkState state) {
+    switch (state) {
+        case LINK_DOWN: return "down";
+        case LINK_CONNECTING: return "connecting";
+        case LINK_UP: return "up";
+        case LINK_BACKOFF: return "backoff";
+    }
+    return "unknown";
+}
@@ -0,0 +1,50 @@
+#ifndef CONNECTION_H
+#define CONNECTION_H
+
+#include "declarations.h"
+
+// --- Connection Manager ---
+// Non-blocking state machines for the WiFi link and the Home Assistant
+// WebSocket. WiFi changes arrive as events; retries are scheduled on millis()
+// deadlines with jittered exponential backoff, so loop() keeps rendering and
+// serving HTTP while a link is down.
+
+#define WIFI_CONNECT_TIMEOUT 20000 // Give up on one WiFi attempt after this (ms)
+#define WIFI_BACKOFF_BASE    1000
+#define WIFI_BACKOFF_MAX     60000
+#define HASS_CONNECT_TIMEOUT 10000 // Wait this long for the socket to open (ms)
+#define HASS_BACKOFF_BASE    1000
+#define HASS_BACKOFF_MAX     30000
+
+enum LinkState {
+    LINK_DOWN,       // Not started, or waiting for the link it depends on
+    LINK_CONNECTING,
+    LINK_UP,
+    LINK_BACKOFF     // Waiting for nextAttemptAt
+};
+
+struct LinkStats {
+    LinkState state;
+    unsigned long stateSince;    // millis() when 'state' was entered
+    unsigned long downSince;     // millis() when the link was last lost
+    unsigned long nextAttemptAt; // Only meaningful in LINK_BACKOFF
+    uint32_t attempts;           // Attempts in the current outage
+    uint32_t totalAttempts;
+    uint32_t reconnects;         // Times the link came back after being up
+    unsigned long lastOutage;    // Time it took to reconnect last time (ms)
+    unsigned long totalOutage;
+};
+
+void setupConnection();
+void loopConnection();
+
+const LinkStats& getWifiStats();
+const LinkStats& getHassStats();
+const char* linkStateName(LinkState state);
+
+// Delay before retry number 'attempt' (0 based): base * 2^attempt capped at
+// 'cap', then spread over [delay / 2, delay] by 'random' so devices that lost
+// the same access point do not retry in lockstep.
+unsigned long backoffDelay(uint32_t attempt, unsigned long base, unsigned long cap, uint32_t random);
+
+#endif // CONNECTION_H
@@ -5,27 +5,40 @@
 #include <Arduino.h>
 #include <Adafruit_NeoPixel.h>
 #include <WiFi.h>
-#include <HTTPClient.h>
 #include <ArduinoWebsockets.h>
 #include <ArduinoJson.h>
 #include <WiFiUdp.h>
-#include <NTPClient.h>
 #include "secrets.h"
+#include "ntp_clock.h"
+#include "geometry.h"
 
 // --- Namespaces ---
 using namespace websockets;
 
 // --- LED Matrix Settings ---
+// One 8x8 panel. A 16x16 panel is <16, 16, 1, ...>, a strip of four 8x8
+// panels is <8, 8, 4, ...>; see geometry.h. Width must be a multiple of 4
+// and height a multiple of 8 (one bike slot per 4x8 tile), at most 256 LEDs
+// in all (FRAME_MAX_PIXELS).
+typedef MatrixGeometry<8, 8, 1, WIRING_ROW_MAJOR, ROTATE_0> DisplayGeometry;
+
 #define LED_PIN      23
-#define MATRIX_WIDTH 8
-#define MATRIX_HEIGHT 8
+#define MATRIX_WIDTH  (DisplayGeometry::WIDTH)
+#define MATRIX_HEIGHT (DisplayGeometry::HEIGHT)
 #define BUZZER_PIN    13
 // #define LED_BUILTIN   2
-#define LED_COUNT    (MATRIX_WIDTH * MATRIX_HEIGHT)
+#define LED_COUNT    (DisplayGeometry::COUNT)
 #define HTTP_PORT    80
 
 // --- Logging ---
-#define LOG_BUFFER_SIZE 30
+#define LOG_BUFFER_SIZE  30
+#define LOG_MESSAGE_SIZE 96
+#define LOG_LINE_SIZE    (LOG_MESSAGE_SIZE + 20) // "HH:MM:SS WARNING: " + message
+#define LOG_SHIP_MTU           1400  // UDP payload per datagram
+#define LOG_SHIP_INTERVAL      2000  // Ship at least this often when lines are pending (ms)
+#define LOG_SHIP_BATCH_LINES   10    // ...or as soon as this many lines are pending
+#define LOG_SHIP_MAX_DATAGRAMS 4     // Per loop pass, to bound the time spent
+#define LOG_SHIP_RESOLVE_RETRY 60000 // Retry resolving LOG_UDP_IP after a failure (ms)
 
 // --- Enum for colors ---
 enum Color {
@@ -39,6 +52,48 @@ enum Color {
     MAGENTA
 };
 
+// --- Entities ---
+#define MAX_ENTITIES 16
+
+// Interned HA states, the renderer switches on these instead of strings
+enum EntityState : uint8_t {
+    STATE_UNKNOWN = 0,
+    STATE_CHARGING,
+    STATE_DISCONNECTED,
+    STATE_OFF,
+    STATE_ON,
+    STATE_UNAVAILABLE,
+    STATE_OTHER, // Any state string not listed above
+    STATE_COUNT
+};
+
+enum SoundProfile : uint8_t {
+    SOUND_NONE = 0,
+    SOUND_STATE_CHANGE, // playSound() on every change
+    SOUND_ON_OFF        // 3 short beeps for "on", 1 long beep otherwise
+};
+
+struct EntityBinding {
+    const char* entityId;
+    int8_t slot;        // Display slot (bike) or -1 when not drawn
+    SoundProfile sound;
+};
+
+// --- Log entries ---
+enum LogLevel : uint8_t {
+    LOG_DEBUG = 0,
+    LOG_INFO,
+    LOG_WARNING,
+    LOG_ERROR
+};
+
+// Stored raw; text is only formatted when a reader asks for it (formatLogEntry)
+struct LogEntry {
+    uint32_t timestamp; // NTP epoch seconds
+    LogLevel level;
+    char message[LOG_MESSAGE_SIZE];
+};
+
 // --- Extern Global Variables ---
 // By declaring these as 'extern', we tell other .cpp files that these variables exist somewhere else (in main.ino).
 // This allows them to be shared across files.
@@ -51,14 +106,18 @@ extern bool ota_in_progress;
 extern Adafruit_NeoPixel strip;
 extern uint8_t displayBrightness;
 extern uint8_t displayArray[MATRIX_HEIGHT][MATRIX_WIDTH];
+extern unsigned long framesComposed;
+extern unsigned long framesShown;
+extern unsigned long keyframesShown;
 
 // Home Assistant
 extern WebsocketsClient client;
 extern int hass_message_id;
-extern char sensor_1_state[16];
-extern char sensor_2_state[16];
-extern char sensor_3_state[16];
+extern const EntityBinding entityBindings[];
+extern const uint8_t entityCount;
+extern EntityState entityStates[MAX_ENTITIES]; // Indexed like entityBindings
 extern bool ws_connected;
+extern bool statesStale; // entityStates come from the warm-start cache, not yet confirmed by HA
 
 // WiFi
 extern WiFiUDP udp;
@@ -72,19 +131,21 @@ extern int highlightIndex;
 extern int highlightX;
 extern int highlightY;
 extern bool should_render;
-extern unsigned long lastUpdate;
 extern const unsigned long interval;
 
 // Logging
-extern char logBuffer[LOG_BUFFER_SIZE][100];
+extern LogEntry logBuffer[LOG_BUFFER_SIZE]; // Ring, entry 'seq' lives at (seq - 1) % LOG_BUFFER_SIZE
+extern unsigned long logSequence;           // Sequence number of the newest entry, 0 when empty
+extern LogLevel logRuntimeLevel;            // Entries below this level are skipped
+extern unsigned long logLinesShipped;
+extern unsigned long logLinesDropped;
 
 // NTP
-extern NTPClient timeClient;
+extern NtpClock timeClient;
 
 // --- Function Prototypes for main.ino ---
 // Functions that are in main.ino but called from other files
 void playSound(int beeps = 2, int delayBetweenBeep = 50, int duration = 100);
-void connectToWifi();
 
 
 #endif // DECLARATIONS_H
@@ -1,141 +1,240 @@
 #include "display.h"
 #include "logging.h"
 #include "declarations.h"
+#include "frame_codec.h"
+#include "perf.h"
+#include "render.h"
+#include "sprites.h"
+#include "sync.h"
 
 // This function will be called from the main setup()
 void setupDisplay() {
     strip.begin();
-    strip.setBrightness(displayBrightness);
+    // Brightness is applied by outputLut, the strip itself stays at full scale
+    strip.setBrightness(255);
+    setDisplayBrightness(displayBrightness);
     strip.show(); // Initialize all pixels to 'off'
 }
 
-void createArray8x8() {
-    for (int i = 0; i < MATRIX_HEIGHT; i++) {
-        for (int j = 0; j < MATRIX_WIDTH; j++) {
-            displayArray[i][j] = BLACK;
-        }
-    }
+void clearDisplayArray() {
+    memset(displayArray, BLACK, sizeof(displayArray));
 }
 
-void getNextBorderPoint() {
-    const int SIZE = 8;
-    const int BORDER_POINTS = (SIZE * 4) - 4;
-    int i = highlightIndex;
-
-    if (i < SIZE) {
-        highlightX = i;
-        highlightY = 0;
-    } else if (i < SIZE + SIZE - 1) {
-        highlightX = SIZE - 1;
-        highlightY = i - (SIZE - 1);
-    } else if (i < SIZE + SIZE - 1 + SIZE - 1) {
-        highlightX = (SIZE - 1) - (i - (2 * SIZE - 2));
-        highlightY = SIZE - 1;
-    } else {
-        highlightX = 0;
-        highlightY = (SIZE - 1) - (i - (3 * SIZE - 3));
-    }
+// --- Geometry Tables ---
+// Built at compile time from DisplayGeometry, stored in flash
+static constexpr PixelMap<DisplayGeometry> PIXEL_MAP = buildPixelMap<DisplayGeometry>();
+static constexpr BorderWalk<DisplayGeometry> BORDER_WALK = buildBorderWalk<DisplayGeometry>();
+
+#define CHARGING_ROWS (TILE_HEIGHT - 2)
 
-    highlightIndex = (highlightIndex + 1) % BORDER_POINTS;
+void setLookStep(uint32_t step) {
+    chargingRow = 1 + step % CHARGING_ROWS;
+    highlightIndex = step % DisplayGeometry::BORDER_POINTS;
+    getNextBorderPoint();
 }
 
-void updateItem(int row, int col, Color color) {
-    if (row >= 0 && row < MATRIX_HEIGHT && col >= 0 && col < MATRIX_WIDTH) {
-        displayArray[row][col] = color;
-    }
+void getNextBorderPoint() {
+    const BorderPoint& point = BORDER_WALK.points[highlightIndex];
+    highlightX = point.x;
+    highlightY = point.y;
+
+    highlightIndex = (highlightIndex + 1) % DisplayGeometry::BORDER_POINTS;
 }
 
-void drawBorder() {
-    updateItem(0, 1, CYAN);
-    updateItem(0, 2, CYAN);
-    updateItem(7, 1, CYAN);
-    updateItem(7, 2, CYAN);
-    updateItem(0, 5, MAGENTA);
-    updateItem(0, 6, MAGENTA);
-    updateItem(7, 5, MAGENTA);
-    updateItem(7, 6, MAGENTA);
-
-    for (int i = 0; i < 8; i++) {
-        updateItem(i, 0, CYAN);
-        updateItem(i, 3, CYAN);
-        updateItem(i, 4, MAGENTA);
-        updateItem(i, 7, MAGENTA);
-    }
+int getPixelIndex(int row, int col) {
+    return PIXEL_MAP.index[row][col];
 }
 
-void state_unknown(int bike, int row) {
-    int colStart = (bike == 1) ? 0 : 4;
-    int rowStart = (row % 2 == 0) ? 2 : 3;
-    updateItem(rowStart, colStart + 1, RED);
-    updateItem(rowStart, colStart + 2, RED);
+// --- Looks ---
+// Every look is sprite data (see sprites.h); composeLook() paints them onto
+// a tile canvas, one tile per bike slot.
 
-    updateItem(rowStart + 2, colStart + 1, RED);
-    updateItem(rowStart + 2, colStart + 2, RED);
-}
+static_assert(BLACK == 0 && WHITE == 1 && RED == 2 && GREEN == 3 && BLUE == 4 &&
+              YELLOW == 5 && CYAN == 6 && MAGENTA == 7, "Sprite colors follow enum Color");
 
-void state_charging(int bike, int row) {
-    int colStart = (bike == 1) ? 0 : 4;
-    updateItem(row, colStart + 1, BLUE);
-    updateItem(row, colStart + 2, BLUE);
-}
+#define LOOK_TILES_X (MATRIX_WIDTH / TILE_WIDTH)
+#define LOOK_TILES_Y (MATRIX_HEIGHT / TILE_HEIGHT)
+#define LOOK_TILES   (LOOK_TILES_X * LOOK_TILES_Y)
 
-void state_disconnected(int bike, int row) {
-    int colStart = (bike == 1) ? 0 : 4;
-    for (int i = 1; i < 7; i++) {
-        int col = ((i + row) % 2 == 0) ? 1 : 2;
-        updateItem(i, colStart + col, YELLOW);
-    }
+static_assert(MATRIX_WIDTH % TILE_WIDTH == 0 && MATRIX_HEIGHT % TILE_HEIGHT == 0,
+              "The display must be a whole number of 4x8 bike tiles");
+static_assert(LOOK_TILES_X >= 2, "The no-link looks are two tiles wide");
+
+// Binary frames carry the size and the highlight in one byte each
+// (frame_codec.h), and decoders hold at most FRAME_MAX_PIXELS
+static_assert(LED_COUNT <= FRAME_MAX_PIXELS && MATRIX_WIDTH <= 255 && MATRIX_HEIGHT <= 255,
+              "The display does not fit the binary frame format");
+
+// Frame around each bike slot, alternating colors
+static constexpr Sprite<1> BORDER[2] = {
+    sprite("CCCC"
+           "C..C"
+           "C..C"
+           "C..C"
+           "C..C"
+           "C..C"
+           "C..C"
+           "CCCC"),
+    sprite("MMMM"
+           "M..M"
+           "M..M"
+           "M..M"
+           "M..M"
+           "M..M"
+           "M..M"
+           "MMMM")
+};
+
+// Moved down to the current row
+static constexpr Sprite<1> CHARGING = sprite(
+    ".BB."
+    "...."
+    "...."
+    "...."
+    "...."
+    "...."
+    "...."
+    "....");
+
+// Moved down by 2 or 3 rows, alternating
+static constexpr Sprite<1> UNKNOWN = sprite(
+    ".RR."
+    "...."
+    ".RR."
+    "...."
+    "...."
+    "...."
+    "...."
+    "....");
+
+// Indexed by row parity
+static constexpr Sprite<1> DISCONNECTED[2] = {
+    sprite("...."
+           "..Y."
+           ".Y.."
+           "..Y."
+           ".Y.."
+           "..Y."
+           ".Y.."
+           "...."),
+    sprite("...."
+           ".Y.."
+           "..Y."
+           ".Y.."
+           "..Y."
+           ".Y.."
+           "..Y."
+           "....")
+};
+
+// Signal bars, with a blinking corner indexed by row parity. Drawn on the
+// top row of tiles, centered.
+static constexpr Sprite<2> NO_WIFI = sprite(
+    "........"
+    "......R."
+    "......R."
+    "....R.R."
+    "....R.R."
+    "..R.R.R."
+    "..R.R.R."
+    "R.R.R.R.");
+static constexpr Sprite<1> NO_WIFI_CORNER[2] = {
+    sprite("B..." "...." "...." "...." "...." "...." "...." "...."),
+    sprite("R..." "...." "...." "...." "...." "...." "...." "....")
+};
+
+static constexpr Sprite<2> NO_HASS = sprite(
+    "........"
+    "......B."
+    "......B."
+    "....B.B."
+    "....B.B."
+    "..B.B.B."
+    "..B.B.B."
+    "B.B.B.B.");
+static constexpr Sprite<1> NO_HASS_CORNER[2] = {
+    sprite("G..." "...." "...." "...." "...." "...." "...." "...."),
+    sprite("Y..." "...." "...." "...." "...." "...." "...." "....")
+};
+
+// Used while OTA is in progress (currently disabled)
+static constexpr Sprite<2> OTA_IN_PROGRESS = sprite(
+    "Y.Y.Y.Y."
+    ".Y.Y.Y.Y"
+    "Y.Y.Y.Y."
+    ".Y.Y.Y.Y"
+    "Y.Y.Y.Y."
+    ".Y.Y.Y.Y"
+    "Y.Y.Y.Y."
+    ".Y.Y.Y.Y");
+
+// Bike slots fill the tiles left to right, then top to bottom; slots past
+// the last tile are not drawn
+static Tile* slotTile(Tile* canvas, int slot) {
+    return slot < LOOK_TILES ? &canvas[slot] : nullptr;
 }
 
-void noWifi(int row) {
-    Color pixelColor = (row % 2 == 0) ? BLUE : RED;
-    updateItem(0, 0, pixelColor);
-    
-    for (int r = 1; r < 8; r += 2) {
-        for (int c = r; c < 8; c++) {
-            updateItem(c, (7 - r), RED);
-        }
+static void paintEntity(Tile& tile, EntityState state, int row) {
+    switch (state) {
+        case STATE_CHARGING:
+            paintTile(tile, CHARGING.tiles[0], row);
+            break;
+        case STATE_DISCONNECTED:
+            paintTile(tile, DISCONNECTED[row % 2].tiles[0]);
+            break;
+        case STATE_UNKNOWN:
+            paintTile(tile, UNKNOWN.tiles[0], (row % 2 == 0) ? 2 : 3);
+            break;
+        default:
+            break;
     }
 }
 
-void noHass(int row) {
-    Color pixelColor = (row % 2 == 0) ? GREEN : YELLOW;
-    updateItem(0, 0, pixelColor);
-    
-    for (int r = 1; r < 8; r += 2) {
-        for (int c = r; c < 8; c++) {
-            updateItem(c, (7 - r), BLUE);
-        }
-    }
+// --- Color Lookup Table ---
+// Pack R, G, B the same way strip.Color() does, but usable at compile time.
+static constexpr uint32_t rgb(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
 }
 
-void otaInProgress() {
-    for (int y = 0; y < 8; y++) {
-        for (int x = 0; x < 8; x++) {
-            if ((x + y) % 2 == 0) {
-                updateItem(x, y, YELLOW);
-            }
-        }
-    }
+// Compile-time copy of highlightBrightness(): brighter by a fixed step, clamped at 255.
+static constexpr uint8_t highlightTone(uint8_t tone) {
+    return tone > 255 - 50 ? 255 : (uint8_t)(tone + 50);
 }
 
-int getPixelIndex(int row, int col) {
-    // Simplified from serpentine layout to standard left-to-right wiring to fix pixel scrambling.
-    return (row * MATRIX_WIDTH) + col;
+static constexpr uint32_t highlightRgb(uint8_t r, uint8_t g, uint8_t b) {
+    return rgb(highlightTone(r), highlightTone(g), highlightTone(b));
 }
 
+#define PALETTE_SIZE 8
+enum ColorVariant { VARIANT_NORMAL = 0, VARIANT_HIGHLIGHT, VARIANT_COUNT };
+
+// Indexed by [variant][Color]. showFrame() applies gamma and displayBrightness on top.
+static const uint32_t COLOR_LUT[VARIANT_COUNT][PALETTE_SIZE] = {
+    {
+        rgb(0, 0, 0),         // BLACK
+        rgb(255, 255, 255),   // WHITE
+        rgb(255, 0, 0),       // RED
+        rgb(0, 255, 0),       // GREEN
+        rgb(0, 0, 255),       // BLUE
+        rgb(255, 255, 0),     // YELLOW
+        rgb(0, 255, 255),     // CYAN
+        rgb(255, 0, 255)      // MAGENTA
+    },
+    {
+        highlightRgb(0, 0, 0),
+        highlightRgb(255, 255, 255),
+        highlightRgb(255, 0, 0),
+        highlightRgb(0, 255, 0),
+        highlightRgb(0, 0, 255),
+        highlightRgb(255, 255, 0),
+        highlightRgb(0, 255, 255),
+        highlightRgb(255, 0, 255)
+    }
+};
+
 uint8_t highlightBrightness(uint8_t tone) {
     // Add a fixed value to each color component to make it visibly brighter.
-    const uint8_t brightness_increase = 50;
-    //uint16_t new_tone = tone + brightness_increase;
-    uint16_t new_tone = tone - brightness_increase;
-    if (new_tone > 255) {
-        new_tone = 255;
-    }
-    if (new_tone < 0) {
-        new_tone = 0;
-    }
-    return (uint8_t)new_tone;
+    return highlightTone(tone);
 }
 
 uint32_t highlightPixel(int row, int col, uint32_t rgbColor) {
@@ -156,85 +255,228 @@ uint32_t highlightPixel(int row, int col, uint32_t rgbColor) {
     return rgbColor;
 }
 
-uint32_t translateColor(Color colorValue) { 
-    switch (colorValue) {
-        case BLACK:   return strip.Color(0, 0, 0);
-        case WHITE:   return strip.Color(255, 255, 255);
-        case RED:     return strip.Color(255, 0, 0);
-        case GREEN:   return strip.Color(0, 255, 0);
-        case BLUE:    return strip.Color(0, 0, 255);
-        case YELLOW:  return strip.Color(255, 255, 0);
-        case CYAN:    return strip.Color(0, 255, 255);
-        case MAGENTA: return strip.Color(255, 0, 255);
-        default:     return strip.Color(0, 0, 0);
+uint32_t translateColor(Color colorValue) {
+    if ((unsigned)colorValue >= PALETTE_SIZE) {
+        return COLOR_LUT[VARIANT_NORMAL][BLACK];
     }
+    return COLOR_LUT[VARIANT_NORMAL][colorValue];
 }
 
-void drawMatrix() {
+uint32_t getDisplayColor(int row, int col) {
+    uint8_t colorValue = displayArray[row][col];
+    if (colorValue >= PALETTE_SIZE) {
+        colorValue = BLACK;
+    }
+    int variant = (row == highlightY && col == highlightX) ? VARIANT_HIGHLIGHT : VARIANT_NORMAL;
+    return COLOR_LUT[variant][colorValue];
+}
+
+// --- Output ---
+// Frames are composed in palette colors; on the way to the strip each
+// channel goes through outputLut, which folds gamma correction and the
+// display brightness into one lookup.
+
+// 255 * (i / 255) ^ 2.2
+static const uint8_t GAMMA_LUT[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255
+};
+
+static uint8_t outputLut[256];
+static uint8_t outputBrightness = 0;
+static bool outputLutValid = false;
+
+void setDisplayBrightness(uint8_t brightness) {
+    if (outputLutValid && brightness == outputBrightness) {
+        return;
+    }
+    for (int i = 0; i < 256; i++) {
+        outputLut[i] = (GAMMA_LUT[i] * (brightness + 1)) >> 8;
+    }
+    outputBrightness = brightness;
+    outputLutValid = true;
+}
+
+static uint32_t lastFrameFingerprint = 0;
+static bool frameValid = false;
+
+// FNV-1a over everything that ends up on the strip
+static uint32_t fingerprintFrame(const RgbFrame& frame) {
+    uint32_t hash = 2166136261UL;
+    const uint32_t* pixels = &frame[0][0];
+    for (int i = 0; i < LED_COUNT; i++) {
+        hash = (hash ^ pixels[i]) * 16777619UL;
+    }
+    hash = (hash ^ outputBrightness) * 16777619UL;
+    return hash;
+}
+
+uint32_t getFrameFingerprint() {
+    return lastFrameFingerprint;
+}
+
+void invalidateFrame() {
+    frameValid = false;
+}
+
+// Copy of the last frame pushed to the strip, for readers on the network task
+static SeqLock<ShownFrame> shownFrame;
+
+void readShownFrame(ShownFrame& frame) {
+    shownFrame.read(frame);
+}
+
+uint32_t getShownColor(const ShownFrame& frame, int row, int col) {
+    return frame.rgb[row][col];
+}
+
+size_t encodeDisplayFrame(uint8_t* out, size_t capacity, uint32_t frameNumber) {
+    ShownFrame frame;
+    readShownFrame(frame);
+    // Keyframes fit the palette and go out at half a byte per pixel
+    if (frame.keyframe) {
+        size_t length = encodeFramePalette4(&frame.look.cells[0][0], MATRIX_WIDTH, MATRIX_HEIGHT,
+                                            frame.look.highlightX, frame.look.highlightY, frameNumber,
+                                            out, capacity);
+        if (length > 0) {
+            return length;
+        }
+    }
+    return encodeFrameRleRgb(&frame.rgb[0][0], MATRIX_WIDTH, MATRIX_HEIGHT, frameNumber, out, capacity);
+}
+
+void lookToRgb(RgbFrame& frame) {
     for (int i = 0; i < MATRIX_HEIGHT; i++) {
         for (int j = 0; j < MATRIX_WIDTH; j++) {
-            int pixelIndex = getPixelIndex(i, j);
-            Color colorValue = (Color)displayArray[i][j];
-            uint32_t rgbColor = translateColor(colorValue);
+            frame[i][j] = getDisplayColor(i, j);
+        }
+    }
+}
 
-            rgbColor = highlightPixel(i, j, rgbColor);
-            strip.setPixelColor(pixelIndex, rgbColor);
+void captureLook(LookCells& look) {
+    memcpy(look.cells, displayArray, sizeof(look.cells));
+    look.highlightX = highlightX;
+    look.highlightY = highlightY;
+}
+
+void showFrame(const RgbFrame& frame, const LookCells* look) {
+    framesComposed++;
+
+    uint32_t fingerprint = fingerprintFrame(frame);
+    if (frameValid && fingerprint == lastFrameFingerprint) {
+        // Nothing changed, skip strip.show() and its interrupt-off window
+        return;
+    }
+
+    for (int i = 0; i < MATRIX_HEIGHT; i++) {
+        for (int j = 0; j < MATRIX_WIDTH; j++) {
+            uint32_t color = frame[i][j];
+            strip.setPixelColor(getPixelIndex(i, j),
+                                outputLut[(color >> 16) & 0xFF],
+                                outputLut[(color >> 8) & 0xFF],
+                                outputLut[color & 0xFF]);
         }
     }
     strip.show();
+
+    lastFrameFingerprint = fingerprint;
+    frameValid = true;
+
+    ShownFrame shown;
+    memcpy(shown.rgb, frame, sizeof(shown.rgb));
+    shown.keyframe = look != nullptr;
+    if (shown.keyframe) {
+        shown.look = *look;
+    }
+    shown.frameNumber = framesShown + 1;
+    shownFrame.write(shown);
+    framesShown++;
+    if (shown.keyframe) {
+        keyframesShown++;
+    }
 }
 
-void render_matrix() {
-    // Clean the display array
-    createArray8x8();
+void drawMatrix() {
+    LookCells look;
+    captureLook(look);
+    RgbFrame frame;
+    lookToRgb(frame);
+    showFrame(frame, &look);
+}
+
+void composeLook() {
+    PerfScope perf(PERF_COMPOSE);
+    Tile canvas[LOOK_TILES] = {};
+    Tile* linkTiles = &canvas[(LOOK_TILES_X - 2) / 2];
 
     // OTA DISABLED
     // if (ota_in_progress) {
-    //     otaInProgress();
+    //     paintSprite(linkTiles, OTA_IN_PROGRESS);
     // } else 
-    if (wifi_connected && ws_connected) {
-        drawBorder();
-
-        if (strcmp(sensor_1_state, "charging") == 0) {
-            state_charging(1, chargingRow);
-        } else if (strcmp(sensor_1_state, "disconnected") == 0) {
-            state_disconnected(1, chargingRow);
-        } else if (strcmp(sensor_1_state, "unknown") == 0) {
-            state_unknown(1, chargingRow);
+    const DisplayState& state = getRenderState();
+    if (state.statesStale || (state.wifiConnected && state.wsConnected)) {
+        // Cached states are drawn without the border, so only the highlight
+        // walks the edge until HA confirms them
+        for (int ty = 0; ty < LOOK_TILES_Y && !state.statesStale; ty++) {
+            for (int tx = 0; tx < LOOK_TILES_X; tx++) {
+                paintTile(canvas[ty * LOOK_TILES_X + tx], BORDER[(tx + ty) % 2].tiles[0]);
+            }
         }
 
-        if (strcmp(sensor_2_state, "charging") == 0) {
-            state_charging(2, chargingRow);
-        } else if (strcmp(sensor_2_state, "disconnected") == 0) {
-            state_disconnected(2, chargingRow);
-        } else if (strcmp(sensor_2_state, "unknown") == 0) {
-            state_unknown(2, chargingRow);
+        for (int i = 0; i < entityCount; i++) {
+            int8_t slot = entityBindings[i].slot;
+            Tile* tile = slot < 0 ? nullptr : slotTile(canvas, slot);
+            if (tile == nullptr) {
+                continue;
+            }
+            paintEntity(*tile, state.states[i], chargingRow);
         }
-    } else if (wifi_connected && !ws_connected) {
-        noHass(chargingRow);
+    } else if (state.wifiConnected) {
+        paintTile(linkTiles[0], NO_HASS_CORNER[chargingRow % 2].tiles[0]);
+        paintSprite(linkTiles, NO_HASS);
     } else {
-        noWifi(chargingRow);
+        paintTile(linkTiles[0], NO_WIFI_CORNER[chargingRow % 2].tiles[0]);
+        paintSprite(linkTiles, NO_WIFI);
     }
 
+    expandTiles(canvas, LOOK_TILES_X, LOOK_TILES_Y, &displayArray[0][0], MATRIX_WIDTH);
+}
+
+void render_matrix() {
+    composeLook();
     drawMatrix();
 }
 
 void clean_display() {
-    createArray8x8();
+    clearDisplayArray();
     strip.clear();
     strip.show();
-    logInfo(F("Display cleared"));
-}
-
-Color stringToColor(String colorName) {
-    colorName.toUpperCase();
-    if (colorName == "BLACK") return BLACK;
-    if (colorName == "WHITE") return WHITE;
-    if (colorName == "RED") return RED;
-    if (colorName == "GREEN") return GREEN;
-    if (colorName == "BLUE") return BLUE;
-    if (colorName == "YELLOW") return YELLOW;
-    if (colorName == "CYAN") return CYAN;
-    if (colorName == "MAGENTA") return MAGENTA;
+    invalidateFrame();
+    logInfo("Display cleared");
+}
+
+Color stringToColor(const char* colorName) {
+    if (strcasecmp(colorName, "BLACK") == 0) return BLACK;
+    if (strcasecmp(colorName, "WHITE") == 0) return WHITE;
+    if (strcasecmp(colorName, "RED") == 0) return RED;
+    if (strcasecmp(colorName, "GREEN") == 0) return GREEN;
+    if (strcasecmp(colorName, "BLUE") == 0) return BLUE;
+    if (strcasecmp(colorName, "YELLOW") == 0) return YELLOW;
+    if (strcasecmp(colorName, "CYAN") == 0) return CYAN;
+    if (strcasecmp(colorName, "MAGENTA") == 0) return MAGENTA;
     return BLACK; // Default to black if color not found
 }
@@ -3,35 +3,58 @@
 
 #include "declarations.h"
 
+// 0xRRGGBB per pixel, before gamma correction and brightness
+typedef uint32_t RgbFrame[MATRIX_HEIGHT][MATRIX_WIDTH];
+
+// A look in palette form: the Color of each cell and the highlighted one
+struct LookCells {
+    uint8_t cells[MATRIX_HEIGHT][MATRIX_WIDTH];
+    uint8_t highlightX;
+    uint8_t highlightY;
+};
+
+// Last frame pushed to the strip. Written by the render task, safe to read
+// from any task through readShownFrame().
+struct ShownFrame {
+    RgbFrame rgb;
+    LookCells look; // Only set for keyframes
+    bool keyframe;  // rgb is exactly look, not a blend
+    uint32_t frameNumber;
+};
+
 // --- Function Prototypes ---
 
 // Setup
 void setupDisplay();
 
 // Core Drawing
-void render_matrix();
+void render_matrix(); // composeLook() + drawMatrix(), without animation
+void composeLook();   // Draws the current state into displayArray
+void setLookStep(uint32_t step); // Positions chargingRow and the border highlight
+void lookToRgb(RgbFrame& frame);
+void captureLook(LookCells& look); // displayArray and the highlight, as composed
+// Pass the look when frame is that keyframe unblended
+void showFrame(const RgbFrame& frame, const LookCells* look = nullptr);
 void drawMatrix();
+void setDisplayBrightness(uint8_t brightness);
 void clean_display();
+void invalidateFrame();
+uint32_t getFrameFingerprint();
+size_t encodeDisplayFrame(uint8_t* out, size_t capacity, uint32_t frameNumber);
+void readShownFrame(ShownFrame& frame);
+uint32_t getShownColor(const ShownFrame& frame, int row, int col);
 
-// Drawing Primitives & Animations
+// Animations
 void getNextBorderPoint();
-void updateItem(int row, int col, Color color);
-void drawBorder();
-void noWifi(int row);
-void noHass(int row);
-
-// State-specific Patterns
-void state_unknown(int bike, int row);
-void state_charging(int bike, int row);
-void state_disconnected(int bike, int row);
 
 // Color & Pixel Utilities
 int getPixelIndex(int row, int col);
 uint8_t highlightBrightness(uint8_t tone);
 uint32_t highlightPixel(int row, int col, uint32_t rgbColor);
-Color stringToColor(String colorName);
-void createArray8x8();
+Color stringToColor(const char* colorName);
+void clearDisplayArray();
 uint32_t translateColor(Color colorValue);
+uint32_t getDisplayColor(int row, int col);
 
 
 #endif // DISPLAY_H
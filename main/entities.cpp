@@ -0,0 +1,124 @@
+#include "entities.h"
+#include "history.h"
+#include "status.h"
+
+#define ENTITY_INDEX_SIZE 32 // Power of two, at least twice MAX_ENTITIES
+
+static_assert(ENTITY_INDEX_SIZE >= 2 * MAX_ENTITIES, "Entity index too small");
+static_assert((ENTITY_INDEX_SIZE & (ENTITY_INDEX_SIZE - 1)) == 0, "Entity index size must be a power of two");
+
+struct EntityIndexSlot {
+    uint32_t hash;
+    int8_t index; // -1 when empty
+};
+static EntityIndexSlot entityIndex[ENTITY_INDEX_SIZE];
+
+// Same order as EntityState
+static const char* const STATE_NAMES[STATE_COUNT] = {
+    "unknown",
+    "charging",
+    "disconnected",
+    "off",
+    "on",
+    "unavailable",
+    "other"
+};
+
+static uint32_t hashEntityId(const char* entityId) {
+    uint32_t hash = 2166136261UL;
+    for (; *entityId != '\0'; entityId++) {
+        hash = (hash ^ (uint8_t)*entityId) * 16777619UL;
+    }
+    return hash;
+}
+
+void setupEntities() {
+    for (int i = 0; i < ENTITY_INDEX_SIZE; i++) {
+        entityIndex[i].index = -1;
+    }
+
+    for (int i = 0; i < entityCount; i++) {
+        uint32_t hash = hashEntityId(entityBindings[i].entityId);
+        uint32_t slot = hash & (ENTITY_INDEX_SIZE - 1);
+        while (entityIndex[slot].index != -1) {
+            slot = (slot + 1) & (ENTITY_INDEX_SIZE - 1);
+        }
+        entityIndex[slot].hash = hash;
+        entityIndex[slot].index = i;
+    }
+    resetEntityStates();
+}
+
+int findEntity(const char* entityId) {
+    if (entityId == nullptr) {
+        return -1;
+    }
+
+    uint32_t hash = hashEntityId(entityId);
+    uint32_t slot = hash & (ENTITY_INDEX_SIZE - 1);
+    while (entityIndex[slot].index != -1) {
+        const EntityIndexSlot& entry = entityIndex[slot];
+        if (entry.hash == hash && strcmp(entityBindings[entry.index].entityId, entityId) == 0) {
+            return entry.index;
+        }
+        slot = (slot + 1) & (ENTITY_INDEX_SIZE - 1);
+    }
+    return -1;
+}
+
+EntityState internState(const char* state) {
+    if (state == nullptr) {
+        return STATE_UNKNOWN;
+    }
+    // STATE_OTHER is the fallback, not a real HA state
+    for (int i = 0; i < STATE_OTHER; i++) {
+        if (strcasecmp(state, STATE_NAMES[i]) == 0) {
+            return (EntityState)i;
+        }
+    }
+    return STATE_OTHER;
+}
+
+const char* stateName(EntityState state) {
+    return state < STATE_COUNT ? STATE_NAMES[state] : STATE_NAMES[STATE_OTHER];
+}
+
+bool setEntityState(int index, EntityState state) {
+    if (index < 0 || index >= entityCount || entityStates[index] == state) {
+        return false;
+    }
+    entityStates[index] = state;
+    recordTransition(index, state);
+    notifyStatusChanged();
+    return true;
+}
+
+// Not a change of the chargers but of what we know about them, so nothing
+// goes into the history; it keeps the last state HA reported
+void resetEntityStates() {
+    bool changed = false;
+    for (int i = 0; i < entityCount; i++) {
+        changed = changed || entityStates[i] != STATE_UNKNOWN;
+        entityStates[i] = STATE_UNKNOWN;
+    }
+    if (changed) {
+        notifyStatusChanged();
+    }
+}
+
+void playEntitySound(int index, EntityState state) {
+    switch (entityBindings[index].sound) {
+        case SOUND_STATE_CHANGE:
+            playSound();
+            break;
+        case SOUND_ON_OFF:
+            if (state == STATE_ON) {
+                playSound(3, 50, 100);
+            } else {
+                playSound(1, 50, 300);
+            }
+            break;
+        default:
+            break;
+    }
+}
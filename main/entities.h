@@ -0,0 +1,26 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include "declarations.h"
+
+// --- Entity Registry ---
+// Maps HA entity ids from entityBindings[] to their index through a small
+// open-addressing hash table built once by setupEntities(), and interns
+// state strings into EntityState codes.
+
+void setupEntities();
+
+// Index into entityBindings[]/entityStates[], or -1 if the entity is not bound
+int findEntity(const char* entityId);
+
+EntityState internState(const char* state);
+const char* stateName(EntityState state);
+
+// Returns true when the state actually changed
+bool setEntityState(int index, EntityState state);
+void resetEntityStates();
+
+// Plays the binding's sound profile for a state it changed to
+void playEntitySound(int index, EntityState state);
+
+#endif // ENTITIES_H
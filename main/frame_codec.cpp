@@ -0,0 +1,120 @@
+#include "frame_codec.h"
+
+static void writeHeader(uint8_t* out, uint8_t format, uint32_t frameNumber, uint8_t width, uint8_t height) {
+    out[0] = format;
+    out[1] = frameNumber & 0xFF;
+    out[2] = (frameNumber >> 8) & 0xFF;
+    out[3] = (frameNumber >> 16) & 0xFF;
+    out[4] = (frameNumber >> 24) & 0xFF;
+    out[5] = width;
+    out[6] = height;
+}
+
+size_t encodeFramePalette4(const uint8_t* cells, uint8_t width, uint8_t height,
+                           uint8_t highlightX, uint8_t highlightY, uint32_t frameNumber,
+                           uint8_t* out, size_t capacity) {
+    size_t pixels = (size_t)width * height;
+    size_t length = FRAME_PALETTE4_SIZE(width, height);
+    if (pixels > FRAME_MAX_PIXELS || capacity < length) {
+        return 0;
+    }
+
+    writeHeader(out, FRAME_FORMAT_PALETTE4, frameNumber, width, height);
+    out[7] = highlightX;
+    out[8] = highlightY;
+
+    uint8_t* packed = out + FRAME_HEADER_SIZE + 2;
+    for (size_t i = 0; i < pixels; i += 2) {
+        uint8_t high = cells[i];
+        uint8_t low = (i + 1 < pixels) ? cells[i + 1] : 0;
+        if (high > 0x0F || low > 0x0F) {
+            return 0;
+        }
+        packed[i / 2] = (high << 4) | low;
+    }
+    return length;
+}
+
+size_t encodeFrameRleRgb(const uint32_t* rgb, uint8_t width, uint8_t height,
+                         uint32_t frameNumber, uint8_t* out, size_t capacity) {
+    size_t pixels = (size_t)width * height;
+    if (pixels > FRAME_MAX_PIXELS || capacity < FRAME_HEADER_SIZE) {
+        return 0;
+    }
+
+    writeHeader(out, FRAME_FORMAT_RLE_RGB, frameNumber, width, height);
+    size_t length = FRAME_HEADER_SIZE;
+
+    size_t i = 0;
+    while (i < pixels) {
+        uint32_t color = rgb[i] & 0xFFFFFF;
+        uint8_t run = 1;
+        while (i + run < pixels && run < 255 && (rgb[i + run] & 0xFFFFFF) == color) {
+            run++;
+        }
+        if (length + 4 > capacity) {
+            return 0;
+        }
+        out[length++] = run;
+        out[length++] = (color >> 16) & 0xFF;
+        out[length++] = (color >> 8) & 0xFF;
+        out[length++] = color & 0xFF;
+        i += run;
+    }
+    return length;
+}
+
+bool decodeFrame(const uint8_t* data, size_t length, DecodedFrame& frame) {
+    if (length < FRAME_HEADER_SIZE) {
+        return false;
+    }
+
+    frame.format = data[0];
+    frame.frameNumber = (uint32_t)data[1] | ((uint32_t)data[2] << 8) |
+                        ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 24);
+    frame.width = data[5];
+    frame.height = data[6];
+    frame.highlightX = FRAME_NO_HIGHLIGHT;
+    frame.highlightY = FRAME_NO_HIGHLIGHT;
+
+    size_t pixels = (size_t)frame.width * frame.height;
+    if (pixels > FRAME_MAX_PIXELS) {
+        return false;
+    }
+
+    if (frame.format == FRAME_FORMAT_PALETTE4) {
+        if (length < (size_t)FRAME_PALETTE4_SIZE(frame.width, frame.height)) {
+            return false;
+        }
+        frame.highlightX = data[7];
+        frame.highlightY = data[8];
+        const uint8_t* packed = data + FRAME_HEADER_SIZE + 2;
+        for (size_t i = 0; i < pixels; i++) {
+            uint8_t byte = packed[i / 2];
+            frame.index[i] = (i % 2 == 0) ? (byte >> 4) : (byte & 0x0F);
+        }
+        return true;
+    }
+
+    if (frame.format == FRAME_FORMAT_RLE_RGB) {
+        size_t pos = FRAME_HEADER_SIZE;
+        size_t i = 0;
+        while (i < pixels) {
+            if (pos + 4 > length || data[pos] == 0) {
+                return false;
+            }
+            uint8_t run = data[pos];
+            uint32_t color = ((uint32_t)data[pos + 1] << 16) | ((uint32_t)data[pos + 2] << 8) | data[pos + 3];
+            pos += 4;
+            if (i + run > pixels) {
+                return false;
+            }
+            for (uint8_t r = 0; r < run; r++) {
+                frame.rgb[i++] = color;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
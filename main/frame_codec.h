@@ -0,0 +1,58 @@
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// --- Binary Frame Format ---
+// Sent as WebSocket binary messages to subscribed clients.
+//
+//   [0]     format (FRAME_FORMAT_*)
+//   [1..4]  frame number, little endian
+//   [5]     width
+//   [6]     height
+//
+// FRAME_FORMAT_PALETTE4:
+//   [7]     highlight x (FRAME_NO_HIGHLIGHT if none)
+//   [8]     highlight y
+//   [9..]   palette indices, two pixels per byte, high nibble first, row-major
+//
+// FRAME_FORMAT_RLE_RGB:
+//   [7..]   runs of (count 1..255, r, g, b), row-major
+//
+// Keyframes go out as palette frames, 41 bytes for 8x8; blended frames are
+// not limited to the palette and go out as RLE.
+
+#define FRAME_FORMAT_PALETTE4 1
+#define FRAME_FORMAT_RLE_RGB  2
+#define FRAME_HEADER_SIZE     7
+#define FRAME_NO_HIGHLIGHT    0xFF
+#define FRAME_MAX_PIXELS      256
+
+struct DecodedFrame {
+    uint8_t format;
+    uint32_t frameNumber;
+    uint8_t width;
+    uint8_t height;
+    uint8_t highlightX;
+    uint8_t highlightY;
+    uint8_t index[FRAME_MAX_PIXELS]; // FRAME_FORMAT_PALETTE4 only
+    uint32_t rgb[FRAME_MAX_PIXELS];  // FRAME_FORMAT_RLE_RGB only
+};
+
+// Upper bounds on the encoded size, to size output buffers
+#define FRAME_PALETTE4_SIZE(w, h) (FRAME_HEADER_SIZE + 2 + ((w) * (h) + 1) / 2)
+#define FRAME_RLE_RGB_MAX_SIZE(w, h) (FRAME_HEADER_SIZE + (w) * (h) * 4)
+
+// Each encoder returns the encoded length, or 0 when 'capacity' is too small
+// or a palette index does not fit in 4 bits.
+size_t encodeFramePalette4(const uint8_t* cells, uint8_t width, uint8_t height,
+                           uint8_t highlightX, uint8_t highlightY, uint32_t frameNumber,
+                           uint8_t* out, size_t capacity);
+size_t encodeFrameRleRgb(const uint32_t* rgb, uint8_t width, uint8_t height,
+                         uint32_t frameNumber, uint8_t* out, size_t capacity);
+
+// Returns false on malformed or truncated input
+bool decodeFrame(const uint8_t* data, size_t length, DecodedFrame& frame);
+
+#endif // FRAME_CODEC_H
@@ -0,0 +1,113 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <stdint.h>
+
+// --- Display Geometry ---
+// Maps logical pixels (row 0 at the top, column 0 on the left) to positions
+// on the LED chain. The display is CHAIN identical panels of PANEL_W x
+// PANEL_H LEDs, chained left to right. Each panel is wired row-major or
+// serpentine (every other row reversed) as seen in its own orientation,
+// and mounted rotated clockwise by ROTATION.
+//
+// Everything is computed at compile time: PixelMap and BorderWalk are
+// constexpr tables, so mapping a pixel is one lookup without branches.
+//
+// No Arduino dependencies, so this header compiles on the host as well.
+
+enum PanelWiring {
+    WIRING_ROW_MAJOR,
+    WIRING_SERPENTINE
+};
+
+enum PanelRotation {
+    ROTATE_0,
+    ROTATE_90,
+    ROTATE_180,
+    ROTATE_270
+};
+
+template <int PANEL_W, int PANEL_H, int CHAIN, PanelWiring WIRING, PanelRotation ROTATION>
+struct MatrixGeometry {
+    static_assert(PANEL_W >= 2 && PANEL_H >= 2 && CHAIN >= 1, "Panels need at least 2x2 LEDs");
+
+    static constexpr bool TURNED = ROTATION == ROTATE_90 || ROTATION == ROTATE_270;
+    static constexpr int PANEL_COLS = TURNED ? PANEL_H : PANEL_W; // Logical width of one panel
+    static constexpr int WIDTH = PANEL_COLS * CHAIN;
+    static constexpr int HEIGHT = TURNED ? PANEL_W : PANEL_H;
+    static constexpr int COUNT = WIDTH * HEIGHT;
+    static constexpr int BORDER_POINTS = 2 * WIDTH + 2 * HEIGHT - 4;
+
+    static_assert(COUNT <= 65535, "LED index must fit 16 bits");
+    static_assert(WIDTH <= 255 && HEIGHT <= 255, "BorderPoint coordinates must fit 8 bits");
+
+    // Position on the chain; used to build PixelMap, not at runtime
+    static constexpr uint16_t ledIndex(int row, int col) {
+        int panel = col / PANEL_COLS;
+        int r = row;
+        int c = col % PANEL_COLS;
+
+        // Logical position inside the panel -> the panel's own row and column
+        int pr = ROTATION == ROTATE_0   ? r :
+                 ROTATION == ROTATE_90  ? PANEL_H - 1 - c :
+                 ROTATION == ROTATE_180 ? PANEL_H - 1 - r :
+                                          c;
+        int pc = ROTATION == ROTATE_0   ? c :
+                 ROTATION == ROTATE_90  ? r :
+                 ROTATION == ROTATE_180 ? PANEL_W - 1 - c :
+                                          PANEL_W - 1 - r;
+
+        if (WIRING == WIRING_SERPENTINE && pr % 2 == 1) {
+            pc = PANEL_W - 1 - pc;
+        }
+        return (uint16_t)(panel * PANEL_W * PANEL_H + pr * PANEL_W + pc);
+    }
+};
+
+template <typename G>
+struct PixelMap {
+    uint16_t index[G::HEIGHT][G::WIDTH];
+};
+
+template <typename G>
+constexpr PixelMap<G> buildPixelMap() {
+    PixelMap<G> map = {};
+    for (int row = 0; row < G::HEIGHT; row++) {
+        for (int col = 0; col < G::WIDTH; col++) {
+            map.index[row][col] = G::ledIndex(row, col);
+        }
+    }
+    return map;
+}
+
+struct BorderPoint {
+    uint8_t x;
+    uint8_t y;
+};
+
+// The outer ring of pixels, clockwise from the top left corner
+template <typename G>
+struct BorderWalk {
+    BorderPoint points[G::BORDER_POINTS];
+};
+
+template <typename G>
+constexpr BorderWalk<G> buildBorderWalk() {
+    BorderWalk<G> walk = {};
+    int i = 0;
+    for (int x = 0; x < G::WIDTH; x++) {
+        walk.points[i++] = { (uint8_t)x, 0 };
+    }
+    for (int y = 1; y < G::HEIGHT; y++) {
+        walk.points[i++] = { (uint8_t)(G::WIDTH - 1), (uint8_t)y };
+    }
+    for (int x = G::WIDTH - 2; x >= 0; x--) {
+        walk.points[i++] = { (uint8_t)x, (uint8_t)(G::HEIGHT - 1) };
+    }
+    for (int y = G::HEIGHT - 2; y >= 1; y--) {
+        walk.points[i++] = { 0, (uint8_t)y };
+    }
+    return walk;
+}
+
+#endif // GEOMETRY_H
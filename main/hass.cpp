@@ -1,12 +1,54 @@
 #include "hass.h"
 #include "logging.h"
+#include "status.h"
+#include "entities.h"
+#include "perf.h"
+#include "pools.h"
+#include "render.h"
+#include "warmstart.h"
+
+// --- Parse Filter ---
+// All bound entities come through one subscribe_entities subscription. Its
+// events carry compressed states: "a" holds full states (sent once, right
+// after subscribing), "c" holds diffs with the new values under "+" and "r"
+// lists removed entities. Only the state value "s" is materialized;
+// attributes and context are skipped while parsing and never reach the heap.
+static JsonDocument eventFilter;
+
+// Every document built or parsed per message; the filter above is allocated
+// once in setup and stays on the heap
+static StaticJsonArena<HASS_ARENA_SIZE> hassArena("hass_json");
+static char sendBuffer[HASS_SEND_SIZE];
+static PoolUsage sendUsage("hass_send", HASS_SEND_SIZE);
+
+static int subscriptionId = -1;
+static unsigned long connectionOpenedAt = 0;
+static bool initialSyncDone = false;
+
+static void setupFilters() {
+    eventFilter["type"] = true;
+    eventFilter["id"] = true;
+    eventFilter["success"] = true;
+    eventFilter["error"]["message"] = true;
+    JsonObject event = eventFilter["event"].to<JsonObject>();
+    event["a"]["*"]["s"] = true;
+    event["c"]["*"]["+"]["s"] = true;
+    event["r"] = true;
+}
 
 // This will be called from the main setup()
 void setupHass() {
-    // Register callbacks and connect
+    if (eventFilter.isNull()) {
+        setupFilters();
+    }
+
+    // Register callbacks, connecting is up to the connection manager
     client.onMessage(onMessage);
     client.onEvent(onEvent);
-    client.connect(HASS_HOST, HASS_PORT, "/api/websocket");
+}
+
+bool connectHass() {
+    return client.connect(HASS_HOST, HASS_PORT, "/api/websocket");
 }
 
 // This will be called from the main loop()
@@ -14,135 +56,123 @@ void loopHass() {
     client.poll();
 }
 
-String getEntityState(String entityId){
-    HTTPClient http;
-
-    String url = String("http://") + HASS_HOST + ":" + HASS_PORT + "/api/states/" + entityId;
-    http.begin(url);
-
-    // Add authorization header
-    http.addHeader("Authorization", String("Bearer ") + HASS_TOKEN);
-    http.addHeader("Content-Type", "application/json");
-
-    int httpResponseCode = http.GET();
-
-    if (httpResponseCode > 0) {
-      String payload = http.getString();
-      logInfo("Response: " + payload);
-
-      // Parse JSON to get the state value
-      // Using DynamicJsonDocument to avoid potential overflow with larger HA responses.
-      DynamicJsonDocument doc(1024);
-      deserializeJson(doc, payload);
-      const char* state = doc["state"];
-      logInfo("Sensor state: " + String(state));
-      http.end();
-      return state;
-    } else {
-      logError("Error on HTTP request: " + String(httpResponseCode));
-      http.end();
-      return "error";
+bool hassStatesSynced() {
+    return ws_connected && initialSyncDone;
+}
+
+static void sendMessage(const JsonDocument& msg) {
+    size_t length = measureJson(msg);
+    if (msg.overflowed() || length >= sizeof(sendBuffer)) {
+        sendUsage.fail();
+        logError("HA message does not fit the send buffer (%u bytes)", (unsigned)length);
+        return;
+    }
+    serializeJson(msg, sendBuffer, sizeof(sendBuffer));
+    sendUsage.record(length + 1);
+    client.send(sendBuffer, length);
+}
+
+static void subscribeEntities() {
+    JsonDocument sub_msg(&hassArena);
+    subscriptionId = hass_message_id++;
+    sub_msg["id"] = subscriptionId;
+    sub_msg["type"] = "subscribe_entities";
+    JsonArray ids = sub_msg["entity_ids"].to<JsonArray>();
+    for (int i = 0; i < entityCount; i++) {
+        ids.add(entityBindings[i].entityId);
+    }
+    sendMessage(sub_msg);
+    logInfo("Subscribing to %d entities (ID: %d)", entityCount, subscriptionId);
+}
+
+static void applyState(const char* entityId, const char* state, bool initial) {
+    if (state == nullptr) {
+        // Attribute-only diff
+        return;
+    }
+    int index = findEntity(entityId);
+    if (index < 0) {
+        return;
+    }
+    // Only beep when the interned state actually changed, and not for the initial sync
+    if (setEntityState(index, internState(state))) {
+        logInfo("Sensor %d state updated: %s", index + 1, state);
+        if (!initial) {
+            postEntityEvent(index, entityStates[index]);
+        }
+    }
+}
+
+static void applyEntitiesEvent(JsonObject event) {
+    for (JsonPair entity : event["a"].as<JsonObject>()) {
+        applyState(entity.key().c_str(), entity.value()["s"], true);
+    }
+    for (JsonPair entity : event["c"].as<JsonObject>()) {
+        applyState(entity.key().c_str(), entity.value()["+"]["s"], false);
+    }
+    for (JsonVariant entityId : event["r"].as<JsonArray>()) {
+        applyState(entityId.as<const char*>(), "unknown", false);
+    }
+
+    if (!initialSyncDone && event["a"].is<JsonObject>()) {
+        initialSyncDone = true;
+        logInfo("Initial state synced %lu ms after connecting", millis() - connectionOpenedAt);
+        if (statesStale) {
+            // Cached states HA did not send are not known any more
+            JsonObject synced = event["a"];
+            for (int i = 0; i < entityCount; i++) {
+                if (synced[entityBindings[i].entityId].isNull()) {
+                    setEntityState(i, STATE_UNKNOWN);
+                }
+            }
+            endStaleStates();
+        }
     }
 }
 
 void onMessage(WebsocketsMessage message) {
-    logInfo("Got Message: " + message.data());
+    logDebug("Got Message: %s", message.c_str());
+    PerfScope perf(PERF_HASS_MESSAGE);
 
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, message.data());
+    // Parse from the receive buffer without copying it into a String first
+    JsonDocument doc(&hassArena);
+    DeserializationError error = deserializeJson(doc, message.c_str(), message.length(),
+                                                 DeserializationOption::Filter(eventFilter));
     if (error) {
-        logError("deserializeJson() failed: " + String(error.c_str()));
+        logError("deserializeJson() failed: %s", error.c_str());
         return;
     }
 
     const char* type = doc["type"];
+    if (type == nullptr) {
+        logWarning("HA message without type");
+        return;
+    }
 
     if (strcmp(type, "auth_required") == 0) {
         logInfo("Auth required, sending token...");
-        JsonDocument auth_msg;
+        JsonDocument auth_msg(&hassArena);
         auth_msg["type"] = "auth";
         auth_msg["access_token"] = HASS_TOKEN;
-        String auth_str;
-        serializeJson(auth_msg, auth_str);
-        client.send(auth_str);
+        sendMessage(auth_msg);
     } else if (strcmp(type, "auth_ok") == 0) {
         logInfo("Auth OK!");
 
-        // Subscribe to sensor 1
-        JsonDocument sub_msg_1;
-        sub_msg_1["id"] = hass_message_id++;
-        sub_msg_1["type"] = "subscribe_trigger";
-        JsonObject trigger1 = sub_msg_1.createNestedObject("trigger");
-        trigger1["platform"] = "state";
-        trigger1["entity_id"] = SENSOR_1_ENTITY_ID;
-        String sub_str_1;
-        serializeJson(sub_msg_1, sub_str_1);
-        client.send(sub_str_1);
-        logInfo("Subscribing to " + String(SENSOR_1_ENTITY_ID));
-
-        // Subscribe to sensor 2
-        JsonDocument sub_msg_2;
-        sub_msg_2["id"] = hass_message_id++;
-        sub_msg_2["type"] = "subscribe_trigger";
-        JsonObject trigger2 = sub_msg_2.createNestedObject("trigger");
-        trigger2["platform"] = "state";
-        trigger2["entity_id"] = SENSOR_2_ENTITY_ID;
-        String sub_str_2;
-        serializeJson(sub_msg_2, sub_str_2);
-        client.send(sub_str_2);
-        logInfo("Subscribing to " + String(SENSOR_2_ENTITY_ID));
-
-        // Subscribe to sensor compressor
-        JsonDocument sub_msg_3;
-        sub_msg_3["id"] = hass_message_id++;
-        sub_msg_3["type"] = "subscribe_trigger";
-        JsonObject trigger3 = sub_msg_3.createNestedObject("trigger");
-        trigger3["platform"] = "state";
-        trigger3["entity_id"] = SENSOR_3_ENTITY_ID;
-        String sub_str_3;
-        serializeJson(sub_msg_3, sub_str_3);
-        client.send(sub_str_3);
-        logInfo("Subscribing to " + String(SENSOR_3_ENTITY_ID));
-
+        subscribeEntities();
     } else if (strcmp(type, "auth_invalid") == 0) {
         logError("Auth invalid. Check your HASS_TOKEN.");
     } else if (strcmp(type, "event") == 0) {
-        JsonObject event = doc["event"];
-        JsonObject variables = event["variables"];
-        JsonObject trigger = variables["trigger"];
-        const char* entity_id = trigger["entity_id"];
-        const char* state = trigger["to_state"]["state"];
-
-        if (strcmp(entity_id, SENSOR_1_ENTITY_ID) == 0) {
-            strcpy(sensor_1_state, state);
-            logInfo("Sensor 1 state updated: " + String(sensor_1_state));
-            playSound();
-        } else if (strcmp(entity_id, SENSOR_2_ENTITY_ID) == 0) {
-            strcpy(sensor_2_state, state);
-            logInfo("Sensor 2 state updated: " + String(sensor_2_state));
-            Serial.println(sensor_2_state);
-            playSound();
-        } else if (strcmp(entity_id, SENSOR_3_ENTITY_ID) == 0) {
-            strcpy(sensor_3_state, state);
-            logInfo("Sensor 3 state updated: " + String(sensor_3_state));
-            Serial.println(sensor_3_state);
-
-            String stateLower = String(sensor_3_state);
-            stateLower.toLowerCase();
-
-            if (stateLower == "on") {
-                playSound(3, 50, 100);
-            } else {
-                playSound(1, 50, 300);
-            }
+        if (doc["id"] != subscriptionId) {
+            return;
         }
+        applyEntitiesEvent(doc["event"]);
     } else if (strcmp(type, "result") == 0) {
         if (doc["success"] == true) {
-            logInfo("Subscription successful for ID: " + String(doc["id"].as<int>()));
+            logInfo("Subscription successful for ID: %d", doc["id"].as<int>());
         } else {
-            logError("Subscription failed for ID: " + String(doc["id"].as<int>()));
+            logError("Subscription failed for ID: %d", doc["id"].as<int>());
             JsonObject error = doc["error"];
-            logError("Error: " + String(error["message"].as<const char*>()));
+            logError("Error: %s", error["message"] | "unknown");
         }
     }
 }
@@ -150,10 +180,16 @@ void onMessage(WebsocketsMessage message) {
 void onEvent(WebsocketsEvent event, String data) {
     if(event == WebsocketsEvent::ConnectionOpened) {
         logInfo("Websocket connection opened");
+        connectionOpenedAt = millis();
+        initialSyncDone = false;
+        subscriptionId = -1;
 
         ws_connected = true;
+        notifyStatusChanged();
     } else if(event == WebsocketsEvent::ConnectionClosed) {
         logInfo("Websocket connection closed");
         ws_connected = false;
+        initialSyncDone = false;
+        notifyStatusChanged();
     }
 }
@@ -3,16 +3,24 @@
 
 #include "declarations.h"
 
+// Static buffers for HA messages (see pools.h): the arena holds the parsed
+// documents, the send buffer serialized outgoing messages
+#define HASS_ARENA_SIZE 4096
+#define HASS_SEND_SIZE  1024
+
 // --- Function Prototypes ---
 
 // Setup
 void setupHass();
+bool connectHass();
 
 // Core Loop
 void loopHass();
 
+// The entity states of the current connection have arrived
+bool hassStatesSynced();
+
 // Functions
-String getEntityState(String entityId);
 void onMessage(WebsocketsMessage message);
 void onEvent(WebsocketsEvent event, String data);
 
@@ -0,0 +1,503 @@
+#include "history.h"
+#include "logging.h"
+#include "entities.h"
+#include "buffered_print.h"
+#if HISTORY_PERSIST
+#include <LittleFS.h>
+#endif
+
+// --- Record Format ---
+// One byte with the entity index (bits 0-3) and the state (bits 4-6), then
+// the seconds since the previous transition as a LEB128 varint: 1 byte up
+// to 2 minutes, 3 bytes up to 24 days.
+
+#define RECORD_MAX_SIZE 6
+#define SECONDS_PER_DAY 86400
+
+static_assert(MAX_ENTITIES <= 16 && STATE_COUNT <= 8, "Entity and state must fit one record byte");
+static_assert((HISTORY_RAM_SIZE & (HISTORY_RAM_SIZE - 1)) == 0, "HISTORY_RAM_SIZE must be a power of two");
+
+static size_t encodeRecord(uint8_t* out, uint8_t index, EntityState state, uint32_t delta) {
+    size_t size = 0;
+    out[size++] = index | (uint8_t)state << 4;
+    do {
+        uint8_t byte = delta & 0x7F;
+        delta >>= 7;
+        out[size++] = delta != 0 ? byte | 0x80 : byte;
+    } while (delta != 0);
+    return size;
+}
+
+// Size of the record at data, 0 when it is cut short or malformed
+static size_t decodeRecord(const uint8_t* data, size_t available, uint8_t& index, EntityState& state, uint32_t& delta) {
+    if (available < 2 || (data[0] >> 4) >= STATE_COUNT) {
+        return 0;
+    }
+    index = data[0] & 0x0F;
+    state = (EntityState)(data[0] >> 4);
+    delta = 0;
+    for (size_t i = 1; i < available && i < RECORD_MAX_SIZE; i++) {
+        delta |= (uint32_t)(data[i] & 0x7F) << (7 * (i - 1));
+        if ((data[i] & 0x80) == 0) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+// --- RAM Ring ---
+// Offsets run freely and are masked on access. Deltas chain from the
+// oldest record, so evicting it moves its time into tailBaseTime.
+
+static uint8_t ring[HISTORY_RAM_SIZE];
+static uint32_t ringHead = 0;
+static uint32_t ringTail = 0;
+static uint32_t tailBaseTime = 0; // Time the oldest record's delta counts from
+static uint32_t lastTime = 0;     // Time of the newest record
+static HistoryStats stats;
+static EntityState lastState[MAX_ENTITIES]; // Newest recorded or pending state
+
+// Transitions from before the clock was set, with their millis(). They get
+// their epoch time, counted back from the first valid one, in loopHistory().
+struct PendingTransition {
+    uint8_t index;
+    EntityState state;
+    unsigned long atMs;
+};
+static PendingTransition pending[HISTORY_PENDING];
+static uint8_t pendingCount = 0;
+
+static size_t peekRecord(uint32_t offset, uint8_t& index, EntityState& state, uint32_t& delta) {
+    uint8_t record[RECORD_MAX_SIZE];
+    size_t available = min((size_t)(ringHead - offset), (size_t)RECORD_MAX_SIZE);
+    for (size_t i = 0; i < available; i++) {
+        record[i] = ring[(offset + i) & (HISTORY_RAM_SIZE - 1)];
+    }
+    return decodeRecord(record, available, index, state, delta);
+}
+
+static void evictOldest() {
+    uint8_t index;
+    EntityState state;
+    uint32_t delta;
+    size_t size = peekRecord(ringTail, index, state, delta);
+    if (size == 0) {
+        // Cannot happen with records written by appendRecord(); start over
+        ringTail = ringHead;
+        tailBaseTime = lastTime;
+        stats.firstSeq = stats.nextSeq;
+        stats.events = 0;
+        return;
+    }
+    ringTail += size;
+    tailBaseTime += delta;
+    stats.firstSeq++;
+    stats.events--;
+}
+
+static void appendRecord(const uint8_t* record, size_t size) {
+    while (HISTORY_RAM_SIZE - (ringHead - ringTail) < size) {
+        evictOldest();
+    }
+    for (size_t i = 0; i < size; i++) {
+        ring[(ringHead + i) & (HISTORY_RAM_SIZE - 1)] = record[i];
+    }
+    ringHead += size;
+    stats.nextSeq++;
+    stats.events++;
+    stats.bytes = ringHead - ringTail;
+}
+
+// --- Session Totals ---
+
+struct DayTotals {
+    uint32_t day; // Days since the epoch, UTC
+    uint16_t sessions;
+    uint32_t chargeSeconds;
+};
+
+struct SessionTotals {
+    bool charging;
+    uint32_t chargingSince;
+    DayTotals days[HISTORY_DAYS]; // Indexed by day % HISTORY_DAYS
+};
+
+static SessionTotals sessions[MAX_ENTITIES];
+
+// nullptr when the slot already holds a newer day
+static DayTotals* dayTotals(SessionTotals& totals, uint32_t day) {
+    DayTotals& slot = totals.days[day % HISTORY_DAYS];
+    if (slot.day > day) {
+        return nullptr;
+    }
+    if (slot.day < day) {
+        slot.day = day;
+        slot.sessions = 0;
+        slot.chargeSeconds = 0;
+    }
+    return &slot;
+}
+
+// Splits the session at midnight, so each day gets its own share
+static void addChargeTime(SessionTotals& totals, uint32_t from, uint32_t to) {
+    if (to - from > HISTORY_DAYS * SECONDS_PER_DAY) {
+        from = to - HISTORY_DAYS * SECONDS_PER_DAY;
+    }
+    while (from < to) {
+        uint32_t day = from / SECONDS_PER_DAY;
+        uint32_t end = min(to, (uint32_t)((day + 1) * SECONDS_PER_DAY));
+        DayTotals* totalsOfDay = dayTotals(totals, day);
+        if (totalsOfDay != nullptr) {
+            totalsOfDay->chargeSeconds += end - from;
+        }
+        from = end;
+    }
+}
+
+// A charging -> charging record (e.g. after a reboot) continues the session
+static void updateSessions(uint8_t index, EntityState state, uint32_t time) {
+    SessionTotals& totals = sessions[index];
+    if (state == STATE_CHARGING && !totals.charging) {
+        totals.charging = true;
+        totals.chargingSince = time;
+        DayTotals* today = dayTotals(totals, time / SECONDS_PER_DAY);
+        if (today != nullptr) {
+            today->sessions++;
+        }
+    } else if (state != STATE_CHARGING && totals.charging) {
+        totals.charging = false;
+        addChargeTime(totals, totals.chargingSince, time);
+    }
+}
+
+// Records a transition in RAM; returns the encoded record for the flash copy
+static size_t addTransition(uint8_t index, EntityState state, uint32_t time, uint8_t* record) {
+    // A clock that went backwards is recorded as no time passing
+    uint32_t delta = time >= lastTime ? time - lastTime : 0;
+    size_t size = encodeRecord(record, index, state, delta);
+    appendRecord(record, size);
+    lastTime += delta;
+    lastState[index] = state;
+    updateSessions(index, state, lastTime);
+    return size;
+}
+
+// --- LittleFS Segments ---
+// Each segment starts with a header holding its number and the time of the
+// transition before its first record, so it decodes on its own. Segment N
+// lives in slot N % HISTORY_SEGMENTS; starting a new one truncates the
+// oldest. A record cut short by a reset ends its segment at replay, and
+// appends continue in a fresh one.
+
+#if HISTORY_PERSIST
+
+#define SEGMENT_MAGIC 0x31484843 // "CHH1"
+
+struct SegmentHeader {
+    uint32_t magic;
+    uint32_t number;
+    uint32_t baseTime;
+};
+
+static size_t segmentSize = 0; // Bytes in the current segment, 0 to start a new one
+static bool anySegment = false;
+
+static void segmentPath(char* out, size_t size, uint32_t number) {
+    snprintf(out, size, "/history%u.bin", (unsigned)(number % HISTORY_SEGMENTS));
+}
+
+static bool openSegment(uint32_t number, File& file, SegmentHeader& header) {
+    char path[24];
+    segmentPath(path, sizeof(path), number);
+    if (!LittleFS.exists(path)) {
+        return false;
+    }
+    file = LittleFS.open(path, "r");
+    return file && file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+           header.magic == SEGMENT_MAGIC;
+}
+
+// Returns false when the segment ends in a partial record
+static bool replaySegment(uint32_t number) {
+    File file;
+    SegmentHeader header;
+    if (!openSegment(number, file, header) || header.number != number) {
+        return false;
+    }
+
+    uint32_t time = header.baseTime;
+    uint8_t block[64];
+    size_t length = 0;
+    bool clean = true;
+    for (;;) {
+        length += file.read(block + length, sizeof(block) - length);
+        if (length == 0) {
+            break;
+        }
+
+        size_t used = 0;
+        uint8_t index;
+        EntityState state;
+        uint32_t delta;
+        size_t size;
+        while ((size = decodeRecord(block + used, length - used, index, state, delta)) > 0) {
+            time += delta;
+            if (index < entityCount) {
+                uint8_t record[RECORD_MAX_SIZE];
+                addTransition(index, state, time, record);
+            }
+            used += size;
+        }
+        if (used == 0) {
+            // The block is refilled before decoding, so this is a cut or
+            // corrupt record at the end of what was written
+            clean = false;
+            break;
+        }
+        memmove(block, block + used, length - used);
+        length -= used;
+    }
+    segmentSize = file.size();
+    file.close();
+    return clean;
+}
+
+static void setupSegments() {
+    if (!LittleFS.begin(true)) {
+        logError("LittleFS mount failed, history is kept in RAM only");
+        return;
+    }
+    stats.persisted = true;
+
+    // Newest segment on flash, the rest are the ones before it
+    bool found = false;
+    uint32_t newest = 0;
+    for (uint32_t slot = 0; slot < HISTORY_SEGMENTS; slot++) {
+        File file;
+        SegmentHeader header;
+        if (openSegment(slot, file, header) && header.number % HISTORY_SEGMENTS == slot) {
+            if (!found || header.number > newest) {
+                newest = header.number;
+            }
+            found = true;
+        }
+        if (file) {
+            file.close();
+        }
+    }
+    if (!found) {
+        logInfo("No stored history");
+        return;
+    }
+
+    uint32_t oldest = newest >= HISTORY_SEGMENTS - 1 ? newest - (HISTORY_SEGMENTS - 1) : 0;
+    bool clean = true;
+    for (uint32_t number = oldest; number <= newest; number++) {
+        clean = replaySegment(number);
+    }
+    stats.segment = newest;
+    anySegment = true;
+    if (!clean || segmentSize >= HISTORY_SEGMENT_SIZE) {
+        segmentSize = 0;
+    }
+    logInfo("Replayed %lu history transitions from flash", (unsigned long)stats.events);
+}
+
+static void persistRecord(const uint8_t* record, size_t size, uint32_t baseTime) {
+    char path[24];
+    File file;
+    if (segmentSize == 0 || segmentSize + size > HISTORY_SEGMENT_SIZE) {
+        uint32_t number = anySegment ? stats.segment + 1 : 0;
+        segmentPath(path, sizeof(path), number);
+        file = LittleFS.open(path, "w");
+        SegmentHeader header = { SEGMENT_MAGIC, number, baseTime };
+        if (!file || file.write((const uint8_t*)&header, sizeof(header)) != sizeof(header)) {
+            stats.writeErrors++;
+            return;
+        }
+        stats.segment = number;
+        anySegment = true;
+        segmentSize = sizeof(header);
+    } else {
+        segmentPath(path, sizeof(path), stats.segment);
+        file = LittleFS.open(path, "a");
+        if (!file) {
+            stats.writeErrors++;
+            return;
+        }
+    }
+
+    if (file.write(record, size) == size) {
+        segmentSize += size;
+    } else {
+        // Whatever part made it is a cut record; continue in a new segment
+        stats.writeErrors++;
+        segmentSize = 0;
+    }
+    file.close();
+}
+
+#endif
+
+// --- Public ---
+
+void setupHistory() {
+    ringHead = 0;
+    ringTail = 0;
+    tailBaseTime = 0;
+    lastTime = 0;
+    pendingCount = 0;
+    memset(&stats, 0, sizeof(stats));
+    memset(sessions, 0, sizeof(sessions));
+    memset(lastState, STATE_UNKNOWN, sizeof(lastState));
+#if HISTORY_PERSIST
+    segmentSize = 0;
+    anySegment = false;
+    setupSegments();
+#endif
+}
+
+static void storeTransition(uint8_t index, EntityState state, uint32_t time) {
+    uint8_t record[RECORD_MAX_SIZE];
+#if HISTORY_PERSIST
+    uint32_t baseTime = lastTime;
+    size_t size = addTransition(index, state, time, record);
+    if (stats.persisted) {
+        persistRecord(record, size, baseTime);
+    }
+#else
+    addTransition(index, state, time, record);
+#endif
+}
+
+void recordTransition(int index, EntityState state) {
+    // The same state again (e.g. after a reconnect) is not a transition
+    if (index < 0 || index >= entityCount || lastState[index] == state) {
+        return;
+    }
+    if (timeClient.isTimeSet() && pendingCount == 0) {
+        storeTransition(index, state, timeClient.getEpochTime());
+        return;
+    }
+
+    // No clock yet: keep the newest ones until loopHistory() can time them
+    if (pendingCount == HISTORY_PENDING) {
+        memmove(pending, pending + 1, sizeof(pending) - sizeof(pending[0]));
+        pendingCount--;
+        stats.untimedDropped++;
+    }
+    pending[pendingCount++] = { (uint8_t)index, state, millis() };
+    lastState[index] = state;
+}
+
+void loopHistory() {
+    if (pendingCount == 0 || !timeClient.isTimeSet()) {
+        return;
+    }
+    uint32_t now = timeClient.getEpochTime();
+    unsigned long nowMs = millis();
+    for (int i = 0; i < pendingCount; i++) {
+        uint32_t age = (nowMs - pending[i].atMs) / 1000;
+        storeTransition(pending[i].index, pending[i].state, now >= age ? now - age : 0);
+    }
+    pendingCount = 0;
+}
+
+// Calendar date of a day number since 1970 (H. Hinnant's civil_from_days).
+// gmtime_r() would do, but the first call sets up the time zone on the heap.
+static void civilDate(uint32_t day, int& year, int& month, int& dayOfMonth) {
+    uint32_t z = day + 719468;
+    uint32_t era = z / 146097;
+    uint32_t dayOfEra = z - era * 146097;
+    uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    uint32_t monthIndex = (5 * dayOfYear + 2) / 153;
+    dayOfMonth = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+static void writeSessions(Print& out, uint32_t now) {
+    uint32_t today = now / SECONDS_PER_DAY;
+    for (int i = 0; i < entityCount; i++) {
+        const SessionTotals& totals = sessions[i];
+        printLine(out, "%s{\"sensor\":%d,\"charging_since\":", i > 0 ? "," : "", i + 1);
+        if (totals.charging) {
+            printLine(out, "%lu", (unsigned long)totals.chargingSince);
+        } else {
+            out.print("null");
+        }
+        out.print(",\"days\":[");
+
+        bool first = true;
+        for (uint32_t day = today - (HISTORY_DAYS - 1); day <= today; day++) {
+            const DayTotals& totalsOfDay = totals.days[day % HISTORY_DAYS];
+            if (totalsOfDay.day != day || (totalsOfDay.sessions == 0 && totalsOfDay.chargeSeconds == 0)) {
+                continue;
+            }
+            int year, month, dayOfMonth;
+            civilDate(day, year, month, dayOfMonth);
+            printLine(out, "%s{\"date\":\"%04d-%02d-%02d\",\"sessions\":%u,\"charge_s\":%lu}", first ? "" : ",",
+                      year, month, dayOfMonth, (unsigned)totalsOfDay.sessions,
+                      (unsigned long)totalsOfDay.chargeSeconds);
+            first = false;
+        }
+        out.print("]}");
+    }
+}
+
+static void writeHistory(Print& out, uint32_t since) {
+    uint32_t now = timeClient.getEpochTime();
+    printLine(out, "{\"now\":%lu,\"since\":%lu,\"first_seq\":%lu,\"next_seq\":%lu,\"events\":[",
+              (unsigned long)now, (unsigned long)since, (unsigned long)stats.firstSeq, (unsigned long)stats.nextSeq);
+
+    uint32_t offset = ringTail;
+    uint32_t time = tailBaseTime;
+    uint32_t seq = stats.firstSeq;
+    bool first = true;
+    while (offset != ringHead) {
+        uint8_t index;
+        EntityState state;
+        uint32_t delta;
+        size_t size = peekRecord(offset, index, state, delta);
+        if (size == 0) {
+            break;
+        }
+        offset += size;
+        time += delta;
+        if (time >= since) {
+            printLine(out, "%s{\"seq\":%lu,\"t\":%lu,\"sensor\":%d,\"state\":\"%s\"}", first ? "" : ",",
+                      (unsigned long)seq, (unsigned long)time, index + 1, stateName(state));
+            first = false;
+        }
+        seq++;
+    }
+
+    printLine(out, "],\"days\":%d,\"sessions\":[", HISTORY_DAYS);
+    writeSessions(out, now);
+    out.print("]}");
+}
+
+void sendHistoryHttp(WiFiClient& client, uint32_t since, bool keepAlive) {
+    {
+        BufferedPrint out(client);
+        out.print(F("HTTP/1.1 200 OK\r\n"));
+        out.print(F("Content-Type: application/json\r\n"));
+        out.print(F("Cache-Control: no-cache\r\n"));
+        out.print(F("Access-Control-Allow-Origin: *\r\n"));
+        out.print(keepAlive ? F("Transfer-Encoding: chunked\r\nConnection: keep-alive\r\n\r\n")
+                            : F("Connection: close\r\n\r\n"));
+    }
+
+    if (keepAlive) {
+        ChunkedPrint out(client);
+        writeHistory(out, since);
+    } else {
+        BufferedPrint out(client);
+        writeHistory(out, since);
+    }
+}
+
+const HistoryStats& getHistoryStats() {
+    return stats;
+}
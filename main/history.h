@@ -0,0 +1,50 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "declarations.h"
+
+// --- Transition History ---
+// Every entity state change is kept in a RAM ring of compact records (a
+// few bytes each: entity, state and the seconds since the previous change),
+// so "when did bike 2 stop charging" is answered by the device itself.
+// With HISTORY_PERSIST the same records are appended to LittleFS in
+// fixed-size segments, the oldest segment being overwritten, and replayed
+// into the ring at boot.
+//
+// Per entity, charging sessions are counted and timed per UTC day for the
+// last HISTORY_DAYS days, updated as transitions arrive.
+
+#define HISTORY_RAM_SIZE     8192 // Bytes of records kept in RAM, a power of two
+#define HISTORY_PERSIST      1    // 0 keeps the history in RAM only
+#define HISTORY_SEGMENT_SIZE 4096 // Bytes per LittleFS segment, header included
+#define HISTORY_SEGMENTS     4    // Segments kept on flash
+#define HISTORY_DAYS         7
+#define HISTORY_PENDING      16   // Transitions held until the clock is set
+
+struct HistoryStats {
+    uint32_t events;      // Transitions in the RAM ring
+    uint32_t bytes;       // ...and the bytes they take
+    uint32_t firstSeq;    // Sequence number of the oldest one
+    uint32_t nextSeq;     // Sequence number the next one will get
+    bool persisted;       // LittleFS mounted and in use
+    uint32_t segment;     // Segment appends go to
+    uint32_t writeErrors;
+    uint32_t untimedDropped; // Lost while waiting for the clock (HISTORY_PENDING)
+};
+
+// Mounts LittleFS and replays the stored segments; call after setupEntities()
+void setupHistory();
+
+// Called by setEntityState() for every actual change. Until the clock is
+// set, transitions wait in a small queue for loopHistory() to time them.
+void recordTransition(int index, EntityState state);
+void loopHistory();
+
+// GET /history: transitions at or after `since` (epoch seconds) and the
+// session totals, streamed as JSON. Chunked on keep-alive connections,
+// otherwise ended by closing the connection.
+void sendHistoryHttp(WiFiClient& client, uint32_t since, bool keepAlive);
+
+const HistoryStats& getHistoryStats();
+
+#endif // HISTORY_H
@@ -0,0 +1,244 @@
+#include "http_request.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+HttpRequestParser::HttpRequestParser() {
+    reset();
+}
+
+void HttpRequestParser::reset() {
+    method = HTTP_METHOD_UNKNOWN;
+    path[0] = '\0';
+    query[0] = '\0';
+    ifNoneMatch[0] = '\0';
+    keepAlive = false;
+    acceptsGzip = false;
+    currentState = REQUEST_LINE;
+    errorCode = 0;
+    lineLength = 0;
+    lineOverflow = false;
+    bodyRemaining = 0;
+}
+
+size_t HttpRequestParser::feed(const char* data, size_t length) {
+    size_t used = 0;
+    while (used < length && currentState != COMPLETE && currentState != ERROR) {
+        if (currentState == BODY) {
+            size_t take = length - used;
+            if (take > bodyRemaining) {
+                take = bodyRemaining;
+            }
+            used += take;
+            bodyRemaining -= take;
+            if (bodyRemaining == 0) {
+                currentState = COMPLETE;
+            }
+            continue;
+        }
+
+        char c = data[used++];
+        if (c == '\r') {
+            continue;
+        }
+        if (c != '\n') {
+            if (lineLength < sizeof(line) - 1) {
+                line[lineLength++] = c;
+            } else {
+                lineOverflow = true;
+            }
+            continue;
+        }
+
+        line[lineLength] = '\0';
+        endLine();
+        lineLength = 0;
+        lineOverflow = false;
+    }
+    return used;
+}
+
+bool HttpRequestParser::endLine() {
+    if (currentState == REQUEST_LINE) {
+        if (lineLength == 0) {
+            // Tolerate empty lines before the request line
+            return true;
+        }
+        if (lineOverflow) {
+            fail(414);
+            return false;
+        }
+        if (!parseRequestLine()) {
+            return false;
+        }
+        currentState = HEADERS;
+        return true;
+    }
+
+    if (lineLength == 0) {
+        currentState = bodyRemaining > 0 ? BODY : COMPLETE;
+        return true;
+    }
+    if (!lineOverflow) {
+        parseHeader();
+    }
+    return currentState != ERROR;
+}
+
+bool HttpRequestParser::parseRequestLine() {
+    char* target = strchr(line, ' ');
+    if (target == nullptr) {
+        fail(400);
+        return false;
+    }
+    *target++ = '\0';
+    char* version = strchr(target, ' ');
+    if (version == nullptr) {
+        fail(400);
+        return false;
+    }
+    *version++ = '\0';
+
+    if (strcmp(line, "GET") == 0) {
+        method = HTTP_METHOD_GET;
+    } else if (strcmp(line, "POST") == 0) {
+        method = HTTP_METHOD_POST;
+    } else if (strcmp(line, "HEAD") == 0) {
+        method = HTTP_METHOD_HEAD;
+    } else {
+        fail(501);
+        return false;
+    }
+
+    if (strcmp(version, "HTTP/1.1") == 0) {
+        keepAlive = true;
+    } else if (strcmp(version, "HTTP/1.0") == 0) {
+        keepAlive = false;
+    } else {
+        fail(400);
+        return false;
+    }
+
+    if (target[0] != '/') {
+        fail(400);
+        return false;
+    }
+    size_t pathLength = strcspn(target, "?");
+    if (pathLength >= sizeof(path)) {
+        fail(414);
+        return false;
+    }
+    memcpy(path, target, pathLength);
+    path[pathLength] = '\0';
+
+    if (target[pathLength] == '?') {
+        const char* start = target + pathLength + 1;
+        size_t queryLength = strlen(start);
+        if (queryLength >= sizeof(query)) {
+            fail(414);
+            return false;
+        }
+        memcpy(query, start, queryLength + 1);
+    }
+    return true;
+}
+
+void HttpRequestParser::parseHeader() {
+    char* value = strchr(line, ':');
+    if (value == nullptr) {
+        return;
+    }
+    *value++ = '\0';
+    while (*value == ' ' || *value == '\t') {
+        value++;
+    }
+
+    if (strcasecmp(line, "If-None-Match") == 0) {
+        strncpy(ifNoneMatch, value, sizeof(ifNoneMatch) - 1);
+        ifNoneMatch[sizeof(ifNoneMatch) - 1] = '\0';
+    } else if (strcasecmp(line, "Connection") == 0) {
+        if (strcasecmp(value, "close") == 0) {
+            keepAlive = false;
+        } else if (strcasecmp(value, "keep-alive") == 0) {
+            keepAlive = true;
+        }
+    } else if (strcasecmp(line, "Accept-Encoding") == 0) {
+        acceptsGzip = strstr(value, "gzip") != nullptr;
+    } else if (strcasecmp(line, "Content-Length") == 0) {
+        bodyRemaining = strtoul(value, nullptr, 10);
+    } else if (strcasecmp(line, "Transfer-Encoding") == 0) {
+        // No request here carries a body, chunked ones are not worth decoding
+        fail(501);
+    }
+}
+
+void HttpRequestParser::fail(int status) {
+    errorCode = status;
+    currentState = ERROR;
+}
+
+bool matchRoute(const char* pattern, const char* path, RouteParams& params) {
+    params.count = 0;
+    while (*pattern != '\0') {
+        if (*pattern != '{') {
+            if (*pattern != *path) {
+                return false;
+            }
+            pattern++;
+            path++;
+            continue;
+        }
+
+        const char* end = strchr(pattern, '}');
+        size_t length = strcspn(path, "/");
+        if (end == nullptr || length == 0 || length >= HTTP_MAX_PARAM_TEXT ||
+            params.count == HTTP_MAX_ROUTE_PARAMS) {
+            return false;
+        }
+
+        uint8_t index = params.count++;
+        params.number[index] = 0;
+        if (strncmp(pattern, "{int}", 5) == 0) {
+            const char* digit = path[0] == '-' ? path + 1 : path;
+            if (digit == path + length) {
+                return false;
+            }
+            for (; digit < path + length; digit++) {
+                if (!isdigit((unsigned char)*digit)) {
+                    return false;
+                }
+            }
+            params.number[index] = strtol(path, nullptr, 10);
+        } else if (strncmp(pattern, "{str}", 5) != 0) {
+            return false;
+        }
+        memcpy(params.text[index], path, length);
+        params.text[index][length] = '\0';
+
+        pattern = end + 1;
+        path += length;
+    }
+    return *path == '\0';
+}
+
+bool queryParam(const char* query, const char* name, char* value, size_t size) {
+    size_t nameLength = strlen(name);
+    while (*query != '\0') {
+        size_t length = strcspn(query, "&");
+        if (length > nameLength && strncmp(query, name, nameLength) == 0 && query[nameLength] == '=') {
+            size_t valueLength = length - nameLength - 1;
+            if (valueLength >= size) {
+                return false;
+            }
+            memcpy(value, query + nameLength + 1, valueLength);
+            value[valueLength] = '\0';
+            return true;
+        }
+        query += length;
+        if (*query == '&') {
+            query++;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,91 @@
+#ifndef HTTP_REQUEST_H
+#define HTTP_REQUEST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// --- HTTP Request Parser ---
+// Incremental HTTP/1.x request parser. Bytes are fed as they arrive from the
+// socket, in fragments of any size; the parser keeps its own state between
+// calls and never blocks. It has no Arduino dependencies, so it can be fed
+// raw request bytes on the host.
+//
+// Only what the server uses is kept: method, path and query string,
+// If-None-Match, gzip support and the connection persistence. Other headers
+// are skipped, and a body announced by Content-Length is consumed and
+// discarded.
+
+#define HTTP_MAX_PATH          96
+#define HTTP_MAX_QUERY         48
+#define HTTP_MAX_HEADER_LINE   128 // Longer header lines are skipped, not stored
+#define HTTP_MAX_ETAG          48
+#define HTTP_MAX_ROUTE_PARAMS  4
+#define HTTP_MAX_PARAM_TEXT    32
+
+enum HttpMethod {
+    HTTP_METHOD_UNKNOWN = 0,
+    HTTP_METHOD_GET     = 1 << 0,
+    HTTP_METHOD_POST    = 1 << 1,
+    HTTP_METHOD_HEAD    = 1 << 2
+};
+
+class HttpRequestParser {
+public:
+    enum State { REQUEST_LINE, HEADERS, BODY, COMPLETE, ERROR };
+
+    HttpRequestParser();
+
+    // Forget the current request, ready for the next one on the same connection
+    void reset();
+
+    // Consumes bytes up to the end of the current request. Returns how many
+    // were used; the rest belong to the next (pipelined) request.
+    size_t feed(const char* data, size_t length);
+
+    State state() const { return currentState; }
+    bool isComplete() const { return currentState == COMPLETE; }
+    bool isError() const { return currentState == ERROR; }
+    // Suggested status code when isError(): 400, 414 or 501
+    int errorStatus() const { return errorCode; }
+
+    HttpMethod method;
+    char path[HTTP_MAX_PATH];   // Without the query string
+    char query[HTTP_MAX_QUERY]; // After the '?', empty when there is none
+    char ifNoneMatch[HTTP_MAX_ETAG];
+    bool keepAlive;             // HTTP/1.1 default, or Connection: keep-alive on 1.0
+    bool acceptsGzip;
+
+private:
+    State currentState;
+    int errorCode;
+    char line[HTTP_MAX_HEADER_LINE];
+    size_t lineLength;
+    bool lineOverflow;
+    unsigned long bodyRemaining;
+
+    bool endLine();
+    bool parseRequestLine();
+    void parseHeader();
+    void fail(int status);
+};
+
+// --- Route Matching ---
+// Patterns are literal paths where a segment may be a typed parameter:
+//   "{int}" matches an optional '-' and digits, stored in RouteParams::number
+//   "{str}" matches any non-empty segment, stored in RouteParams::text
+// e.g. "/config/update_state/{int}/{str}". Parameters are numbered from left
+// to right in a single sequence, whatever their type.
+
+struct RouteParams {
+    uint8_t count;
+    long number[HTTP_MAX_ROUTE_PARAMS];
+    char text[HTTP_MAX_ROUTE_PARAMS][HTTP_MAX_PARAM_TEXT]; // Also set for {int}
+};
+
+bool matchRoute(const char* pattern, const char* path, RouteParams& params);
+
+// Copies the value of `name` from a query string ("a=1&b=2") into value,
+// without percent-decoding. False when the parameter is missing or too long.
+bool queryParam(const char* query, const char* name, char* value, size_t size);
+
+#endif // HTTP_REQUEST_H
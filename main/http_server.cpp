@@ -1,10 +1,50 @@
 #include "http_server.h"
 #include "logging.h"
 #include "display.h"
+#include "status.h"
+#include "metrics.h"
+#include "history.h"
+#include "warmstart.h"
+#include "frame_codec.h"
+#include "entities.h"
+#include "http_request.h"
+#include "perf.h"
+#include "buffered_print.h"
 #include <WebSocketsServer.h>
+#include <lwip/sockets.h>
 #include "http_server_index.h"
 
-WebSocketsServer webSocket = WebSocketsServer(81); // WebSocket on port 81
+#define WS_PUSH_INTERVAL      100  // Minimum time between two pushes (ms)
+#define WS_HEARTBEAT_INTERVAL 1000 // Push uptime/time at least this often (ms)
+#define WS_STALL_TIMEOUT      5000 // Drop a client whose send buffer stays full this long (ms)
+
+// Whether a write would go straight into the socket's send buffer. lwIP
+// reports a TCP socket writable while at least TCP_SNDLOWAT bytes (about
+// half of its 5.7 KB buffer) are free, so a frame, a delta or one
+// HTTP_WRITE_BLOCK fits without blocking.
+static bool socketWritable(int fd) {
+    if (fd < 0) {
+        return false;
+    }
+    fd_set writeSet;
+    FD_ZERO(&writeSet);
+    FD_SET(fd, &writeSet);
+    struct timeval zero = { 0, 0 };
+    return select(fd + 1, nullptr, &writeSet, nullptr, &zero) > 0;
+}
+
+// The library keeps its clients' sockets to itself
+class PushServer : public WebSocketsServer {
+public:
+    explicit PushServer(uint16_t port) : WebSocketsServer(port) {}
+
+    bool writable(uint8_t num) {
+        WiFiClient* tcp = _clients[num].tcp;
+        return tcp != nullptr && socketWritable(tcp->fd());
+    }
+};
+
+PushServer webSocket(81); // WebSocket on port 81
 
 void handleWebSocketEvents(uint8_t num, WStype_t type, uint8_t * payload, size_t length);
 
@@ -16,223 +56,550 @@ void setupHttpServer() {
     webSocket.onEvent(handleWebSocketEvents);
 }
 
-void handleHttpRequests() {
-    WiFiClient client = server.available();
-    if (!client) {
+// --- HTTP Connections ---
+// Up to HTTP_MAX_CONNECTIONS sockets are served at once. Each pass reads at
+// most one block per connection and feeds it to that connection's parser, so
+// a slow client only holds its own slot. Bodies too large to write at once
+// go out the same way: each pass writes what the socket takes without
+// blocking and keeps the offset in the slot. Connections are kept alive
+// between requests until the client closes them or they sit idle.
+
+#define HTTP_MAX_CONNECTIONS      4
+#define HTTP_READ_BLOCK           256
+#define HTTP_KEEPALIVE_TIMEOUT    5000 // Close idle connections after this (ms)
+#define HTTP_REQUEST_TIMEOUT      2000 // A started request must complete within this (ms)
+#define HTTP_KEEPALIVE_MAX        100  // Requests served per connection
+#define HTTP_WRITE_BLOCK          1024
+#define HTTP_WRITE_TIMEOUT        1000 // Give up on a client that stops reading (ms)
+
+// A body in flash still going out (see sendBody())
+struct HttpBody {
+    const uint8_t* data; // nullptr when none is pending
+    size_t length;
+    size_t sent;
+};
+
+struct HttpConnection {
+    bool active;
+    bool inRequest;
+    uint16_t requests;
+    unsigned long lastActivity;
+    unsigned long requestStart;
+    WiFiClient client;
+    HttpRequestParser parser;
+    HttpBody body;
+    // Last block read; pipelined requests wait here while a body goes out
+    char input[HTTP_READ_BLOCK];
+    uint16_t inputLength;
+    uint16_t inputOffset;
+};
+
+static HttpConnection connections[HTTP_MAX_CONNECTIONS];
+
+static const char* statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 408: return "Request Timeout";
+        case 414: return "URI Too Long";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+    }
+    return "Error";
+}
+
+static void sendHead(Print& out, int status, const char* contentType, size_t contentLength, bool keepAlive) {
+    out.printf("HTTP/1.1 %d %s\r\n", status, statusText(status));
+    out.printf("Content-Type: %s\r\n", contentType);
+    out.printf("Content-Length: %u\r\n", (unsigned)contentLength);
+    out.print(F("Access-Control-Allow-Origin: *\r\n"));
+    out.print(keepAlive ? F("Connection: keep-alive\r\n\r\n") : F("Connection: close\r\n\r\n"));
+}
+
+static void sendJson(WiFiClient& client, int status, const char* body, bool keepAlive) {
+    BufferedPrint out(client);
+    size_t length = strlen(body);
+    sendHead(out, status, "application/json", length, keepAlive);
+    out.write((const uint8_t*)body, length);
+}
+
+static void sendError(WiFiClient& client, int status, const char* message, bool keepAlive) {
+    char body[128];
+    snprintf(body, sizeof(body), "{\"status\":\"error\", \"message\":\"%s\"}", message);
+    sendJson(client, status, body, keepAlive);
+}
+
+// --- Routes ---
+
+// A handler writes its response to client, or writes the head and leaves a
+// large static body in deferred
+typedef void (*HttpHandler)(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred);
+
+struct HttpRoute {
+    uint8_t methods; // HttpMethod bits
+    const char* pattern;
+    HttpHandler handler;
+};
+
+// The page is served gzipped when the client accepts it. ETags are content
+// hashes generated with the page, so they change with every new panel; the
+// browser revalidates on each load and gets a 304 while the firmware is the
+// same. A long max-age is not used because "/" is not a versioned URL and a
+// reflashed device would keep serving the old panel from the cache.
+static void handleIndex(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred) {
+    bool gzip = request.acceptsGzip;
+    const char* etag = gzip ? INDEX_HTML_GZ_ETAG : INDEX_HTML_ETAG;
+    const uint8_t* body = gzip ? index_html_gz : (const uint8_t*)index_html;
+    size_t length = gzip ? index_html_gz_len : sizeof(index_html) - 1;
+
+    BufferedPrint out(client);
+    if (strstr(request.ifNoneMatch, etag) != nullptr) {
+        out.print(F("HTTP/1.1 304 Not Modified\r\n"));
+        length = 0;
+    } else {
+        out.print(F("HTTP/1.1 200 OK\r\n"));
+        out.print(F("Content-Type: text/html; charset=utf-8\r\n"));
+        if (gzip) {
+            out.print(F("Content-Encoding: gzip\r\n"));
+        }
+        out.printf("Content-Length: %u\r\n", (unsigned)length);
+    }
+    out.printf("ETag: %s\r\n", etag);
+    out.print(F("Cache-Control: no-cache\r\n"));
+    out.print(F("Vary: Accept-Encoding\r\n"));
+    out.print(request.keepAlive ? F("Connection: keep-alive\r\n\r\n") : F("Connection: close\r\n\r\n"));
+    out.flushBuffer();
+    deferred = { length > 0 ? body : nullptr, length, 0 };
+}
+
+static void handleStatus(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred) {
+    sendStatusHttp(client, request.ifNoneMatch, request.keepAlive);
+}
+
+static void handleMetrics(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred) {
+    sendMetricsHttp(client, request.keepAlive);
+}
+
+static void handleHistory(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred) {
+    char value[12];
+    uint32_t since = 0;
+    if (queryParam(request.query, "since", value, sizeof(value))) {
+        char* end;
+        since = strtoul(value, &end, 10);
+        if (end == value || *end != '\0') {
+            sendError(client, 400, "since must be epoch seconds.", request.keepAlive);
+            return;
+        }
+    }
+    sendHistoryHttp(client, since, request.keepAlive);
+}
+
+static void handleBeep(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred) {
+    logInfo("HTTP GET /beep request received.");
+    playSound();
+    sendJson(client, 200, "{\"status\":\"ok\", \"action\":\"beep\"}", request.keepAlive);
+}
+
+static void handleDisplayBrightness(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred) {
+    long newBrightness = params.number[0];
+    logInfo("HTTP GET /config/display_brightness/%ld request received.", newBrightness);
+    if (newBrightness < 0 || newBrightness > 255) {
+        sendError(client, 400, "Brightness value must be between 0 and 255.", request.keepAlive);
         return;
     }
 
-    // logInfo("New HTTP client.");
-    
-    // Wait for data to be available
-    unsigned long timeout = millis() + 200; // 200ms timeout
-    while(!client.available() && millis() < timeout) {
-        delay(1);
+    logInfo("Updating brightness from:%d to: %ld", displayBrightness, newBrightness);
+    // Applied to the strip by the render task
+    displayBrightness = newBrightness;
+    notifyStatusChanged();
+    logInfo("Display brightness set to: %ld", newBrightness);
+
+    char body[96];
+    snprintf(body, sizeof(body), "{\"status\":\"ok\", \"variable\":\"displayBrightness\", \"new_value\":\"%ld\"}", newBrightness);
+    sendJson(client, 200, body, request.keepAlive);
+}
+
+static void handleLogLevel(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred) {
+    LogLevel level;
+    if (!parseLogLevel(params.text[0], level)) {
+        sendError(client, 400, "Log level must be debug, info, warning or error.", request.keepAlive);
+        return;
     }
-    if(!client.available()){
-        logWarning("HTTP client connected but sent no data.");
-        client.stop();
+
+    logInfo("Log level set to: %s", logLevelName(level));
+    logRuntimeLevel = level;
+    notifyStatusChanged();
+
+    char body[96];
+    snprintf(body, sizeof(body), "{\"status\":\"ok\", \"variable\":\"log_level\", \"new_value\":\"%s\"}", logLevelName(level));
+    sendJson(client, 200, body, request.keepAlive);
+}
+
+static void handleUpdateState(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred) {
+    long sensorId = params.number[0];
+    logInfo("HTTP GET /config/update_state/%ld/%s request received.", sensorId, params.text[1]);
+    if (sensorId < 1 || sensorId > entityCount) {
+        sendError(client, 400, "Unknown sensor. Use /config/update_state/<id>/<value>", request.keepAlive);
         return;
     }
 
-    // Read the first line of the request
-    String req = client.readStringUntil('\r');
-    client.flush(); // Clear the rest of the request from the buffer
-
-    // Match the request
-    if (req.indexOf("GET / ") != -1) {
-        client.println(F("HTTP/1.1 200 OK"));
-        client.println(F("Content-Type: text/html"));
-        client.println(F("Connection: close"));
-        client.println();
-        client.print(index_html);
-    } else if (req.indexOf("GET /status") != -1) {
-        // Send HTTP headers
-        client.println("HTTP/1.1 200 OK");
-        client.println("Content-Type: application/json");
-        client.println("Access-Control-Allow-Origin: *");
-        client.println("Connection: close");
-        client.println();
-
-        // Create JSON response
-        DynamicJsonDocument jsonDoc(4096);
-        jsonDoc["uptime"] = millis() / 1000;
-        jsonDoc["ip_address"] = WiFi.localIP().toString();
-        jsonDoc["wifi_connected"] = wifi_connected;
-        jsonDoc["ws_connected"] = ws_connected;
-        jsonDoc["sensor_1_state"] = sensor_1_state;
-        jsonDoc["sensor_2_state"] = sensor_2_state;
-        jsonDoc["displayBrightness"] = displayBrightness;
-        jsonDoc["should_render"] = should_render;
-        jsonDoc["free_heap"] = ESP.getFreeHeap();
-        jsonDoc["wifi_last_connect_attempt"] = wifiLastConnectAttempt / 1000;
-        jsonDoc["current_time"] = timeClient.getFormattedTime();
-
-        JsonArray logData = jsonDoc.createNestedArray("logBuffer");
-        for (int i = 0; i < LOG_BUFFER_SIZE; i++) {
-            if (logBuffer[i][0] != '\0') {
-                logData.add(logBuffer[i]);
+    setEntityState(sensorId - 1, internState(params.text[1]));
+    const char* newState = stateName(entityStates[sensorId - 1]);
+    logInfo("Manually updated sensor %ld state to: %s", sensorId, newState);
+
+    char body[96];
+    snprintf(body, sizeof(body), "{\"status\":\"ok\", \"sensor_id\":%ld, \"new_state\":\"%s\"}", sensorId, newState);
+    sendJson(client, 200, body, request.keepAlive);
+}
+
+static void handleBoot(WiFiClient& client, HttpRequestParser& request, const RouteParams& params, HttpBody& deferred) {
+    logInfo("HTTP /boot request received. Rebooting system.");
+    sendJson(client, 200, "{\"status\":\"ok\", \"action\":\"boot\"}", false);
+    flushWarmState();
+    delay(100);
+    ESP.restart();
+}
+
+// First match wins
+static const HttpRoute routes[] = {
+    { HTTP_METHOD_GET,                  "/",                                handleIndex },
+    { HTTP_METHOD_GET,                  "/status",                          handleStatus },
+    { HTTP_METHOD_GET,                  "/metrics",                         handleMetrics },
+    { HTTP_METHOD_GET,                  "/history",                         handleHistory },
+    { HTTP_METHOD_GET,                  "/beep",                            handleBeep },
+    { HTTP_METHOD_GET,                  "/config/display_brightness/{int}", handleDisplayBrightness },
+    { HTTP_METHOD_GET,                  "/config/log_level/{str}",          handleLogLevel },
+    { HTTP_METHOD_GET,                  "/config/update_state/{int}/{str}", handleUpdateState },
+    { HTTP_METHOD_GET | HTTP_METHOD_POST, "/boot",                          handleBoot },
+};
+
+static void dispatchRequest(HttpConnection& conn) {
+    WiFiClient& client = conn.client;
+    HttpRequestParser& request = conn.parser;
+    PerfScope requestPerf(PERF_HTTP_REQUEST);
+    RouteParams params;
+    const HttpRoute* found = nullptr;
+    bool pathMatched = false;
+    {
+        PerfScope perf(PERF_HTTP_ROUTE);
+        for (const HttpRoute& route : routes) {
+            if (!matchRoute(route.pattern, request.path, params)) {
+                continue;
+            }
+            pathMatched = true;
+            if (route.methods & request.method) {
+                found = &route;
+                break;
             }
         }
+    }
+
+    if (found != nullptr) {
+        found->handler(client, request, params, conn.body);
+        return;
+    }
+
+    if (pathMatched) {
+        sendError(client, 405, "Method not allowed.", request.keepAlive);
+        return;
+    }
+    logWarning("HTTP 404 Not Found: %s", request.path);
+    static const char notFound[] = "<!DOCTYPE html><html><head><title>Not Found</title></head><body><h1>404 Not Found</h1></body></html>";
+    BufferedPrint out(client);
+    sendHead(out, 404, "text/html", sizeof(notFound) - 1, request.keepAlive);
+    out.print(notFound);
+}
+
+// --- Connection Handling ---
+
+static void closeConnection(HttpConnection& conn) {
+    conn.client.stop();
+    conn.active = false;
+    conn.body.data = nullptr;
+}
+
+static void acceptConnections(unsigned long now) {
+    while (server.hasClient()) {
+        WiFiClient client = server.available();
+        if (!client) {
+            break;
+        }
 
-        JsonArray displayData = jsonDoc.createNestedArray("displayArray");
-        for (int i = 0; i < MATRIX_HEIGHT; i++) {
-            JsonArray row = displayData.createNestedArray();
-            for (int j = 0; j < MATRIX_WIDTH; j++) {
-                Color colorValue = (Color)displayArray[i][j];
-                uint32_t rgbColor = translateColor(colorValue);
-                rgbColor = highlightPixel(i, j, rgbColor);
-                row.add(rgbColor);
+        HttpConnection* slot = nullptr;
+        for (HttpConnection& conn : connections) {
+            if (!conn.active) {
+                slot = &conn;
+                break;
             }
         }
+        if (slot == nullptr) {
+            // Answer right away rather than letting it wait behind busy slots
+            sendError(client, 503, "Too many connections.", false);
+            client.stop();
+            continue;
+        }
 
-        String response;
-        serializeJson(jsonDoc, response);
-        client.print(response);
-
-    } else if (req.indexOf("GET /beep") != -1) {
-        logInfo("HTTP GET /beep request received.");
-        playSound();
-        client.println("HTTP/1.1 200 OK");
-        client.println("Content-Type: application/json");
-        client.println("Access-Control-Allow-Origin: *");
-        client.println("Connection: close");
-        client.println();
-        client.print("{\"status\":\"ok\", \"action\":\"beep\"}");
-
-    } else if (req.indexOf("GET /config/display_brightness/") != -1) {
-    req.replace(" HTTP/1.1", "");
-    String valueStr = req.substring(req.lastIndexOf('/') + 1);
-        int spaceIndex = valueStr.indexOf(' ');
-        if (spaceIndex != -1) {
-            valueStr = valueStr.substring(0, spaceIndex);
-        }
-        logDebug(req.substring(0, 100));
-        logDebug(req.substring(req.lastIndexOf('/') + 1));
-        
-        int newBrightness = valueStr.toInt();
-        logInfo(String("HTTP GET /config/display_brightness/") + newBrightness + " request received.");
-        logInfo(String("Updating brightness from:") + displayBrightness + " to: " + newBrightness);
-
-        if (newBrightness >= 0 && newBrightness <= 255) {
-            displayBrightness = newBrightness;
-            strip.setBrightness(displayBrightness);
-            logInfo("Display brightness set to: " + String(newBrightness));
-
-            client.println("HTTP/1.1 200 OK");
-            client.println("Content-Type: application/json");
-            client.println("Access-Control-Allow-Origin: *");
-            client.println("Connection: close");
-            client.println();
-            client.print("{\"status\":\"ok\", \"variable\":\"displayBrightness\", \"new_value\":\"" + String(newBrightness) + "\"}");
-        } else {
-            client.println("HTTP/1.1 400 Bad Request");
-            client.println("Content-Type: application/json");
-            client.println("Access-Control-Allow-Origin: *");
-            client.println("Connection: close");
-            client.println();
-            client.print("{\"status\":\"error\", \"message\":\"Brightness value must be between 0 and 255.\"}");
-        }
-
-    } else if (req.indexOf("GET /config/update_state/") != -1) {
-        req.replace(" HTTP/1.1", "");
-        int startIndex = req.indexOf("/update_state/");
-
-        String params = req.substring(startIndex + String("/update_state/").length());
-        int slashIndex = params.indexOf("/");
-
-        int sensorId = params.substring(0, slashIndex).toInt();
-        String sensorState = params.substring(slashIndex + 1);
-        logInfo(String("HTTP GET /config/update_state/") + sensorId + "/" + sensorState + " request received.");
-
-        if (sensorId == 1) {
-            strcpy(sensor_1_state, sensorState.c_str());
-            logInfo("Manually updated sensor 1 state to: " + sensorState);
-            client.println("HTTP/1.1 200 OK");
-            client.println("Content-Type: application/json");
-            client.println("Access-Control-Allow-Origin: *");
-            client.println("Connection: close");
-            client.println();
-            client.print("{\"status\":\"ok\", \"sensor_id\":1, \"new_state\":\"" + sensorState + "\"}");
-        } else if (sensorId == 2) {
-            strcpy(sensor_2_state, sensorState.c_str());
-            logInfo("Manually updated sensor 2 state to: " + sensorState);
-            client.println("HTTP/1.1 200 OK");
-            client.println("Content-Type: application/json");
-            client.println("Access-Control-Allow-Origin: *");
-            client.println("Connection: close");
-            client.println();
-            client.print("{\"status\":\"ok\", \"sensor_id\":2, \"new_state\":\"" + sensorState + "\"}");
-        }  else {
-            logWarning("HTTP/1.1 400 Bad Request");
-            client.println("HTTP/1.1 400 Bad Request");
-            client.println("Content-Type: application/json");
-            client.println("Access-Control-Allow-Origin: *");
-            client.println("Connection: close");
-            client.println();
-            client.print("{\"status\":\"error\", \"message\":\"Malformed URL. Use /config/updatestate/<id>/<value>\"}");
-        }
-    } else if (req.indexOf("POST /boot") != -1 || req.indexOf("GET /boot") != -1) {
-            logInfo("HTTP /boot request received. Rebooting system.");
-            client.println("HTTP/1.1 200 OK");
-            client.println("Content-Type: application/json");
-            client.println("Access-Control-Allow-Origin: *");
-            client.println("Connection: close");
-            client.println();
-            client.print("{\"status\":\"ok\", \"action\":\"boot\"}");
-            delay(100);
-            ESP.restart();
-    } else {
-        logWarning("HTTP/1.1 404 Not Found");
-        // Send 404 Not Found
-        client.println("HTTP/1.1 404 Not Found");
-        client.println("Content-Type: text/html");
-        client.println("Access-Control-Allow-Origin: *");
-        client.println("Connection: close");
-        client.println();
-        client.println("<!DOCTYPE html><html><head><title>Not Found</title></head><body><h1>404 Not Found</h1></body></html>");
+        slot->active = true;
+        slot->inRequest = false;
+        slot->requests = 0;
+        slot->lastActivity = now;
+        slot->client = client;
+        slot->parser.reset();
+        slot->body.data = nullptr;
+        slot->inputLength = 0;
+        slot->inputOffset = 0;
+    }
+}
+
+// After the whole response is out; false when the connection was closed
+static bool finishResponse(HttpConnection& conn) {
+    conn.requests++;
+    if (!conn.parser.keepAlive || conn.requests >= HTTP_KEEPALIVE_MAX) {
+        closeConnection(conn);
+        return false;
+    }
+    conn.parser.reset();
+    conn.inRequest = false;
+    return true;
+}
+
+// Writes blocks while the socket has room for them, so the pass never
+// waits on a client; the rest goes out on the following passes
+static void sendBody(HttpConnection& conn, unsigned long now) {
+    HttpBody& body = conn.body;
+    while (body.sent < body.length && socketWritable(conn.client.fd())) {
+        size_t block = min(body.length - body.sent, (size_t)HTTP_WRITE_BLOCK);
+        size_t written = conn.client.write(body.data + body.sent, block);
+        if (written == 0) {
+            break;
+        }
+        body.sent += written;
+        conn.lastActivity = now;
     }
 
-    delay(1); // Give the client time to receive the data
-    client.stop();
-    // logInfo("HTTP client disconnected.");
+    if (body.sent < body.length) {
+        if (!conn.client.connected() || now - conn.lastActivity >= HTTP_WRITE_TIMEOUT) {
+            logWarning("HTTP client stalled while sending %s", conn.parser.path);
+            closeConnection(conn);
+        }
+        return;
+    }
+    logDebug("Served %s (%u bytes) in %lu ms", conn.parser.path, (unsigned)body.length, millis() - conn.requestStart);
+    body.data = nullptr;
+    finishResponse(conn);
+}
+
+static void serviceConnection(HttpConnection& conn, unsigned long now) {
+    if (conn.body.data != nullptr) {
+        sendBody(conn, now);
+        return;
+    }
+
+    if (conn.inputOffset == conn.inputLength) {
+        int available = conn.client.available();
+        if (available <= 0) {
+            if (!conn.client.connected()) {
+                closeConnection(conn);
+            } else if (conn.inRequest && now - conn.requestStart >= HTTP_REQUEST_TIMEOUT) {
+                sendError(conn.client, 408, "Request timeout.", false);
+                closeConnection(conn);
+            } else if (!conn.inRequest && now - conn.lastActivity >= HTTP_KEEPALIVE_TIMEOUT) {
+                closeConnection(conn);
+            }
+            return;
+        }
+
+        int length = conn.client.read((uint8_t*)conn.input, min(available, (int)sizeof(conn.input)));
+        if (length <= 0) {
+            return;
+        }
+        conn.inputLength = length;
+        conn.inputOffset = 0;
+        conn.lastActivity = now;
+    }
+
+    // A block may end mid-request or hold several pipelined requests
+    while (conn.inputOffset < conn.inputLength) {
+        if (!conn.inRequest) {
+            conn.inRequest = true;
+            conn.requestStart = now;
+        }
+        conn.inputOffset += conn.parser.feed(conn.input + conn.inputOffset, conn.inputLength - conn.inputOffset);
+
+        if (conn.parser.isError()) {
+            sendError(conn.client, conn.parser.errorStatus(), "Malformed request.", false);
+            closeConnection(conn);
+            return;
+        }
+        if (!conn.parser.isComplete()) {
+            continue;
+        }
+
+        dispatchRequest(conn);
+        if (conn.body.data != nullptr) {
+            // The rest of the block waits for the body
+            sendBody(conn, now);
+            return;
+        }
+        if (!finishResponse(conn)) {
+            return;
+        }
+    }
+}
+
+void handleHttpRequests() {
+    unsigned long now = millis();
+    acceptConnections(now);
+    for (HttpConnection& conn : connections) {
+        if (conn.active) {
+            serviceConnection(conn, now);
+        }
+    }
 }
 
 void handleWebSocketStatus(uint8_t num) {
-    DynamicJsonDocument jsonDoc(4096);
-    jsonDoc["uptime"] = millis() / 1000;
-    jsonDoc["ip_address"] = WiFi.localIP().toString();
-    jsonDoc["wifi_connected"] = wifi_connected;
-    jsonDoc["ws_connected"] = ws_connected;
-    jsonDoc["sensor_1_state"] = sensor_1_state;
-    jsonDoc["sensor_2_state"] = sensor_2_state;
-    jsonDoc["displayBrightness"] = displayBrightness;
-    jsonDoc["should_render"] = should_render;
-    jsonDoc["free_heap"] = ESP.getFreeHeap();
-    jsonDoc["wifi_last_connect_attempt"] = wifiLastConnectAttempt / 1000;
-    jsonDoc["current_time"] = timeClient.getFormattedTime();
+    size_t length;
+    const char* response = getStatusJson(length);
+    if (response != nullptr) {
+        webSocket.sendTXT(num, response, length);
+    }
+}
 
-    JsonArray logData = jsonDoc.createNestedArray("logBuffer");
-    for (int i = 0; i < LOG_BUFFER_SIZE; i++) {
-        if (logBuffer[i][0] != '\0') {
-            logData.add(logBuffer[i]);
+// --- Push Subscriptions ---
+// Clients that sent "subscribe" get one full snapshot followed by deltas
+// when the status changes, plus a binary frame whenever the display changes.
+// The two are independent: blended frames change the display on most ticks
+// but not the status. Each tick the delta and the frame are encoded once and
+// shared by every subscriber.
+//
+// Sends are synchronous, so a client is only sent to while its socket has
+// room (PushServer::writable()). One whose send buffer is full is skipped,
+// and what it misses is coalesced once it drains: the latest frame for the
+// frames, and one full snapshot if a delta it missed carried changes (a
+// heartbeat with only uptime, heap and time is just skipped). A client whose
+// buffer stays full for WS_STALL_TIMEOUT is disconnected. A full snapshot
+// can be larger than the send buffer and then waits for the client's ACKs
+// like any TCP write; a client that stops reading in the middle of one is
+// dropped by the library when the write times out.
+struct WsSubscriber {
+    bool subscribed;
+    bool needsFull;  // Missed a delta, or just subscribed
+    bool needsFrame;
+    bool blocked;
+    unsigned long blockedSince;
+};
+
+static WsSubscriber wsSubscribers[WEBSOCKETS_SERVER_CLIENT_MAX];
+static unsigned long lastPushCheck = 0;
+static unsigned long lastPush = 0;
+static uint32_t lastPushedVersion = 0;
+static unsigned long lastPushedFrame = 0;
+static uint32_t framesPushed = 0; // Frame numbers on the wire, so gaps mean lost pushes
+static uint8_t framePayload[FRAME_RLE_RGB_MAX_SIZE(MATRIX_WIDTH, MATRIX_HEIGHT)];
+
+// A subscriber with a full send buffer, dropped once it has stayed full
+static void holdBack(WsSubscriber& sub, uint8_t num, unsigned long now) {
+    if (!sub.blocked) {
+        sub.blocked = true;
+        sub.blockedSince = now;
+    } else if (now - sub.blockedSince >= WS_STALL_TIMEOUT) {
+        logWarning("WebSocket client %d stopped reading, disconnecting", num);
+        sub.subscribed = false;
+        webSocket.disconnect(num);
+    }
+}
+
+static void pushStatusUpdates() {
+    unsigned long now = millis();
+    if (now - lastPushCheck < WS_PUSH_INTERVAL) {
+        return;
+    }
+
+    bool anySynced = false;
+    bool anyNeedsFull = false;
+    bool anyNeedsFrame = false;
+    for (const WsSubscriber& sub : wsSubscribers) {
+        if (sub.subscribed) {
+            anySynced = anySynced || !sub.needsFull;
+            anyNeedsFull = anyNeedsFull || sub.needsFull;
+            anyNeedsFrame = anyNeedsFrame || sub.needsFrame;
         }
     }
+    if (!anySynced && !anyNeedsFull) {
+        return;
+    }
+    lastPushCheck = now;
+
+    uint32_t version = getStatusVersion();
+    bool heartbeat = now - lastPush >= WS_HEARTBEAT_INTERVAL;
+    bool statusChanged = version != lastPushedVersion || heartbeat;
+    bool frameChanged = framesShown != lastPushedFrame;
+    if (!statusChanged && !frameChanged && !anyNeedsFull && !anyNeedsFrame) {
+        return;
+    }
+
+    // Both live in static buffers (see status.h); nullptr if one did not fit
+    const char* delta = nullptr;
+    size_t deltaLength = 0;
+    bool deltaChanges = false;
+    if (anySynced && statusChanged) {
+        delta = buildStatusDelta(deltaLength, deltaChanges);
+    }
+
+    size_t frameLength = 0;
+    if (frameChanged || anyNeedsFrame) {
+        // The display runs faster than the push rate; only the latest frame is sent
+        frameLength = encodeDisplayFrame(framePayload, sizeof(framePayload), ++framesPushed);
+    }
 
-    JsonArray displayData = jsonDoc.createNestedArray("displayArray");
-    for (int i = 0; i < MATRIX_HEIGHT; i++) {
-        JsonArray row = displayData.createNestedArray();
-        for (int j = 0; j < MATRIX_WIDTH; j++) {
-            Color colorValue = (Color)displayArray[i][j];
-            uint32_t rgbColor = translateColor(colorValue);
-            rgbColor = highlightPixel(i, j, rgbColor);
-            row.add(rgbColor);
+    for (int i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; i++) {
+        WsSubscriber& sub = wsSubscribers[i];
+        if (!sub.subscribed) {
+            continue;
+        }
+        bool sendStatus = sub.needsFull || statusChanged;
+        bool sendFrame = frameLength > 0 && (frameChanged || sub.needsFrame);
+        if (!sendStatus && !sendFrame) {
+            continue;
+        }
+
+        if (!webSocket.writable(i)) {
+            sub.needsFull = sub.needsFull || (statusChanged && (deltaChanges || delta == nullptr));
+            sub.needsFrame = sub.needsFrame || sendFrame;
+            holdBack(sub, i, now);
+            continue;
+        }
+        sub.blocked = false;
+
+        // A frame and a delta fit the room writable() guarantees
+        if (sendFrame) {
+            sub.needsFrame = !webSocket.sendBIN(i, framePayload, frameLength);
+        }
+        if (!sendStatus || !sub.subscribed) {
+            continue;
+        }
+        if (sub.needsFull) {
+            size_t fullLength;
+            const char* full = getStatusJson(fullLength);
+            sub.needsFull = full == nullptr || !webSocket.sendTXT(i, full, fullLength);
+        } else {
+            sub.needsFull = delta == nullptr || !webSocket.sendTXT(i, delta, deltaLength);
         }
     }
 
-    String response;
-    serializeJson(jsonDoc, response);
-    webSocket.sendTXT(num, response);
+    if (statusChanged || anyNeedsFull) {
+        markStatusPushed();
+        lastPushedVersion = version;
+        lastPush = now;
+    }
+    lastPushedFrame = framesShown;
+}
+
+uint32_t getFramesPushed() {
+    return framesPushed;
 }
 
 void handleWebSocketEvents(uint8_t num, WStype_t type, uint8_t * payload, size_t length) {
@@ -240,8 +607,18 @@ void handleWebSocketEvents(uint8_t num, WStype_t type, uint8_t * payload, size_t
         case WStype_TEXT:
             if (length > 0 && strncmp((char*)payload, "status", 6) == 0) {
                 handleWebSocketStatus(num);
+            } else if (length >= 9 && strncmp((char*)payload, "subscribe", 9) == 0) {
+                wsSubscribers[num].subscribed = true;
+                wsSubscribers[num].needsFull = true;
+                wsSubscribers[num].needsFrame = true;
+                wsSubscribers[num].blocked = false;
+            } else if (length >= 11 && strncmp((char*)payload, "unsubscribe", 11) == 0) {
+                wsSubscribers[num].subscribed = false;
             }
             break;
+        case WStype_DISCONNECTED:
+            wsSubscribers[num].subscribed = false;
+            break;
         default:
             break;
     }
@@ -249,4 +626,5 @@ void handleWebSocketEvents(uint8_t num, WStype_t type, uint8_t * payload, size_t
 
 void handleWebSocket() {
     webSocket.loop();
+    pushStatusUpdates();
 }
@@ -6,5 +6,6 @@
 void setupHttpServer();
 void handleHttpRequests();
 void handleWebSocket();
+uint32_t getFramesPushed();
 
 #endif // HTTP_SERVER_H
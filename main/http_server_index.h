@@ -1,3 +1,175 @@
 const char index_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE html><html lang="en"><head><meta charset="UTF-8"><title>Charger Display</title><script src="https://cdn.tailwindcss.com"></script><style>.log-info{color:green}.log-warning{color:orange}.log-error{color:red}.log-debug{color:gray}</style></head><body class="flex flex-col items-center justify-center min-h-screen bg-gray-100 space-y-6 p-4"><div class="flex space-x-6 bg-white p-4 rounded-lg shadow-md"><div><h2 class="text-lg font-semibold mb-2">Display</h2><div id="matrix" class="grid grid-cols-8 gap-1"></div></div><div class="space-y-2"><h2 class="text-lg font-semibold mb-2">Status</h2><div><strong>Date Time:</strong> <span id="current_time">-</span></div><div><strong>Uptime:</strong> <span id="uptime">-</span></div><div><strong>Wifi Uptime:</strong> <span id="wifi_last_connect_attempt">-</span></div><div><strong>IP Address:</strong> <span id="ip_address">-</span></div><div><strong>HASS Connected:</strong> <span id="ws_connected">-</span></div><div><strong>Free Heap:</strong> <span id="free_heap">-</span></div><div><label class="font-semibold">Sensor 1 State:</label> <select id="sensor_1_state" class="border rounded p-1"><option value="unknown">unknown</option><option value="off">off</option><option value="disconnected">disconnected</option><option value="charging">charging</option></select></div><div><label class="font-semibold">Sensor 2 State:</label> <select id="sensor_2_state" class="border rounded p-1"><option value="unknown">unknown</option><option value="off">off</option><option value="disconnected">disconnected</option><option value="charging">charging</option></select></div><div><label class="font-semibold">Display Brightness:</label> <input id="displayBrightness" type="range" min="1" max="253" class="w-40"> <span id="brightnessValue">-</span></div></div></div><div class="bg-gray-50 p-2 rounded-lg shadow-md max-w-3xl w-full"><h2 class="text-sm font-semibold mb-1">Logs</h2><div id="logs" class="font-mono text-xs space-y-1 max-h-80 overflow-y-auto"></div></div><button id="restartBtn" title="Restart" class="fixed top-4 right-4 z-50 bg-white border border-gray-300 shadow-lg rounded-full p-3 hover:bg-red-100 transition" style="font-size:2rem">🔄</button><script>let ws,statusInterval,messagesThisSecond=0;function connectWebSocket(){(ws=new WebSocket("ws://charger.home:81/")).onopen=()=>{console.log("✅ WebSocket connected"),ws.send("status"),statusInterval=setInterval(()=>{ws.readyState===WebSocket.OPEN&&ws.send("status")},1e3)},ws.onmessage=t=>{messagesThisSecond++;try{var o=JSON.parse(t.data);if("number"==typeof o.uptime){var a=o.uptime,r=Math.floor(a/86400),l=Math.floor(a%86400/3600),c=Math.floor(a%3600/60);let e="";0<r&&(e+=r+"d "),(0<l||0<r)&&(e+=l+"h "),e+=c+"m",document.getElementById("uptime").textContent=e}else document.getElementById("uptime").textContent="-";if("number"==typeof o.wifi_last_connect_attempt){var d=o.wifi_last_connect_attempt,m=Math.floor(d/86400),i=Math.floor(d%86400/3600),g=Math.floor(d%3600/60);let e="";0<m&&(e+=m+"d "),(0<i||0<m)&&(e+=i+"h "),e+=g+"m",document.getElementById("wifi_last_connect_attempt").textContent=e}else document.getElementById("wifi_last_connect_attempt").textContent="-";document.getElementById("current_time").textContent=o.current_time??"-",document.getElementById("ip_address").textContent=o.ip_address??"-",document.getElementById("ws_connected").textContent=o.ws_connected?"Yes":"No","number"==typeof o.free_heap?document.getElementById("free_heap").textContent=(o.free_heap/1024).toFixed(1)+" KB":document.getElementById("free_heap").textContent=o.free_heap??"-",o.sensor_1_state&&(document.getElementById("sensor_1_state").value=o.sensor_1_state),o.sensor_2_state&&(document.getElementById("sensor_2_state").value=o.sensor_2_state),void 0!==o.displayBrightness&&(document.getElementById("displayBrightness").value=o.displayBrightness,document.getElementById("brightnessValue").textContent=o.displayBrightness);let s=document.getElementById("matrix"),n=(s.innerHTML="",o.displayArray.forEach(e=>{e.forEach(e=>{var t=e>>16&255,n=e>>8&255,e=255&e,o=document.createElement("div");o.style.backgroundColor=`rgb(${t}, ${n}, ${e})`,o.className="w-8 h-8 border border-gray-200",s.appendChild(o)})}),document.getElementById("logs"));n.innerHTML="",o.logBuffer&&o.logBuffer.slice().reverse().forEach(e=>{var t=document.createElement("div");e.includes(" INFO: ")?t.className="log-info":e.includes(" WARNING: ")?t.className="log-warning":e.includes(" ERROR: ")?t.className="log-error":e.includes(" DEBUG: ")&&(t.className="log-debug"),t.textContent=e,n.appendChild(t)})}catch(e){console.error("JSON parse error:",e,t.data)}},ws.onclose=()=>{console.log("⚠️ WebSocket disconnected, retrying in 2s..."),clearInterval(statusInterval),setTimeout(connectWebSocket,2e3)},ws.onerror=e=>{console.error("❌ WebSocket error:",e),ws.close()}}connectWebSocket(),document.getElementById("sensor_1_state").addEventListener("change",e=>{let t=e.target.value;fetch("http://charger.local/config/update_state/1/"+t).then(()=>console.log("Sensor 1 atualizado:",t))}),document.getElementById("sensor_2_state").addEventListener("change",e=>{let t=e.target.value;fetch("http://charger.local/config/update_state/2/"+t).then(()=>console.log("Sensor 2 atualizado:",t))}),document.getElementById("displayBrightness").addEventListener("input",e=>{e=e.target.value;document.getElementById("brightnessValue").textContent=e}),document.getElementById("displayBrightness").addEventListener("change",e=>{let t=e.target.value;fetch("http://charger.local/config/display_brightness/"+t).then(()=>console.log("Brilho atualizado:",t))}),document.getElementById("restartBtn").addEventListener("click",function(){confirm("Are you sure you want to restart the system?")&&fetch("http://charger.local/boot",{method:"POST"}).then(e=>e.json()).then(e=>{alert("Restart command sent! System will reboot.")}).catch(e=>{alert("Failed to send restart command: "+e)})})</script></body></html>
+<!DOCTYPE html><html lang="en"><head><meta charset="UTF-8"><title>Charger Display</title><script src="https://cdn.tailwindcss.com"></script><style>.log-info{color:green}.log-warning{color:orange}.log-error{color:red}.log-debug{color:gray}</style></head><body class="flex flex-col items-center justify-center min-h-screen bg-gray-100 space-y-6 p-4"><div class="flex space-x-6 bg-white p-4 rounded-lg shadow-md"><div><h2 class="text-lg font-semibold mb-2">Display</h2><div id="matrix" class="grid grid-cols-8 gap-1"></div></div><div class="space-y-2"><h2 class="text-lg font-semibold mb-2">Status</h2><div><strong>Date Time:</strong> <span id="current_time">-</span></div><div><strong>Uptime:</strong> <span id="uptime">-</span></div><div><strong>Wifi Uptime:</strong> <span id="wifi_last_connect_attempt">-</span></div><div><strong>IP Address:</strong> <span id="ip_address">-</span></div><div><strong>HASS Connected:</strong> <span id="ws_connected">-</span></div><div><strong>Free Heap:</strong> <span id="free_heap">-</span></div><div><label class="font-semibold">Sensor 1 State:</label> <select id="sensor_1_state" class="border rounded p-1"><option value="unknown">unknown</option><option value="off">off</option><option value="disconnected">disconnected</option><option value="charging">charging</option></select></div><div><label class="font-semibold">Sensor 2 State:</label> <select id="sensor_2_state" class="border rounded p-1"><option value="unknown">unknown</option><option value="off">off</option><option value="disconnected">disconnected</option><option value="charging">charging</option></select></div><div><label class="font-semibold">Display Brightness:</label> <input id="displayBrightness" type="range" min="1" max="253" class="w-40"> <span id="brightnessValue">-</span></div></div></div><div class="bg-gray-50 p-2 rounded-lg shadow-md max-w-3xl w-full"><h2 class="text-sm font-semibold mb-1">Logs</h2><div id="logs" class="font-mono text-xs space-y-1 max-h-80 overflow-y-auto"></div></div><button id="restartBtn" title="Restart" class="fixed top-4 right-4 z-50 bg-white border border-gray-300 shadow-lg rounded-full p-3 hover:bg-red-100 transition" style="font-size:2rem">🔄</button><script>let ws,messagesThisSecond=0,logLines=[],lastFrameNumber=null,framesMissed=0;const PALETTE=[0,16777215,16711680,65280,255,16776960,65535,16711935];function formatDuration(e){var t=Math.floor(e/86400),n=Math.floor(e%86400/3600),e=Math.floor(e%3600/60);let o="";return 0<t&&(o+=t+"d "),(0<n||0<t)&&(o+=n+"h "),o+=e+"m"}function setText(e,t){document.getElementById(e).textContent=t}function applyStatus(e){"uptime"in e&&setText("uptime","number"==typeof e.uptime?formatDuration(e.uptime):"-"),"wifi_last_connect_attempt"in e&&setText("wifi_last_connect_attempt","number"==typeof e.wifi_last_connect_attempt?formatDuration(e.wifi_last_connect_attempt):"-"),"current_time"in e&&setText("current_time",e.current_time??"-"),"ip_address"in e&&setText("ip_address",e.ip_address??"-"),"ws_connected"in e&&setText("ws_connected",e.ws_connected?"Yes":"No"),"free_heap"in e&&setText("free_heap","number"==typeof e.free_heap?(e.free_heap/1024).toFixed(1)+" KB":e.free_heap??"-"),e.sensor_1_state&&(document.getElementById("sensor_1_state").value=e.sensor_1_state),e.sensor_2_state&&(document.getElementById("sensor_2_state").value=e.sensor_2_state),void 0!==e.displayBrightness&&(document.getElementById("displayBrightness").value=e.displayBrightness,setText("brightnessValue",e.displayBrightness)),e.displayArray&&renderMatrix(e.displayArray),e.logBuffer?(logLines=e.logBuffer.slice().reverse(),renderLogs()):e.logs&&(e.logs.forEach(e=>logLines.push(e.line)),logLines=logLines.slice(-30),renderLogs())}function highlightColor(e){var t=e=>Math.min(255,e+50);return t(e>>16&255)<<16|t(e>>8&255)<<8|t(255&e)}function decodeFrame(e){var t=new Uint8Array(e),n=new DataView(e).getUint32(1,!0),o=t[0],a=t[5],r=t[6],l=[];if(1===o){var c=t[7],d=t[8];for(let e=0;e<a*r;e++){var i=t[9+(e>>1)],i=PALETTE[e%2==0?i>>4:15&i]??0;l.push(e%a===c&&Math.floor(e/a)===d?highlightColor(i):i)}}else{if(2!==o)return null;for(let n=7;n+3<t.length;n+=4){var s=t[n+1]<<16|t[n+2]<<8|t[n+3];for(let e=0;e<t[n];e++)l.push(s)}}var m=[];for(let e=0;e<r;e++)m.push(l.slice(e*a,(e+1)*a));return{frameNumber:n,rows:m}}function applyFrame(e){e=decodeFrame(e);e&&(null!==lastFrameNumber&&e.frameNumber>lastFrameNumber+1&&(framesMissed+=e.frameNumber-lastFrameNumber-1,console.log("Frames missed: "+framesMissed)),lastFrameNumber=e.frameNumber,renderMatrix(e.rows))}function renderMatrix(e){let s=document.getElementById("matrix");s.innerHTML="";var t=e.length?e[0].length:8;s.style.gridTemplateColumns=`repeat(${t}, minmax(0, 1fr))`,e.forEach(e=>{e.forEach(e=>{var t=e>>16&255,n=e>>8&255,e=255&e,o=document.createElement("div");o.style.backgroundColor=`rgb(${t}, ${n}, ${e})`,o.className="w-8 h-8 border border-gray-200",s.appendChild(o)})})}function renderLogs(){let n=document.getElementById("logs");n.innerHTML="",logLines.forEach(e=>{var t=document.createElement("div");e.includes(" INFO: ")?t.className="log-info":e.includes(" WARNING: ")?t.className="log-warning":e.includes(" ERROR: ")?t.className="log-error":e.includes(" DEBUG: ")&&(t.className="log-debug"),t.textContent=e,n.appendChild(t)})}function connectWebSocket(){(ws=new WebSocket("ws://charger.home:81/")).binaryType="arraybuffer",ws.onopen=()=>{console.log("✅ WebSocket connected"),ws.send("subscribe")},ws.onmessage=t=>{if(messagesThisSecond++,t.data instanceof ArrayBuffer)applyFrame(t.data);else try{applyStatus(JSON.parse(t.data))}catch(e){console.error("JSON parse error:",e,t.data)}},ws.onclose=()=>{console.log("⚠️ WebSocket disconnected, retrying in 2s..."),setTimeout(connectWebSocket,2e3)},ws.onerror=e=>{console.error("❌ WebSocket error:",e),ws.close()}}connectWebSocket(),document.getElementById("sensor_1_state").addEventListener("change",e=>{let t=e.target.value;fetch("http://charger.local/config/update_state/1/"+t).then(()=>console.log("Sensor 1 atualizado:",t))}),document.getElementById("sensor_2_state").addEventListener("change",e=>{let t=e.target.value;fetch("http://charger.local/config/update_state/2/"+t).then(()=>console.log("Sensor 2 atualizado:",t))}),document.getElementById("displayBrightness").addEventListener("input",e=>{e=e.target.value;document.getElementById("brightnessValue").textContent=e}),document.getElementById("displayBrightness").addEventListener("change",e=>{let t=e.target.value;fetch("http://charger.local/config/display_brightness/"+t).then(()=>console.log("Brilho atualizado:",t))}),document.getElementById("restartBtn").addEventListener("click",function(){confirm("Are you sure you want to restart the system?")&&fetch("http://charger.local/boot",{method:"POST"}).then(e=>e.json()).then(e=>{alert("Restart command sent! System will reboot.")}).catch(e=>{alert("Failed to send restart command: "+e)})})</script></body></html>
 )rawliteral";
+
+// Generated by .githooks/pre-commit from control-panel/index.html
+#define INDEX_HTML_ETAG "\"c723d73c2d5d61f1\""
+#define INDEX_HTML_GZ_ETAG "\"80d8c46c3a7b64f6-gz\""
+const size_t index_html_gz_len = 2629;
+const uint8_t index_html_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xe5, 0x59, 0xdd, 0x6e, 0xe3, 0xb8,
+  0x15, 0xbe, 0xef, 0x53, 0x70, 0x88, 0x5d, 0x43, 0x5c, 0x4b, 0xb2, 0xec, 0xfc, 0x4c, 0xd6, 0x36,
+  0x15, 0xcc, 0x4f, 0xa6, 0x3b, 0xed, 0x4c, 0x66, 0x30, 0xc9, 0xec, 0x62, 0x61, 0x04, 0x19, 0x5a,
+  0x3a, 0x92, 0xb8, 0x23, 0x91, 0x06, 0x49, 0xc7, 0xf1, 0x7a, 0x7c, 0xd7, 0xde, 0x15, 0xe8, 0x4d,
+  0xaf, 0x8a, 0x16, 0xed, 0x63, 0xf4, 0x79, 0xf6, 0x05, 0xda, 0x47, 0x28, 0x28, 0xc9, 0xb6, 0xec,
+  0x38, 0xd9, 0x59, 0xb4, 0xe8, 0x4d, 0x11, 0x40, 0x11, 0xcf, 0x39, 0x3c, 0x3f, 0x1f, 0xc9, 0x73,
+  0x8e, 0xe8, 0x5f, 0x0d, 0x1f, 0x3d, 0x7f, 0xf3, 0xec, 0xf2, 0xfb, 0xb7, 0x67, 0x28, 0x33, 0x45,
+  0x1e, 0x0e, 0xed, 0x13, 0xe5, 0x4c, 0xa4, 0x14, 0x83, 0xc0, 0xe1, 0x30, 0x03, 0x16, 0x87, 0xc3,
+  0x02, 0x0c, 0x43, 0x51, 0xc6, 0x94, 0x06, 0x43, 0xf1, 0xfb, 0xcb, 0x17, 0xde, 0x09, 0x0e, 0x87,
+  0x86, 0x9b, 0x1c, 0xc2, 0x67, 0x19, 0x53, 0x29, 0x28, 0xf4, 0x9c, 0xeb, 0x49, 0xce, 0xe6, 0xc3,
+  0x4e, 0x45, 0x1e, 0xea, 0x48, 0xf1, 0x89, 0x41, 0x5a, 0x45, 0x14, 0x67, 0xc6, 0x4c, 0x74, 0xbf,
+  0xd3, 0x89, 0x62, 0xe1, 0x1b, 0xc6, 0xf3, 0x19, 0x17, 0x71, 0xa4, 0xb5, 0x1f, 0xc9, 0x02, 0x87,
+  0xc3, 0x4e, 0x25, 0x1a, 0x0e, 0xb5, 0x99, 0xe7, 0x10, 0xfa, 0xb9, 0x4c, 0x3d, 0x2e, 0x12, 0xb9,
+  0x88, 0x64, 0x2e, 0x55, 0x3f, 0x55, 0x00, 0x62, 0x59, 0x52, 0x67, 0x4c, 0x09, 0x2e, 0xd2, 0x9a,
+  0x21, 0x15, 0x13, 0x29, 0x54, 0x1c, 0x50, 0x4a, 0xaa, 0x9a, 0xae, 0x20, 0xae, 0x88, 0x31, 0x8c,
+  0xa7, 0xe9, 0x5a, 0x0b, 0x9b, 0x2f, 0x87, 0x9d, 0xca, 0xc4, 0xb0, 0x53, 0xc5, 0x35, 0x96, 0xf1,
+  0x1c, 0x45, 0x39, 0xd3, 0x9a, 0xe2, 0x24, 0x87, 0x5b, 0x64, 0x1f, 0x5e, 0x24, 0x73, 0xc4, 0x0d,
+  0x14, 0xda, 0x8b, 0x40, 0x18, 0x50, 0xe8, 0x87, 0xa9, 0x36, 0x3c, 0x99, 0xaf, 0x86, 0x05, 0x17,
+  0x5e, 0xe6, 0xe9, 0xc8, 0xfa, 0x85, 0xc6, 0xa9, 0x67, 0x55, 0x7b, 0xdd, 0x20, 0x40, 0x7a, 0xc2,
+  0x22, 0xf0, 0xe6, 0xde, 0x31, 0x9a, 0x78, 0x87, 0x38, 0x1c, 0xc6, 0xfc, 0x66, 0x4b, 0x7b, 0xc5,
+  0xbf, 0xf5, 0x8e, 0xed, 0xac, 0x59, 0xc6, 0x0d, 0x58, 0x41, 0xa4, 0xe4, 0x54, 0xc4, 0x10, 0x7b,
+  0x79, 0x8a, 0x74, 0xc6, 0x62, 0x39, 0xf3, 0x8a, 0xb8, 0x9a, 0x1d, 0x0e, 0xb3, 0xde, 0x4a, 0x83,
+  0x81, 0x5b, 0x63, 0x45, 0x12, 0x29, 0x8c, 0xa7, 0xa1, 0xe0, 0x63, 0x99, 0xc7, 0xa8, 0x18, 0x7b,
+  0x3d, 0x1c, 0xae, 0xb1, 0xcf, 0x7a, 0x95, 0x55, 0x1e, 0x53, 0x5c, 0x30, 0xa3, 0xf8, 0x2d, 0x5e,
+  0xcd, 0x4f, 0x15, 0x8f, 0x91, 0x7d, 0xd8, 0xf8, 0xb4, 0x77, 0x82, 0x52, 0x36, 0xf1, 0xba, 0x16,
+  0xfe, 0xd2, 0x50, 0xf5, 0x6c, 0x78, 0xbc, 0x0a, 0xa6, 0x87, 0x3f, 0xd7, 0x8b, 0x0b, 0xc3, 0xcc,
+  0x54, 0xaf, 0x9d, 0xb0, 0xeb, 0xa9, 0xa4, 0x48, 0xc3, 0xe7, 0xcc, 0x00, 0xba, 0xe4, 0x05, 0xf4,
+  0x2d, 0xfe, 0x25, 0x09, 0x0d, 0xf5, 0x84, 0x89, 0xd2, 0xcd, 0x68, 0xaa, 0x14, 0x08, 0x73, 0x6d,
+  0x78, 0x01, 0x38, 0xf4, 0x86, 0x1d, 0xcb, 0x69, 0xf8, 0xb3, 0x56, 0xf3, 0x7e, 0x62, 0xee, 0xd3,
+  0x31, 0x9d, 0xfc, 0xec, 0xec, 0xef, 0x78, 0xc2, 0xd1, 0x03, 0x2a, 0x66, 0x3c, 0xe1, 0xd7, 0x39,
+  0xd3, 0xe6, 0x3a, 0x92, 0x42, 0x40, 0x64, 0xae, 0x99, 0x31, 0x50, 0x4c, 0xcc, 0x83, 0x5a, 0x5f,
+  0xbe, 0x45, 0x4f, 0xe2, 0x58, 0x81, 0xd6, 0x7b, 0x95, 0xf2, 0xc9, 0x35, 0xab, 0xd8, 0x0f, 0x6a,
+  0xf9, 0xe6, 0xc9, 0xc5, 0x05, 0x7a, 0x56, 0x99, 0x85, 0x78, 0xbf, 0x7b, 0x7a, 0xe5, 0x17, 0xc4,
+  0x0f, 0xea, 0x7a, 0xa1, 0x00, 0xd0, 0x37, 0xc0, 0x26, 0x7b, 0xd5, 0x24, 0x0a, 0xe0, 0x3a, 0x03,
+  0x36, 0xd9, 0xaf, 0x23, 0x67, 0x63, 0xc8, 0xd7, 0x5b, 0xb6, 0xb9, 0xc4, 0x38, 0xbc, 0x00, 0xa1,
+  0xa5, 0x42, 0x5d, 0x64, 0x97, 0xd9, 0x62, 0x58, 0x0a, 0x5b, 0xe5, 0x90, 0x43, 0x64, 0x4a, 0xf5,
+  0xba, 0x94, 0xb9, 0xee, 0x5e, 0x6b, 0x2b, 0xb3, 0xde, 0x7a, 0x63, 0xa9, 0x62, 0x50, 0xab, 0x7d,
+  0x8e, 0xaa, 0x6d, 0x27, 0x27, 0x86, 0x4b, 0x81, 0x6e, 0x58, 0x3e, 0x05, 0x8a, 0xa7, 0xe2, 0xa3,
+  0x90, 0x33, 0x81, 0xc3, 0xfa, 0x65, 0xd8, 0xa9, 0xf8, 0xbb, 0x72, 0x32, 0x49, 0x70, 0x28, 0x93,
+  0xe4, 0x3e, 0x7e, 0xcc, 0x75, 0x03, 0xa7, 0xe6, 0xe8, 0xbe, 0x19, 0x36, 0xad, 0xa5, 0x5c, 0xa4,
+  0x38, 0x5c, 0xbd, 0x6d, 0x24, 0x3b, 0x55, 0x6c, 0xbf, 0x14, 0xa3, 0xde, 0x67, 0x60, 0xd4, 0xfb,
+  0x7f, 0xc5, 0xa8, 0xce, 0x55, 0xe8, 0xa9, 0xe2, 0x69, 0x66, 0x44, 0x75, 0x74, 0x56, 0x38, 0x71,
+  0x31, 0x99, 0x56, 0x30, 0xc5, 0x95, 0xd8, 0x46, 0x0a, 0x23, 0x33, 0x9f, 0x00, 0xc5, 0x65, 0xd2,
+  0xc7, 0x36, 0x09, 0x53, 0xdc, 0xc5, 0xa8, 0x60, 0xb7, 0x14, 0xf7, 0x8e, 0x0e, 0xd6, 0x40, 0xce,
+  0xbc, 0xc3, 0x00, 0x37, 0xf7, 0xfc, 0x78, 0xad, 0xe2, 0x5b, 0x1b, 0xcd, 0x9d, 0x9d, 0x7f, 0x4f,
+  0xfe, 0x5b, 0x25, 0xf6, 0xa3, 0x00, 0x4d, 0xbc, 0xde, 0xde, 0x24, 0x6d, 0x8d, 0x7b, 0x33, 0xef,
+  0xe0, 0x36, 0x47, 0x33, 0x2f, 0x99, 0xe6, 0xf9, 0xdd, 0x54, 0xa9, 0x8b, 0xbb, 0xa9, 0xb2, 0x8b,
+  0xc3, 0x57, 0x32, 0xd5, 0xdb, 0xd9, 0x3a, 0x97, 0xa9, 0xc6, 0x5b, 0x90, 0x15, 0x52, 0x48, 0x54,
+  0x2a, 0xb9, 0xd5, 0xeb, 0xd2, 0xd2, 0x2d, 0x6d, 0x66, 0xde, 0x49, 0x80, 0xe4, 0x0d, 0xa8, 0x24,
+  0x97, 0x33, 0x6f, 0xee, 0xb1, 0xa9, 0x91, 0x3b, 0x99, 0x7c, 0x3c, 0x35, 0x46, 0x56, 0x00, 0x28,
+  0xd0, 0x86, 0x29, 0xf3, 0xd4, 0x08, 0x8c, 0xca, 0xe2, 0x4c, 0xf1, 0xbb, 0x8a, 0xb4, 0x31, 0xc8,
+  0x6f, 0x21, 0x46, 0x46, 0x96, 0xe5, 0xc8, 0xc2, 0xe5, 0x1d, 0xa2, 0x1f, 0x6d, 0xe8, 0xeb, 0x42,
+  0x55, 0xef, 0xcf, 0xea, 0x5f, 0x85, 0xcc, 0x81, 0x2d, 0x79, 0x15, 0x16, 0x79, 0xba, 0x06, 0xc8,
+  0xe2, 0x80, 0x26, 0xde, 0x01, 0xca, 0xac, 0x83, 0xfd, 0x71, 0xea, 0x29, 0x88, 0xcb, 0xf2, 0x68,
+  0x14, 0x13, 0x9a, 0xdb, 0x5d, 0x83, 0x51, 0x59, 0x87, 0x57, 0x7b, 0x83, 0xff, 0x08, 0xfd, 0x9e,
+  0x82, 0x02, 0x87, 0xff, 0xfa, 0xdb, 0x9f, 0x7e, 0x37, 0xec, 0x54, 0xbe, 0xaf, 0x5a, 0x88, 0x30,
+  0x07, 0x83, 0x66, 0xda, 0x2d, 0x40, 0x6b, 0x96, 0x82, 0xbe, 0xcc, 0xb8, 0xbe, 0x80, 0x48, 0x8a,
+  0x98, 0x06, 0x6e, 0x2e, 0xd3, 0x57, 0x5c, 0x80, 0xa6, 0xa3, 0x2b, 0xd7, 0x66, 0xef, 0x17, 0x8a,
+  0x15, 0x70, 0x3e, 0x2d, 0xc6, 0xa0, 0xa8, 0x98, 0xe6, 0xb9, 0x9b, 0x58, 0x82, 0x7e, 0xcd, 0xb5,
+  0x86, 0x98, 0x06, 0x83, 0x48, 0x0a, 0x6d, 0xd0, 0xdb, 0x27, 0xaf, 0xce, 0x2e, 0x2f, 0xcf, 0xe8,
+  0x28, 0x70, 0xbb, 0xc7, 0x8f, 0x1f, 0x3f, 0xee, 0x75, 0x8f, 0xec, 0x4b, 0xb7, 0x7b, 0x7c, 0x12,
+  0xb8, 0xc7, 0x47, 0xbd, 0x93, 0xc0, 0xed, 0x1d, 0x95, 0xa4, 0xc7, 0xc7, 0x5f, 0x1f, 0x5b, 0xd2,
+  0xd1, 0x41, 0x2d, 0xf1, 0xf5, 0xc1, 0xd1, 0xd5, 0x20, 0x99, 0x8a, 0xa8, 0x3c, 0x1f, 0x89, 0x54,
+  0x05, 0x33, 0xcf, 0xa7, 0x8a, 0xd9, 0xa1, 0x03, 0x64, 0x71, 0xc3, 0x14, 0x32, 0xf4, 0x35, 0x33,
+  0x99, 0x9f, 0xe4, 0x52, 0x2a, 0x07, 0x3a, 0x27, 0xc7, 0x87, 0x41, 0x40, 0x5c, 0xb1, 0x45, 0xfd,
+  0xb2, 0xa4, 0x76, 0x0e, 0x8e, 0x2d, 0x0b, 0xb6, 0x59, 0x96, 0xd8, 0x39, 0x0e, 0xc8, 0xc0, 0x46,
+  0x2e, 0x29, 0xc6, 0x03, 0x05, 0x66, 0xaa, 0x04, 0x0a, 0x86, 0xa6, 0xd5, 0x72, 0x64, 0x9b, 0x9a,
+  0x36, 0x8e, 0x11, 0x26, 0xae, 0x13, 0x0c, 0xc5, 0xa7, 0x4f, 0xc1, 0xd0, 0x90, 0x8a, 0x2e, 0xda,
+  0x38, 0xb3, 0x74, 0xd9, 0xa6, 0xd0, 0xc6, 0x05, 0x5e, 0xae, 0x3d, 0xd5, 0x60, 0x2e, 0xe1, 0xd6,
+  0x38, 0xe0, 0x1a, 0xb2, 0x88, 0x65, 0x34, 0x2d, 0x40, 0x18, 0x3f, 0x05, 0x73, 0x96, 0x83, 0x7d,
+  0x7d, 0x3a, 0x7f, 0x19, 0x3b, 0x40, 0x7c, 0xbb, 0xe1, 0x9e, 0x49, 0x61, 0x40, 0x18, 0x6a, 0x36,
+  0xd3, 0xd9, 0x64, 0x92, 0xcf, 0xab, 0x02, 0x6f, 0xa3, 0x5c, 0x55, 0x5c, 0x2e, 0x10, 0xb4, 0x5a,
+  0x2b, 0xdd, 0x2b, 0xaa, 0x8b, 0x45, 0xb9, 0x02, 0x98, 0x52, 0x7b, 0x66, 0x65, 0x82, 0xc0, 0xaf,
+  0x58, 0xa7, 0xbb, 0x80, 0xd5, 0x74, 0xd2, 0xc7, 0x1e, 0x26, 0xee, 0x03, 0x55, 0x78, 0xc7, 0xd2,
+  0xfd, 0x82, 0xfb, 0x8c, 0xdf, 0x2b, 0x7d, 0xd7, 0x9f, 0x7b, 0x45, 0x57, 0x2e, 0x6e, 0xf5, 0x2b,
+  0x3b, 0x5e, 0x6d, 0xf1, 0x5c, 0xf0, 0x9b, 0xe3, 0xd3, 0xd3, 0x6a, 0x7e, 0xa3, 0x27, 0xd8, 0x99,
+  0xdd, 0xe0, 0xb8, 0xe0, 0x6f, 0x46, 0xab, 0x99, 0x5b, 0x3d, 0xc0, 0x2e, 0x1e, 0x4d, 0x9e, 0x0b,
+  0x7e, 0x73, 0x7c, 0x8a, 0xbf, 0x07, 0x8d, 0xfb, 0xf8, 0x5c, 0x5a, 0x2d, 0x9b, 0x16, 0x60, 0x47,
+  0xc5, 0x86, 0xb1, 0x0f, 0xc2, 0x35, 0xf7, 0xd4, 0x69, 0x0c, 0x3a, 0xdd, 0xa0, 0x77, 0x48, 0x7c,
+  0x23, 0x5f, 0xd8, 0x04, 0xe2, 0x74, 0x49, 0x1b, 0xa3, 0xdf, 0x3e, 0xc5, 0xfd, 0xa6, 0x7c, 0xe5,
+  0x3d, 0xf8, 0xdb, 0xcd, 0x41, 0xab, 0xe5, 0xdc, 0xb7, 0x0b, 0x77, 0xdb, 0x08, 0xe2, 0x57, 0x65,
+  0x68, 0x57, 0x45, 0x43, 0x69, 0xef, 0xb3, 0x95, 0xf6, 0xee, 0x53, 0xda, 0x5b, 0x29, 0xbd, 0x91,
+  0x3c, 0x46, 0xc1, 0x23, 0x4a, 0xc1, 0xbf, 0x53, 0x84, 0x1e, 0x32, 0x70, 0xb7, 0x62, 0x6d, 0x6c,
+  0xdc, 0xe1, 0xb9, 0x6b, 0xd8, 0x77, 0xcb, 0x93, 0xbb, 0x47, 0x9a, 0x90, 0x0d, 0xf5, 0x89, 0x52,
+  0x6c, 0xde, 0x6a, 0x29, 0x10, 0x31, 0xa8, 0xd7, 0x65, 0x8f, 0xef, 0x6c, 0x33, 0xad, 0x70, 0x2e,
+  0xd3, 0xa7, 0xd3, 0x24, 0x01, 0x75, 0xea, 0xac, 0x53, 0x64, 0x83, 0xea, 0xeb, 0x9c, 0x47, 0xe0,
+  0x10, 0x5f, 0xc1, 0x0d, 0x28, 0x0d, 0x0e, 0x71, 0x2b, 0x85, 0xb6, 0x30, 0x39, 0x84, 0xf4, 0x4b,
+  0x59, 0x1b, 0x6e, 0xf5, 0xe2, 0x27, 0x52, 0x9d, 0xb1, 0x28, 0x73, 0x80, 0x86, 0x2b, 0x7d, 0xfe,
+  0x64, 0xaa, 0x33, 0xcb, 0xe7, 0x02, 0x08, 0xd9, 0x64, 0xe2, 0x35, 0xbf, 0xb2, 0xe1, 0x1d, 0x04,
+  0x3b, 0xca, 0x37, 0x59, 0x25, 0xe3, 0x69, 0x96, 0xdb, 0x20, 0x9f, 0xd9, 0x6f, 0xb4, 0x4d, 0xfa,
+  0x04, 0x1a, 0x96, 0x09, 0xb1, 0xe0, 0xc2, 0xb1, 0x89, 0x18, 0xda, 0x47, 0x01, 0x59, 0x25, 0x41,
+  0xe3, 0x40, 0x18, 0x76, 0x8f, 0x5b, 0xbd, 0xa3, 0x23, 0x32, 0x1c, 0x76, 0x8f, 0x3f, 0x95, 0x84,
+  0x93, 0x7a, 0x7c, 0xf2, 0xc9, 0xd8, 0x29, 0x2d, 0x68, 0x98, 0x89, 0x21, 0x92, 0x31, 0x94, 0xa5,
+  0x61, 0x63, 0x43, 0xc0, 0x0c, 0xbd, 0xe7, 0xc2, 0x9c, 0x94, 0x98, 0x39, 0x60, 0x13, 0xb4, 0xa5,
+  0x3d, 0x67, 0x86, 0x7d, 0xcb, 0x61, 0x66, 0x93, 0x61, 0x0a, 0xc6, 0x8a, 0x1c, 0xf4, 0x9c, 0xae,
+  0xfb, 0x28, 0x20, 0xae, 0xa4, 0x66, 0x14, 0x5c, 0xb9, 0x8c, 0x9a, 0xd1, 0xd1, 0x95, 0xab, 0xa8,
+  0x19, 0x1d, 0x5f, 0xb9, 0x39, 0x1d, 0x5d, 0x0d, 0x78, 0xe2, 0x74, 0x29, 0xa5, 0xb2, 0xd2, 0x1e,
+  0x51, 0x33, 0x7a, 0x7c, 0xe5, 0xc6, 0xd4, 0x8c, 0x4e, 0xae, 0x06, 0x89, 0x54, 0x8e, 0xcd, 0xe4,
+  0x40, 0x83, 0x01, 0x0c, 0xd9, 0x57, 0x6a, 0x00, 0xed, 0x76, 0x25, 0xc8, 0xa9, 0x19, 0x7d, 0xdd,
+  0x2e, 0x03, 0x22, 0x57, 0x2e, 0xa7, 0x75, 0x61, 0x1a, 0xc1, 0x97, 0x3d, 0x4a, 0x83, 0x53, 0x1e,
+  0x86, 0x87, 0xfd, 0xee, 0x51, 0x8b, 0x5f, 0x9d, 0x9e, 0x06, 0x83, 0xbc, 0x46, 0xfc, 0x4b, 0x46,
+  0x29, 0x8d, 0x5a, 0xad, 0xad, 0x22, 0xc3, 0x08, 0xa5, 0x34, 0x3e, 0xdd, 0x41, 0x94, 0x93, 0x3e,
+  0x27, 0xcb, 0x25, 0xe4, 0x1a, 0x16, 0x3c, 0x71, 0x7a, 0x8f, 0xac, 0x8b, 0x35, 0x8e, 0xb6, 0x3c,
+  0xae, 0x7d, 0x13, 0xf4, 0xf1, 0x40, 0xb4, 0x0f, 0x86, 0xc6, 0xcf, 0x41, 0xa4, 0x26, 0x1b, 0x88,
+  0x36, 0x3d, 0xac, 0x7c, 0xd4, 0xd4, 0x8c, 0x44, 0xbb, 0x7b, 0x55, 0x61, 0x3d, 0x12, 0xed, 0xde,
+  0x55, 0x09, 0xf3, 0x48, 0xb4, 0x0f, 0x76, 0x83, 0x33, 0x23, 0x71, 0x55, 0x46, 0x57, 0xfb, 0xaa,
+  0xc9, 0x72, 0x69, 0x75, 0x14, 0x16, 0xa3, 0x6d, 0xd1, 0x0a, 0x85, 0xa2, 0x92, 0xcb, 0xeb, 0xcd,
+  0x02, 0x5f, 0x31, 0xd7, 0x81, 0x76, 0x97, 0x7c, 0xc5, 0xc8, 0x6a, 0xc1, 0x17, 0xc9, 0xa6, 0xa6,
+  0xf7, 0x85, 0xab, 0xe4, 0x4c, 0xf7, 0x8b, 0xe5, 0x4e, 0x69, 0x5a, 0x2f, 0x2e, 0xd0, 0xed, 0xd5,
+  0x1e, 0xd8, 0xa4, 0x60, 0x43, 0x7d, 0x44, 0xe9, 0x4e, 0x83, 0xd0, 0x6a, 0xd9, 0x34, 0xb5, 0x1e,
+  0x86, 0x3b, 0xec, 0x76, 0xb7, 0xd5, 0x72, 0x9a, 0xed, 0x43, 0x9b, 0x6e, 0xc9, 0x7b, 0x3b, 0xf2,
+  0x5e, 0xd7, 0xb5, 0xdd, 0x85, 0xcc, 0xcb, 0x23, 0xe3, 0xe0, 0x92, 0xa5, 0x51, 0x51, 0xce, 0xed,
+  0x23, 0xdc, 0x6e, 0xea, 0xb2, 0x07, 0x66, 0xa7, 0x5d, 0xd9, 0x52, 0xee, 0xee, 0x9c, 0x6f, 0x1b,
+  0x75, 0xf3, 0xe4, 0x6c, 0xb3, 0xc9, 0xc2, 0xe2, 0xaa, 0xe9, 0xbd, 0xb9, 0xa9, 0xbe, 0x0b, 0x20,
+  0x03, 0xed, 0x73, 0x21, 0x40, 0x7d, 0x73, 0xf9, 0xfa, 0x95, 0xed, 0x2b, 0xea, 0xe3, 0x56, 0x2f,
+  0xfa, 0x29, 0x8c, 0x82, 0xab, 0xfa, 0xbd, 0x7f, 0x32, 0xd0, 0x7e, 0xd9, 0xa5, 0xf9, 0xf6, 0xd2,
+  0xe0, 0x12, 0x8a, 0x49, 0xce, 0x0c, 0x3c, 0x93, 0xf9, 0xb4, 0x10, 0x9a, 0x7e, 0x50, 0x30, 0x01,
+  0x66, 0x9c, 0x2f, 0x16, 0x66, 0xe9, 0xda, 0x66, 0xbc, 0x60, 0xb7, 0x4e, 0xe0, 0xa2, 0x6e, 0xa2,
+  0x08, 0xf9, 0xe0, 0x42, 0x33, 0x61, 0x2c, 0xb6, 0x47, 0xb5, 0xcd, 0xd5, 0x19, 0x76, 0x05, 0x5d,
+  0x1d, 0x5f, 0x17, 0x68, 0x79, 0x74, 0x5d, 0xb9, 0x89, 0x24, 0x52, 0xc0, 0x0c, 0xd4, 0xc1, 0xd8,
+  0x24, 0x7b, 0x83, 0xc9, 0x40, 0xd6, 0x9e, 0x8d, 0x59, 0xf4, 0x31, 0x2d, 0x1b, 0xcf, 0x72, 0xbb,
+  0xd3, 0x0f, 0x2a, 0x1d, 0xd7, 0x2e, 0x7d, 0xb1, 0x10, 0xe5, 0x13, 0x96, 0xe4, 0x83, 0x2b, 0xfd,
+  0xb2, 0xcf, 0x3d, 0x67, 0x05, 0xd8, 0x0f, 0x84, 0x13, 0x94, 0x79, 0x27, 0xfb, 0x3a, 0xda, 0x5e,
+  0x10, 0x60, 0x57, 0xfb, 0x6c, 0x32, 0x01, 0x11, 0x3f, 0xcb, 0x78, 0x1e, 0x3b, 0x92, 0x2c, 0xed,
+  0xdf, 0x0e, 0xf0, 0x55, 0x26, 0x5b, 0x54, 0x27, 0xe7, 0x5e, 0xd4, 0xcb, 0x9e, 0x9e, 0x0c, 0xc4,
+  0x16, 0xe6, 0xeb, 0x44, 0xb9, 0x07, 0x94, 0x87, 0xa3, 0x06, 0x9f, 0x8b, 0x28, 0x9f, 0xc6, 0xa0,
+  0x1d, 0x8c, 0x5e, 0x9e, 0xbf, 0x78, 0xd3, 0x47, 0x98, 0x9c, 0x9a, 0x66, 0x6c, 0xab, 0xab, 0x33,
+  0x5b, 0x81, 0x1b, 0xc2, 0xdf, 0x3d, 0x79, 0x77, 0xfe, 0xf2, 0xfc, 0xd7, 0xfb, 0xe5, 0xeb, 0x4b,
+  0xb5, 0x9d, 0x29, 0x67, 0xef, 0xde, 0xbd, 0x79, 0xb7, 0x7f, 0x42, 0x79, 0xd7, 0xb6, 0x23, 0xfe,
+  0xfc, 0xec, 0xe9, 0xfb, 0x52, 0x7f, 0xab, 0xe5, 0xdc, 0x99, 0x50, 0xde, 0xc3, 0x61, 0xe2, 0x9a,
+  0xad, 0xee, 0x12, 0x5c, 0xb1, 0x85, 0xb4, 0xd9, 0xc2, 0xb9, 0xee, 0x5e, 0xbe, 0x83, 0xf1, 0x85,
+  0x8c, 0x3e, 0x82, 0x71, 0xc8, 0xc2, 0x99, 0xe9, 0x32, 0x43, 0x6f, 0x68, 0x78, 0x56, 0xde, 0x2a,
+  0x56, 0x37, 0x90, 0x7e, 0x26, 0x0b, 0xe8, 0x9f, 0x74, 0x3b, 0x98, 0x10, 0x7f, 0xcc, 0x05, 0x53,
+  0xf3, 0xcb, 0xf2, 0x8b, 0x91, 0xd9, 0x04, 0x3f, 0x2e, 0xeb, 0x1e, 0x76, 0x67, 0xda, 0x97, 0x42,
+  0x4e, 0x40, 0x50, 0x87, 0xd0, 0x70, 0xb1, 0x75, 0x62, 0x7f, 0xfa, 0xcb, 0xef, 0x37, 0xca, 0xd1,
+  0xa6, 0x9f, 0x22, 0x76, 0x96, 0x06, 0x61, 0xbb, 0x88, 0xe9, 0xd8, 0x7e, 0x95, 0x8c, 0x01, 0x93,
+  0x65, 0xa5, 0xab, 0xfe, 0x2c, 0xa1, 0x86, 0x86, 0x36, 0xc5, 0xde, 0xfd, 0x4a, 0x69, 0xb7, 0x5d,
+  0xe3, 0xc7, 0xcc, 0x30, 0xc4, 0x85, 0x36, 0x4c, 0x44, 0xb6, 0xa1, 0x2a, 0x8b, 0x4e, 0x55, 0x8b,
+  0x49, 0x23, 0x81, 0x55, 0x82, 0x64, 0x60, 0x13, 0x36, 0x32, 0x6a, 0xbe, 0x68, 0xf6, 0xdd, 0xbf,
+  0xb9, 0x78, 0x73, 0xee, 0x4f, 0xec, 0x25, 0xec, 0x4a, 0x8e, 0x2c, 0x23, 0x66, 0xec, 0x0e, 0x22,
+  0xeb, 0x40, 0xca, 0xc5, 0x71, 0xb0, 0x95, 0x45, 0xa5, 0x2c, 0x2a, 0x29, 0x7d, 0xec, 0x42, 0xed,
+  0x06, 0x59, 0xd6, 0x9e, 0x47, 0xb9, 0xd4, 0xb0, 0x0f, 0x86, 0x3f, 0xff, 0xfd, 0x9f, 0xff, 0xf8,
+  0x63, 0x03, 0x89, 0xe6, 0x15, 0x81, 0x8b, 0x14, 0x18, 0x35, 0xe7, 0x22, 0x45, 0x5c, 0xa0, 0x9e,
+  0xf6, 0x7d, 0x1f, 0x93, 0xb2, 0x9b, 0xe1, 0x05, 0xc8, 0xa9, 0x71, 0x76, 0x17, 0xce, 0xed, 0xc1,
+  0xc1, 0x0a, 0xab, 0xd2, 0x15, 0x5b, 0xdd, 0x77, 0xdd, 0xfd, 0xe9, 0xaf, 0x7f, 0x68, 0xd8, 0x5b,
+  0x7b, 0x5c, 0x02, 0x5f, 0xba, 0xe9, 0x90, 0xe5, 0xf2, 0xee, 0x96, 0x70, 0x3f, 0xbf, 0x85, 0x64,
+  0x71, 0x7c, 0x76, 0x03, 0xc2, 0xbc, 0xe2, 0xda, 0x80, 0x00, 0xe5, 0xd8, 0x4b, 0x0d, 0x7b, 0x93,
+  0xe0, 0x5a, 0x77, 0xec, 0x41, 0xb6, 0x79, 0xd0, 0xd8, 0x9d, 0x64, 0xaa, 0xb6, 0x6d, 0x90, 0x80,
+  0xc5, 0xb6, 0xbc, 0xbc, 0x6e, 0xec, 0xb2, 0x5c, 0x46, 0x2c, 0xef, 0x44, 0x52, 0x24, 0x3c, 0xed,
+  0x4c, 0x27, 0x31, 0x33, 0x50, 0x19, 0xe9, 0x74, 0x3b, 0xb8, 0x6d, 0x88, 0x6f, 0x32, 0x10, 0x8e,
+  0x45, 0x75, 0x0b, 0xd4, 0xf5, 0xf5, 0x19, 0x33, 0x53, 0x96, 0xf3, 0x1f, 0x59, 0x2c, 0xfb, 0xd8,
+  0x35, 0x84, 0x2c, 0x7f, 0x3e, 0x8a, 0xde, 0xff, 0x32, 0x8a, 0xde, 0x67, 0x44, 0xd1, 0xfb, 0x45,
+  0x51, 0xec, 0x6b, 0x8c, 0xef, 0x06, 0x52, 0x5e, 0xfd, 0x54, 0x71, 0xc0, 0x6e, 0x0c, 0xf7, 0xaa,
+  0xde, 0x6d, 0x9e, 0xb7, 0xbf, 0x5f, 0xe1, 0x3f, 0xf7, 0xea, 0xbf, 0x01, 0x6f, 0x6d, 0xe9, 0x7a,
+  0xe3, 0xec, 0x43, 0x10, 0x3f, 0x55, 0x3c, 0xcf, 0xe4, 0x2f, 0x02, 0xb8, 0x71, 0xc1, 0xb3, 0x37,
+  0x86, 0x9c, 0x47, 0x1f, 0xb1, 0xbb, 0x4a, 0xad, 0x4e, 0x99, 0x2c, 0x12, 0xae, 0x0a, 0x07, 0x3f,
+  0x51, 0x80, 0xe6, 0x72, 0x8a, 0xf4, 0xb4, 0x7e, 0x99, 0x31, 0x61, 0x90, 0x91, 0xa8, 0x56, 0x89,
+  0x4c, 0x06, 0x48, 0xcf, 0xb5, 0x81, 0xe2, 0xd4, 0xe6, 0xf6, 0x87, 0xa2, 0x1d, 0x4b, 0x69, 0xb0,
+  0xbb, 0x28, 0xc0, 0x64, 0x32, 0xee, 0xe3, 0xb7, 0x6f, 0x2e, 0x2e, 0xf1, 0xb2, 0x8e, 0x12, 0x68,
+  0x08, 0xfe, 0x0f, 0xda, 0x1a, 0xdf, 0x50, 0x16, 0x2c, 0x07, 0x65, 0x9c, 0xd5, 0x65, 0x14, 0x8a,
+  0x64, 0x51, 0x30, 0x11, 0x23, 0x0d, 0xc2, 0x3c, 0x42, 0x17, 0xa5, 0x55, 0x34, 0xe3, 0x79, 0x8e,
+  0x14, 0x58, 0xe5, 0x3e, 0x26, 0x4b, 0xe2, 0xd7, 0x19, 0x6f, 0x33, 0xfd, 0x05, 0xe3, 0x79, 0x79,
+  0x79, 0x65, 0x27, 0xc6, 0x6b, 0xcf, 0x6b, 0x6d, 0xb6, 0xf1, 0x82, 0xb2, 0x86, 0x6f, 0x7e, 0x67,
+  0xea, 0xd8, 0xdf, 0x7d, 0xec, 0x8f, 0x40, 0xf6, 0x27, 0xaf, 0x5f, 0xfd, 0x1b, 0x82, 0xdb, 0x4d,
+  0x8a, 0x04, 0x1b, 0x00, 0x00,
+};
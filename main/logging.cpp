@@ -1,37 +1,268 @@
 #include "logging.h"
 #include "declarations.h"
+#include "perf.h"
+#include <atomic>
+#include <lwip/dns.h>
+#include <lwip/tcpip.h>
 
-// Redefine log methods to use datetime
-void logInfo(String message){_logMessage("INFO", message);}
-void logWarning(String message){_logMessage("WARNING", message);}
-void logError(String message){_logMessage("ERROR", message);}
-void logDebug(String message){_logMessage("DEBUG", message);}
-void _logMessage(String level, String message) {
-    // Sanitize message (avoid breaking JSON)
-    message.replace("\"", "' ");
-    message.replace("\n", " ");
+// Last entry printed on Serial by loopLogging()
+static unsigned long serialSequence = 0;
 
-    String currentDateTime = timeClient.getFormattedTime();
-    message = currentDateTime + " " + level + ": " + message;
+// Last entry shipped over UDP by shipLogs()
+static unsigned long shippedSequence = 0;
+static unsigned long lastShip = 0;
 
-    // Get board IP
-    //String ipAddress = WiFi.localIP().toString();
+// LOG_UDP_IP is looked up by lwIP in the TCP/IP task; logServerIp is
+// written there before the state becomes RESOLVE_DONE
+enum ResolveState : uint8_t { RESOLVE_IDLE, RESOLVE_PENDING, RESOLVE_DONE, RESOLVE_FAILED };
+static std::atomic<uint8_t> resolveState(RESOLVE_IDLE);
+static IPAddress logServerIp;
+static unsigned long lastResolveAttempt = 0;
 
-    // if (WiFi.status() == WL_CONNECTED) {
-    //     udp.beginPacket(LOG_UDP_IP, LOG_UDP_PORT);
-    //     udp.write((const uint8_t*)message.c_str(), message.length());
-    //     udp.endPacket();
-    // }
+// The network and render tasks both log; a slot is claimed and filled
+// under this lock, the formatting happens before taking it
+static portMUX_TYPE logMux = portMUX_INITIALIZER_UNLOCKED;
 
-    Serial.println(message);
+// Keep entries on a single line
+static void flattenMessage(char* message) {
+    for (; *message != '\0'; message++) {
+        if (*message == '\n' || *message == '\r') {
+            *message = ' ';
+        }
+    }
+}
+
+// O(1): overwrite the oldest ring slot, no shifting and no heap
+static void storeLogEntry(LogLevel level, const char* message) {
+    uint32_t timestamp = timeClient.getEpochTime();
+
+    portENTER_CRITICAL(&logMux);
+    LogEntry& entry = logBuffer[logSequence % LOG_BUFFER_SIZE];
+    entry.timestamp = timestamp;
+    entry.level = level;
+    memcpy(entry.message, message, LOG_MESSAGE_SIZE);
+    logSequence++;
+    portEXIT_CRITICAL(&logMux);
+}
+
+void _logFormat(LogLevel level, const char* format, ...) {
+    PerfScope perf(PERF_LOG_MESSAGE);
+    char message[LOG_MESSAGE_SIZE];
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    flattenMessage(message);
+    storeLogEntry(level, message);
+}
+
+void _logMessage(LogLevel level, const char* message) {
+    PerfScope perf(PERF_LOG_MESSAGE);
+    char copy[LOG_MESSAGE_SIZE];
+    strncpy(copy, message, sizeof(copy) - 1);
+    copy[sizeof(copy) - 1] = '\0';
+    flattenMessage(copy);
+    storeLogEntry(level, copy);
+}
+
+// --- UDP Shipping ---
+// Pending ring entries are packed into datagrams of at most LOG_SHIP_MTU
+// bytes for the collector in http-server/server.py:
+//
+//     @<hostname> 1 <first seq> <last seq>\n
+//     <seq> <formatted line>\n
+//     ...
+//
+// Nothing is queued besides the ring itself: while WiFi is down the ring
+// keeps overwriting its oldest entries and those lines are counted as dropped.
+#ifdef LOG_UDP_IP
+
+// Both run in the TCP/IP task: the lookup is started there, and the answer
+// comes back there, right away from the cache or once the server replied
+static void onLogServerFound(const char* name, const ip_addr_t* address, void* arg) {
+    if (address != nullptr && IP_IS_V4(address)) {
+        logServerIp = IPAddress(ip4_addr_get_u32(ip_2_ip4(address)));
+        resolveState.store(RESOLVE_DONE, std::memory_order_release);
+    } else {
+        resolveState.store(RESOLVE_FAILED, std::memory_order_release);
+    }
+}
+
+static void startLogServerLookup(void* arg) {
+    static ip_addr_t address;
+    err_t result = dns_gethostbyname(LOG_UDP_IP, &address, onLogServerFound, nullptr);
+    if (result == ERR_OK) {
+        onLogServerFound(LOG_UDP_IP, &address, nullptr);
+    } else if (result != ERR_INPROGRESS) {
+        onLogServerFound(LOG_UDP_IP, nullptr, nullptr);
+    }
+}
+
+// Only resolved once, beginPacket(host) would do a lookup per datagram.
+// Never waits for DNS: false until the lookup it started has an answer.
+static bool resolveLogServer() {
+    uint8_t state = resolveState.load(std::memory_order_acquire);
+    if (state == RESOLVE_DONE) {
+        return true;
+    }
+    unsigned long now = millis();
+    if (state == RESOLVE_PENDING ||
+        (state == RESOLVE_FAILED && now - lastResolveAttempt < LOG_SHIP_RESOLVE_RETRY)) {
+        return false;
+    }
+    lastResolveAttempt = now;
+    resolveState.store(RESOLVE_PENDING, std::memory_order_relaxed);
+    if (tcpip_callback(startLogServerLookup, nullptr) != ERR_OK) {
+        resolveState.store(RESOLVE_FAILED, std::memory_order_relaxed);
+    }
+    return false;
+}
+
+static void shipLogs() {
+    // Account for lines the ring overwrote before they could be shipped
+    unsigned long first = firstLogSequence();
+    if (shippedSequence + 1 < first) {
+        logLinesDropped += first - 1 - shippedSequence;
+        shippedSequence = first - 1;
+    }
+
+    unsigned long pending = logSequence - shippedSequence;
+    if (pending == 0 || WiFi.status() != WL_CONNECTED) {
+        return;
+    }
+
+    unsigned long now = millis();
+    if (pending < LOG_SHIP_BATCH_LINES && now - lastShip < LOG_SHIP_INTERVAL) {
+        return;
+    }
+    if (!resolveLogServer()) {
+        return;
+    }
+    lastShip = now;
+
+    char packet[LOG_SHIP_MTU];
+    char line[LOG_LINE_SIZE];
+    LogEntry entry;
+
+    for (int datagrams = 0; datagrams < LOG_SHIP_MAX_DATAGRAMS && shippedSequence < logSequence; datagrams++) {
+        // The header is rewritten once the last sequence number is known
+        const int headerReserve = 48;
+        size_t length = headerReserve;
+        unsigned long firstSeq = shippedSequence + 1;
+        unsigned long seq = firstSeq;
+        unsigned long lines = 0;
+        unsigned long lost = 0; // Overwritten by the other task while packing
+
+        for (; seq <= logSequence; seq++) {
+            if (!readLogEntry(seq, entry)) {
+                lost++;
+                continue;
+            }
+            formatLogEntry(entry, line, sizeof(line));
+            int written = snprintf(packet + length, sizeof(packet) - length, "%lu %s\n", seq, line);
+            if (written < 0 || length + written >= sizeof(packet)) {
+                break;
+            }
+            length += written;
+            lines++;
+        }
+        unsigned long lastSeq = seq - 1;
+        logLinesDropped += lost;
+
+        char header[headerReserve];
+        int headerLength = snprintf(header, sizeof(header), "@%s 1 %lu %lu\n", WiFi.getHostname(), firstSeq, lastSeq);
+        if (headerLength < 0 || headerLength >= headerReserve) {
+            return;
+        }
+        char* start = packet + headerReserve - headerLength;
+        memcpy(start, header, headerLength);
+
+        udp.beginPacket(logServerIp, LOG_UDP_PORT);
+        udp.write((const uint8_t*)start, length - (start - packet));
+        if (udp.endPacket()) {
+            logLinesShipped += lines;
+        } else {
+            logLinesDropped += lines;
+        }
+        shippedSequence = lastSeq;
+    }
+}
+
+#endif // LOG_UDP_IP
+
+void loopLogging() {
+#ifdef LOG_UDP_IP
+    shipLogs();
+#endif
+
+    if (serialSequence == logSequence) {
+        return;
+    }
+
+    unsigned long first = firstLogSequence();
+    if (serialSequence + 1 < first) {
+        Serial.printf("... %lu log lines dropped\n", first - serialSequence - 1);
+        serialSequence = first - 1;
+    }
+
+    char line[LOG_LINE_SIZE];
+    LogEntry entry;
+    while (serialSequence < logSequence) {
+        serialSequence++;
+        if (readLogEntry(serialSequence, entry)) {
+            formatLogEntry(entry, line, sizeof(line));
+            Serial.println(line);
+        }
+    }
+}
+
+unsigned long firstLogSequence() {
+    return logSequence > LOG_BUFFER_SIZE ? logSequence - LOG_BUFFER_SIZE + 1 : 1;
+}
+
+bool readLogEntry(unsigned long seq, LogEntry& out) {
+    bool found = false;
+    portENTER_CRITICAL(&logMux);
+    if (seq != 0 && seq <= logSequence && seq >= firstLogSequence()) {
+        out = logBuffer[(seq - 1) % LOG_BUFFER_SIZE];
+        found = true;
+    }
+    portEXIT_CRITICAL(&logMux);
+    return found;
+}
 
-    // log history buffer
-    // Shift all existing messages down by one position
-    for (int i = LOG_BUFFER_SIZE - 1; i > 0; i--) {
-        strcpy(logBuffer[i], logBuffer[i - 1]);
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LOG_DEBUG:   return "DEBUG";
+        case LOG_INFO:    return "INFO";
+        case LOG_WARNING: return "WARNING";
+        case LOG_ERROR:   return "ERROR";
+        default:          return "UNKNOWN";
     }
+}
 
-    // Add the new message at the beginning (index 0)
-    strncpy(logBuffer[0], message.c_str(), 99);
-    logBuffer[0][99] = '\0';
+size_t formatLogEntry(const LogEntry& entry, char* out, size_t size) {
+    unsigned long seconds = entry.timestamp % 86400UL;
+    int written = snprintf(out, size, "%02lu:%02lu:%02lu %s: %s",
+                           seconds / 3600, (seconds % 3600) / 60, seconds % 60,
+                           logLevelName(entry.level), entry.message);
+    if (written < 0) {
+        out[0] = '\0';
+        return 0;
+    }
+    return (size_t)written < size ? written : size - 1;
+}
+
+bool parseLogLevel(const char* name, LogLevel& level) {
+    static const LogLevel LEVELS[] = { LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERROR };
+    for (LogLevel candidate : LEVELS) {
+        if (strcasecmp(name, logLevelName(candidate)) == 0 ||
+            (name[0] == '0' + candidate && name[1] == '\0')) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
 }
@@ -3,10 +3,60 @@
 
 #include "declarations.h"
 
-void logInfo(String message);
-void logWarning(String message);
-void logError(String message);
-void logDebug(String message);
-void _logMessage(String level, String message);
+// --- Log API ---
+// printf-style, formatted straight into the log ring without heap allocation:
+//
+//     logInfo("Sensor %d state updated: %s", index + 1, stateName(state));
+//
+// Never pass untrusted text as the format, use logInfo("%s", text).
+//
+// Levels below LOG_COMPILE_LEVEL are removed at compile time and levels below
+// logRuntimeLevel are skipped at run time. In both cases the arguments are
+// never evaluated, so they may be as expensive as needed.
+
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_DEBUG
+#endif
+
+template <LogLevel level>
+struct LogCompiledIn {
+    static constexpr bool value = level >= LOG_COMPILE_LEVEL;
+};
+
+#define LOG_AT(level, ...) \
+    do { \
+        if (LogCompiledIn<level>::value && (level) >= logRuntimeLevel) { \
+            _logFormat(level, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define logDebug(...)   LOG_AT(LOG_DEBUG, __VA_ARGS__)
+#define logInfo(...)    LOG_AT(LOG_INFO, __VA_ARGS__)
+#define logWarning(...) LOG_AT(LOG_WARNING, __VA_ARGS__)
+#define logError(...)   LOG_AT(LOG_ERROR, __VA_ARGS__)
+
+void _logFormat(LogLevel level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+void _logMessage(LogLevel level, const char* message);
+
+// Serial is a reader like any other: pending entries are printed from loop()
+void loopLogging();
+
+// --- Readers ---
+// Oldest sequence number still held by the ring (logSequence + 1 when empty)
+unsigned long firstLogSequence();
+
+// Copies entry 'seq' under the ring's lock, so a writer on the other task
+// cannot change it halfway. False when it was overwritten or does not exist
+// yet; readers skip it. Readers wanting "entries after seq N" iterate
+// max(N + 1, firstLogSequence()) .. logSequence.
+bool readLogEntry(unsigned long seq, LogEntry& out);
+
+// Formats "HH:MM:SS LEVEL: message" into 'out' (LOG_LINE_SIZE is always enough)
+size_t formatLogEntry(const LogEntry& entry, char* out, size_t size);
+
+const char* logLevelName(LogLevel level);
+
+// Accepts "debug", "info", "warning", "error" or "0".."3"; returns false otherwise
+bool parseLogLevel(const char* name, LogLevel& level);
 
 #endif // LOGGING_H
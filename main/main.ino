@@ -3,13 +3,19 @@
 #include "display.h"
 #include "hass.h"
 #include "http_server.h"
-#include <ESPmDNS.h>
+#include "status.h"
+#include "entities.h"
+#include "connection.h"
+#include "render.h"
+#include "perf.h"
+#include "history.h"
+#include "warmstart.h"
+#include "boot.h"
 // OTA
 // #include "ota.h"
 // Utility
 #include "util.h"
 #include <WiFiUdp.h>
-#include <NTPClient.h>
 
 // --- Global Variable Definitions ---
 // The 'extern' declarations in declarations.h tell other files that these variables exist.
@@ -19,14 +25,24 @@
 Adafruit_NeoPixel strip(LED_COUNT, LED_PIN, NEO_GRB + NEO_KHZ800);
 uint8_t displayBrightness = 20;
 uint8_t displayArray[MATRIX_HEIGHT][MATRIX_WIDTH];
+unsigned long framesComposed = 0;
+unsigned long framesShown = 0;
+unsigned long keyframesShown = 0; // Unblended looks among framesShown
 
 // Home Assistant
 WebsocketsClient client;
 int hass_message_id = 1;
-char sensor_1_state[16] = "unknown";
-char sensor_2_state[16] = "unknown";
-char sensor_3_state[16] = "unknown";
+// One row per bound entity; sensor_N in /status and /config/update_state/N is row N
+const EntityBinding entityBindings[] = {
+    { SENSOR_1_ENTITY_ID, 0,  SOUND_STATE_CHANGE },
+    { SENSOR_2_ENTITY_ID, 1,  SOUND_STATE_CHANGE },
+    { SENSOR_3_ENTITY_ID, -1, SOUND_ON_OFF },
+};
+const uint8_t entityCount = sizeof(entityBindings) / sizeof(entityBindings[0]);
+static_assert(sizeof(entityBindings) / sizeof(entityBindings[0]) <= MAX_ENTITIES, "Too many entity bindings");
+EntityState entityStates[MAX_ENTITIES];
 bool ws_connected = false;
+bool statesStale = false;
 
 // WiFi
 WiFiServer server(HTTP_PORT);
@@ -34,112 +50,93 @@ WiFiUDP udp;
 bool wifi_connected = false;
 long wifiLastConnectAttempt = 0;
 
-// State & Timing
+// State & Timing (render task)
 int chargingRow = 1;
 int highlightIndex = 0;
 int highlightX = 0;
 int highlightY = 0;
 bool should_render = true;
-unsigned long lastUpdate = 0;
 const unsigned long interval = 1000; // 1 second
 
 // Logging
-char logBuffer[LOG_BUFFER_SIZE][100] = {0};
+LogEntry logBuffer[LOG_BUFFER_SIZE];
+unsigned long logSequence = 0;
+LogLevel logRuntimeLevel = LOG_DEBUG;
+unsigned long logLinesShipped = 0;
+unsigned long logLinesDropped = 0;
 //bool ota_in_progress = false;
 
 // NTP
-NTPClient timeClient(udp, NTP_SERVER, 0, 3600000); // UTC, update every 1h
-
-
-// --- WiFi and Utility Functions ---
-
-void connectToWifi() {
-    logInfo("Connecting to WiFi...");
-    logInfo("SSID: " + String(WIFI_SSID));
-    logInfo("PASSWORD: " + String(WIFI_PASSWORD));
-
-    WiFi.setHostname("charger");
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-    int retries = 0;
-    while (WiFi.status() != WL_CONNECTED && retries < 90) {
-        delay(500);
-        yield();
-        Serial.print(".");
-        retries++;
-    }
-    if (WiFi.status() == WL_CONNECTED) {
-        wifiLastConnectAttempt = millis();
-        logInfo("WiFi connected!");
-        String ipStr = WiFi.localIP().toString();
-        logInfo("IP address: " + ipStr);
-        
-        logInfo("mDNS.begin charger.local");
-        if (!MDNS.begin("charger")) {
-            logError("Error starting mDNS");
-        } else {
-            logInfo("mDNS responder started: charger.local");
-        }
-
-        // OTA DISABLED
-        // logInfo("OTA initialization");
-        // setupOTA("charger");
-
-        wifi_connected = true;
-    } else {
-        logError("Failed to connect to WiFi.");
-        wifi_connected = false;
-    }
-}
-
+NtpClock timeClient; // UTC, started by the boot stage once WiFi is up
 
 
 // --- Main Functions ---
 
 void setup() {
     Serial.begin(115200);
+    setupPerf();
     // setupOTA("charger");
 
-    // Initialize buzzer pin
-    pinMode(BUZZER_PIN, OUTPUT);
-    digitalWrite(BUZZER_PIN, HIGH); // Keep buzzer OFF
+    // Initialize buzzer pin and sound sequencer
+    setupSound();
 
     // Play buzzer sound
     playSound(2, 20, 50);
 
 
-    setupDisplay();
-    render_matrix(); // Initial render
+    setupEntities();
+    setupHistory(); // Replays stored transitions from flash
+    setupWarmStart(); // Last known states and settings, from RTC memory or NVS
 
-    connectToWifi();
-    playSound(3, 20, 50);
-
-    // NTP setup
-    timeClient.begin();
-    timeClient.update();
+    // Display, network stack and HTTP server now; WiFi, NTP and the HA
+    // sync complete later from the network pass (see boot.h)
+    setupBoot();
 
+    playSound(1, 50, 400);
+    loopLogging();
 
-    if (wifi_connected) {
-        render_matrix();
-        logInfo("Loading initial state of sensors");
-        getEntitiesState();
+#if RENDER_TASK
+    startRenderTask();
+    xTaskCreatePinnedToCore(networkTask, "network", NETWORK_TASK_STACK, nullptr,
+                            NETWORK_TASK_PRIORITY, nullptr, NETWORK_TASK_CORE);
+#endif
+}
 
-        logInfo("Websocket connecting");
-        setupHass();
-        logInfo("Websocket connected");
+// WiFi, Home Assistant, HTTP and logging. Everything the display needs
+// leaves through publishDisplayState() / postEntityEvent().
+void networkPass() {
+    unsigned long startUs = micros();
+    {
+        PerfScope pass(PERF_NETWORK_PASS);
+
+        { PerfScope perf(PERF_LOOP_LOGGING); loopLogging(); }
+        { PerfScope perf(PERF_LOOP_HTTP); handleHttpRequests(); }
+        { PerfScope perf(PERF_LOOP_WEBSOCKET); handleWebSocket(); }
+
+        // --- Connection Management ---
+        { PerfScope perf(PERF_LOOP_CONNECTION); loopConnection(); }
+        loopBoot();
+        loopWarmStart();
+        loopHistory();
+        if (wifi_connected) {
+            PerfScope perf(PERF_LOOP_HASS);
+            loopHass(); // Process WebSocket messages
+        }
 
-        setupHttpServer();
+        publishDisplayState();
     }
-    playSound(1, 50, 400);
+    recordNetworkPass(startUs, micros());
 }
 
-void getEntitiesState() {
-    strcpy(sensor_1_state, getEntityState(SENSOR_1_ENTITY_ID).c_str());
-    strcpy(sensor_2_state, getEntityState(SENSOR_2_ENTITY_ID).c_str());
-    strcpy(sensor_3_state, getEntityState(SENSOR_3_ENTITY_ID).c_str());
-    logInfo("Sensor 1 state: " + String(sensor_1_state));
-    logInfo("Sensor 2 state: " + String(sensor_2_state));
-    logInfo("Sensor 3 state: " + String(sensor_3_state));
+#if RENDER_TASK
+void networkTask(void* parameter) {
+    for (;;) {
+        networkPass();
+        // Let the idle task on this core run, the task watchdog watches it
+        vTaskDelay(1);
+    }
 }
+#endif
 
 void loop() {
 
@@ -150,52 +147,11 @@ void loop() {
     //     return;
     // }
 
-
-    handleHttpRequests();
-    handleWebSocket();
-
-    // --- Connection Management ---
-    if (WiFi.status() != WL_CONNECTED) {
-        wifi_connected = false;
-        ws_connected = false; // Also reset websocket status
-        strcpy(sensor_1_state, "unknown");
-        strcpy(sensor_2_state, "unknown");
-        logWarning("WiFi disconnected, trying to reconnect...");
-        render_matrix();
-        connectToWifi();
-        if (wifi_connected) {
-            logInfo("Wifi reconnected!");
-            render_matrix();
-            getEntitiesState();
-            // Re-init the HASS connection
-            setupHass();
-        }
-    }
-
-    if (wifi_connected) {
-        if (!ws_connected) {
-            strcpy(sensor_1_state, "unknown");
-            strcpy(sensor_2_state, "unknown");
-            logWarning("Websocket disconnected, trying to reconnect...");
-            // Attempt to reconnect.
-            client.connect(HASS_HOST, HASS_PORT, "/api/websocket");
-            getEntitiesState();
-        }
-        loopHass(); // Process WebSocket messages
-    }
-
-    // --- Timed Display Update ---
-    unsigned long now = millis();
-    if (now - lastUpdate >= interval) {
-        lastUpdate = now;
-
-        chargingRow++;
-        if (chargingRow > 6) chargingRow = 1;
-
-        getNextBorderPoint();
-
-        if (should_render) {
-            render_matrix();
-        }
-    }
-}
\ No newline at end of file
+#if RENDER_TASK
+    // Both passes run in their own tasks
+    vTaskDelete(nullptr);
+#else
+    networkPass();
+    renderPass();
+#endif
+}
@@ -0,0 +1,200 @@
+#include "metrics.h"
+#include "perf.h"
+#include "render.h"
+#include "animation.h"
+#include "connection.h"
+#include "http_server.h"
+#include "buffered_print.h"
+#include "pools.h"
+#include "boot.h"
+
+// PoolUsage registers itself on construction, so pools are copied field by field
+struct PoolSample {
+    const char* name;
+    size_t capacity;
+    size_t used;
+    size_t highWater;
+    uint32_t failures;
+};
+
+struct MetricsSnapshot {
+    PerfCounter perf[PERF_PATH_COUNT];
+    uint32_t cyclesPerUs;
+    RenderStats render;
+    NetworkStats network;
+    AnimationStats animation;
+    uint32_t framesShown;
+    uint32_t framesPushed;
+    uint32_t logLinesShipped;
+    uint32_t logLinesDropped;
+    uint32_t wifiReconnects;
+    uint32_t hassReconnects;
+    uint32_t freeHeap;
+    uint32_t minFreeHeap;
+    uint32_t largestFreeBlock;
+    uint32_t uptime;
+    int poolCount;
+    PoolSample pools[POOL_MAX_ENTRIES];
+    BootTiming boot[BOOT_STAGE_COUNT];
+};
+
+// Counts what would be written, for Content-Length
+class CountingPrint : public Print {
+public:
+    CountingPrint() : count(0) {}
+    size_t write(uint8_t c) override { count++; return 1; }
+    size_t write(const uint8_t* data, size_t size) override { count += size; return size; }
+    using Print::write;
+
+    size_t count;
+};
+
+static void takeSnapshot(MetricsSnapshot& snap) {
+    for (int i = 0; i < PERF_PATH_COUNT; i++) {
+        readPerf((PerfPath)i, snap.perf[i]);
+    }
+    snap.cyclesPerUs = ESP.getCpuFreqMHz();
+    snap.render = getRenderStats();
+    snap.network = getNetworkStats();
+    snap.animation = getAnimationStats();
+    snap.framesShown = framesShown;
+    snap.framesPushed = getFramesPushed();
+    snap.logLinesShipped = logLinesShipped;
+    snap.logLinesDropped = logLinesDropped;
+    snap.wifiReconnects = getWifiStats().reconnects;
+    snap.hassReconnects = getHassStats().reconnects;
+    snap.freeHeap = ESP.getFreeHeap();
+    snap.minFreeHeap = ESP.getMinFreeHeap();
+    snap.largestFreeBlock = ESP.getMaxAllocHeap();
+    snap.uptime = millis() / 1000;
+    snap.poolCount = poolCount();
+    for (int i = 0; i < snap.poolCount; i++) {
+        const PoolUsage& pool = getPool(i);
+        snap.pools[i] = { pool.name, pool.capacity, pool.used, pool.highWater, pool.failures };
+    }
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        snap.boot[i] = getBootTiming((BootStage)i);
+    }
+}
+
+static void printSeconds(Print& out, uint64_t cycles, uint32_t cyclesPerUs) {
+    // Microsecond resolution, printed as seconds without going through floats
+    uint64_t us = cycles / cyclesPerUs;
+    printLine(out, "%lu.%06lu\n", (unsigned long)(us / 1000000), (unsigned long)(us % 1000000));
+}
+
+static void printType(Print& out, const char* name, const char* type, const char* help) {
+    printLine(out, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+static void printValue(Print& out, const char* name, uint32_t value) {
+    printLine(out, "%s %lu\n", name, (unsigned long)value);
+}
+
+static void writeMetrics(Print& out, const MetricsSnapshot& snap) {
+    printType(out, "charger_stage_seconds", "histogram", "Time spent per run of each loop stage and handler.");
+    for (int i = 0; i < PERF_PATH_COUNT; i++) {
+        const PerfCounter& counter = snap.perf[i];
+        const char* stage = perfPathName((PerfPath)i);
+        uint32_t cumulative = 0;
+        for (int b = 0; b < PERF_BUCKETS; b++) {
+            cumulative += counter.buckets[b];
+            uint32_t boundUs = perfBucketBoundUs(b);
+            if (boundUs > 0) {
+                printLine(out, "charger_stage_seconds_bucket{stage=\"%s\",le=\"%lu.%06lu\"} %lu\n", stage,
+                           (unsigned long)(boundUs / 1000000), (unsigned long)(boundUs % 1000000),
+                           (unsigned long)cumulative);
+            } else {
+                printLine(out, "charger_stage_seconds_bucket{stage=\"%s\",le=\"+Inf\"} %lu\n", stage, (unsigned long)cumulative);
+            }
+        }
+        printLine(out, "charger_stage_seconds_sum{stage=\"%s\"} ", stage);
+        printSeconds(out, counter.totalCycles, snap.cyclesPerUs);
+        printLine(out, "charger_stage_seconds_count{stage=\"%s\"} %lu\n", stage, (unsigned long)counter.calls);
+    }
+
+    printType(out, "charger_stage_max_seconds", "gauge", "Slowest run of each stage since boot.");
+    for (int i = 0; i < PERF_PATH_COUNT; i++) {
+        printLine(out, "charger_stage_max_seconds{stage=\"%s\"} ", perfPathName((PerfPath)i));
+        printSeconds(out, snap.perf[i].maxCycles, snap.cyclesPerUs);
+    }
+
+    printType(out, "charger_network_gap_max_seconds", "gauge", "Longest pause between two network passes.");
+    out.print("charger_network_gap_max_seconds ");
+    printSeconds(out, (uint64_t)snap.network.maxGapUs * snap.cyclesPerUs, snap.cyclesPerUs);
+
+    printType(out, "charger_render_tick_late_max_seconds", "gauge", "Latest start of an animation tick.");
+    out.print("charger_render_tick_late_max_seconds ");
+    printSeconds(out, (uint64_t)snap.render.maxLateUs * snap.cyclesPerUs, snap.cyclesPerUs);
+
+    printType(out, "charger_frames_shown_total", "counter", "Frames pushed to the LED strip.");
+    printValue(out, "charger_frames_shown_total", snap.framesShown);
+    printType(out, "charger_frames_pushed_total", "counter", "Frames sent to WebSocket clients.");
+    printValue(out, "charger_frames_pushed_total", snap.framesPushed);
+    printType(out, "charger_render_frames_dropped_total", "counter", "Animation ticks skipped because the render task fell behind.");
+    printValue(out, "charger_render_frames_dropped_total", snap.render.framesDropped);
+    printType(out, "charger_render_events_dropped_total", "counter", "Entity events lost to a full queue.");
+    printValue(out, "charger_render_events_dropped_total", snap.render.eventsDropped);
+    printType(out, "charger_animation_overruns_total", "counter", "Animation frames over their time budget.");
+    printValue(out, "charger_animation_overruns_total", snap.animation.overruns);
+    printType(out, "charger_animation_degraded", "gauge", "1 while blending is disabled to keep up.");
+    printValue(out, "charger_animation_degraded", snap.animation.degraded ? 1 : 0);
+    printType(out, "charger_log_lines_shipped_total", "counter", "Log lines sent to the UDP collector.");
+    printValue(out, "charger_log_lines_shipped_total", snap.logLinesShipped);
+    printType(out, "charger_log_lines_dropped_total", "counter", "Log lines overwritten before they were shipped.");
+    printValue(out, "charger_log_lines_dropped_total", snap.logLinesDropped);
+
+    printType(out, "charger_link_reconnects_total", "counter", "Times a link came back after being up.");
+    printLine(out, "charger_link_reconnects_total{link=\"wifi\"} %lu\n", (unsigned long)snap.wifiReconnects);
+    printLine(out, "charger_link_reconnects_total{link=\"hass\"} %lu\n", (unsigned long)snap.hassReconnects);
+
+    printType(out, "charger_free_heap_bytes", "gauge", "Free heap.");
+    printValue(out, "charger_free_heap_bytes", snap.freeHeap);
+    printType(out, "charger_min_free_heap_bytes", "gauge", "Lowest free heap since boot.");
+    printValue(out, "charger_min_free_heap_bytes", snap.minFreeHeap);
+    printType(out, "charger_largest_free_block_bytes", "gauge", "Largest block the heap can still hand out.");
+    printValue(out, "charger_largest_free_block_bytes", snap.largestFreeBlock);
+
+    printType(out, "charger_pool_size_bytes", "gauge", "Capacity of each static pool.");
+    for (int i = 0; i < snap.poolCount; i++) {
+        printLine(out, "charger_pool_size_bytes{pool=\"%s\"} %lu\n", snap.pools[i].name, (unsigned long)snap.pools[i].capacity);
+    }
+    printType(out, "charger_pool_used_bytes", "gauge", "Bytes in use in each static pool.");
+    for (int i = 0; i < snap.poolCount; i++) {
+        printLine(out, "charger_pool_used_bytes{pool=\"%s\"} %lu\n", snap.pools[i].name, (unsigned long)snap.pools[i].used);
+    }
+    printType(out, "charger_pool_high_water_bytes", "gauge", "Most bytes ever in use in each static pool.");
+    for (int i = 0; i < snap.poolCount; i++) {
+        printLine(out, "charger_pool_high_water_bytes{pool=\"%s\"} %lu\n", snap.pools[i].name, (unsigned long)snap.pools[i].highWater);
+    }
+    printType(out, "charger_pool_failures_total", "counter", "Requests a static pool could not fit.");
+    for (int i = 0; i < snap.poolCount; i++) {
+        printLine(out, "charger_pool_failures_total{pool=\"%s\"} %lu\n", snap.pools[i].name, (unsigned long)snap.pools[i].failures);
+    }
+    printType(out, "charger_boot_stage_seconds", "gauge", "Time from boot until each boot stage completed.");
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        if (snap.boot[i].done) {
+            unsigned long ms = snap.boot[i].doneMs;
+            printLine(out, "charger_boot_stage_seconds{stage=\"%s\"} %lu.%03lu\n", bootStageName((BootStage)i),
+                      ms / 1000, ms % 1000);
+        }
+    }
+    printType(out, "charger_uptime_seconds", "counter", "Seconds since boot.");
+    printValue(out, "charger_uptime_seconds", snap.uptime);
+}
+
+void sendMetricsHttp(WiFiClient& client, bool keepAlive) {
+    MetricsSnapshot snap;
+    takeSnapshot(snap);
+
+    CountingPrint counter;
+    writeMetrics(counter, snap);
+
+    BufferedPrint out(client);
+    out.print(F("HTTP/1.1 200 OK\r\n"));
+    out.print(F("Content-Type: text/plain; version=0.0.4\r\n"));
+    printLine(out, "Content-Length: %u\r\n", (unsigned)counter.count);
+    out.print(F("Cache-Control: no-cache\r\n"));
+    out.print(keepAlive ? F("Connection: keep-alive\r\n\r\n") : F("Connection: close\r\n\r\n"));
+    writeMetrics(out, snap);
+}
@@ -0,0 +1,19 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "declarations.h"
+
+// --- Prometheus Metrics ---
+// GET /metrics in the Prometheus text format (version 0.0.4):
+//   charger_stage_seconds{stage="..."}          histogram per PerfPath
+//   charger_stage_max_seconds{stage="..."}      slowest run since boot
+//   charger_network_gap_max_seconds             longest pause between two network passes
+//   charger_*_total                             event counters
+//   charger_pool_*{pool="..."}                 static pool sizes and use (see pools.h)
+//   charger_free_heap_bytes, charger_uptime_seconds, ...
+// All values are copied first, so Content-Length matches the body even
+// while the render task keeps counting.
+
+void sendMetricsHttp(WiFiClient& client, bool keepAlive);
+
+#endif // METRICS_H
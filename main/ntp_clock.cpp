@@ -0,0 +1,26 @@
+#include "ntp_clock.h"
+#include <time.h>
+
+void NtpClock::begin(const char* server) {
+    configTime(0, 0, server);
+}
+
+bool NtpClock::isTimeSet() const {
+    return getEpochTime() >= CLOCK_VALID_AFTER;
+}
+
+unsigned long NtpClock::getEpochTime() const {
+    return (unsigned long)time(nullptr);
+}
+
+int NtpClock::getHours() const {
+    return (getEpochTime() % 86400L) / 3600;
+}
+
+int NtpClock::getMinutes() const {
+    return (getEpochTime() % 3600) / 60;
+}
+
+int NtpClock::getSeconds() const {
+    return getEpochTime() % 60;
+}
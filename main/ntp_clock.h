@@ -0,0 +1,26 @@
+#ifndef NTP_CLOCK_H
+#define NTP_CLOCK_H
+
+#include <Arduino.h>
+
+// --- Wall Clock ---
+// UTC time set in the background by the SNTP client built into lwIP.
+// begin() only configures it: the request, its retries and the hourly
+// resync run in the TCP/IP task, so nothing waits for a reply. Until the
+// first reply the clock counts from boot, like NTPClient before its first
+// update did. The getters match NTPClient's, for the callers that used it.
+
+#define CLOCK_VALID_AFTER 1609459200UL // 2021-01-01; earlier values are time since boot
+
+class NtpClock {
+public:
+    void begin(const char* server);
+
+    bool isTimeSet() const;
+    unsigned long getEpochTime() const;
+    int getHours() const;
+    int getMinutes() const;
+    int getSeconds() const;
+};
+
+#endif // NTP_CLOCK_H
@@ -15,7 +15,7 @@ void setupOTA(const char* hostname) {
 
         ota_in_progress = true;
         render_matrix();
-        logInfo("Start updating " + type);
+        logInfo("Start updating %s", type.c_str());
         playSound(3, 100, 100);
     });
     ArduinoOTA.onEnd([]() {
@@ -24,7 +24,7 @@ void setupOTA(const char* hostname) {
         logInfo("End");
     });
     ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
-        logInfo("Progress: " + String((progress / (total / 100))) + "%");
+        logInfo("Progress: %u%%", progress / (total / 100));
         if ( (progress / (total / 100)) % 10 ==0 ){
             playSound(1, 100, 100);
         }
@@ -32,7 +32,7 @@ void setupOTA(const char* hostname) {
     ArduinoOTA.onError([](ota_error_t error) {
         ota_in_progress = false;
         playSound(1, 300, 300);
-        logError("Error[" + String(error) + "]: ");
+        logError("Error[%d]: ", error);
         if (error == OTA_AUTH_ERROR) logError("Auth Failed");
         else if (error == OTA_BEGIN_ERROR) logError("Begin Failed");
         else if (error == OTA_CONNECT_ERROR) logError("Connect Failed");
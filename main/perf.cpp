@@ -0,0 +1,66 @@
+#include "perf.h"
+
+static PerfCounter perfCounters[PERF_PATH_COUNT];
+
+static const uint32_t bucketBoundsUs[PERF_BUCKETS - 1] = { PERF_BUCKET_BOUNDS_US };
+static uint32_t bucketBoundsCycles[PERF_BUCKETS - 1];
+
+// Paths are timed from both cores
+static portMUX_TYPE perfMux = portMUX_INITIALIZER_UNLOCKED;
+
+void setupPerf() {
+    uint32_t cyclesPerUs = ESP.getCpuFreqMHz();
+    for (int i = 0; i < PERF_BUCKETS - 1; i++) {
+        bucketBoundsCycles[i] = bucketBoundsUs[i] * cyclesPerUs;
+    }
+}
+
+uint32_t perfBucketBoundUs(int bucket) {
+    return bucket < PERF_BUCKETS - 1 ? bucketBoundsUs[bucket] : 0;
+}
+
+void recordPerf(PerfPath path, uint32_t cycles) {
+    int bucket = 0;
+    while (bucket < PERF_BUCKETS - 1 && cycles > bucketBoundsCycles[bucket]) {
+        bucket++;
+    }
+
+    portENTER_CRITICAL(&perfMux);
+    PerfCounter& counter = perfCounters[path];
+    counter.buckets[bucket]++;
+    counter.calls++;
+    counter.totalCycles += cycles;
+    if (cycles > counter.maxCycles) {
+        counter.maxCycles = cycles;
+    }
+    portEXIT_CRITICAL(&perfMux);
+}
+
+void readPerf(PerfPath path, PerfCounter& counter) {
+    portENTER_CRITICAL(&perfMux);
+    counter = perfCounters[path];
+    portEXIT_CRITICAL(&perfMux);
+}
+
+const char* perfPathName(PerfPath path) {
+    switch (path) {
+        case PERF_NETWORK_PASS: return "network_pass";
+        case PERF_LOOP_LOGGING: return "logging";
+        case PERF_LOOP_HTTP: return "http";
+        case PERF_LOOP_WEBSOCKET: return "websocket";
+        case PERF_LOOP_CONNECTION: return "connection";
+        case PERF_LOOP_HASS: return "hass";
+        case PERF_RENDER_PASS: return "render_pass";
+        case PERF_ANIMATION_FRAME: return "animation_frame";
+        case PERF_COMPOSE: return "compose";
+        case PERF_SOUND: return "sound";
+        case PERF_HTTP_REQUEST: return "http_request";
+        case PERF_HTTP_ROUTE: return "http_route";
+        case PERF_HASS_MESSAGE: return "hass_message";
+        case PERF_STATUS_JSON: return "status_json";
+        case PERF_STATUS_DELTA: return "status_delta";
+        case PERF_LOG_MESSAGE: return "log_message";
+        case PERF_PATH_COUNT: break;
+    }
+    return "unknown";
+}
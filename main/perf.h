@@ -0,0 +1,64 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <Arduino.h>
+
+// --- Hot Path Timing ---
+// Cycle-counter timing of each stage of the network and render passes and
+// of the paths that run most often. Every path keeps a fixed-bucket latency
+// histogram and its maximum; /status reports calls, average and maximum ns
+// under "perf", /metrics the full histograms (see metrics.h). A PerfScope
+// times the enclosing block; it costs two cycle counter reads, a few
+// compares and a short critical section.
+
+enum PerfPath {
+    // Network pass and its stages
+    PERF_NETWORK_PASS,
+    PERF_LOOP_LOGGING,    // loopLogging()
+    PERF_LOOP_HTTP,       // handleHttpRequests()
+    PERF_LOOP_WEBSOCKET,  // handleWebSocket(), including pushes
+    PERF_LOOP_CONNECTION, // loopConnection()
+    PERF_LOOP_HASS,       // loopHass()
+    // Render pass and its stages
+    PERF_RENDER_PASS,
+    PERF_ANIMATION_FRAME, // renderAnimationFrame()
+    PERF_COMPOSE,         // composeLook()
+    PERF_SOUND,           // playSound()
+    // Handlers and hot paths
+    PERF_HTTP_REQUEST,    // Route lookup and handler
+    PERF_HTTP_ROUTE,      // Route table lookup only
+    PERF_HASS_MESSAGE,    // Parsing and applying one HA message
+    PERF_STATUS_JSON,     // Full /status document
+    PERF_STATUS_DELTA,    // WebSocket delta
+    PERF_LOG_MESSAGE,     // logX() into the ring
+    PERF_PATH_COUNT
+};
+
+// Upper bounds of the histogram buckets, in us; one more bucket holds the rest
+#define PERF_BUCKET_BOUNDS_US 10, 50, 100, 500, 1000, 5000, 10000, 50000, 100000
+#define PERF_BUCKETS          10
+
+struct PerfCounter {
+    uint32_t calls;
+    uint64_t totalCycles;
+    uint32_t maxCycles;
+    uint32_t buckets[PERF_BUCKETS]; // Not cumulative
+};
+
+void setupPerf(); // Converts the bucket bounds to cycles
+uint32_t perfBucketBoundUs(int bucket); // 0 for the last (unbounded) bucket
+void recordPerf(PerfPath path, uint32_t cycles);
+void readPerf(PerfPath path, PerfCounter& counter);
+const char* perfPathName(PerfPath path);
+
+class PerfScope {
+public:
+    explicit PerfScope(PerfPath path) : path(path), start(ESP.getCycleCount()) {}
+    ~PerfScope() { recordPerf(path, ESP.getCycleCount() - start); }
+
+private:
+    PerfPath path;
+    uint32_t start;
+};
+
+#endif // PERF_H
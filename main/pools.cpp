@@ -0,0 +1,117 @@
+#include "pools.h"
+#include <string.h>
+
+// Constant-initialized, so pools defined in other files can register from
+// their constructors regardless of initialization order
+static PoolUsage* pools[POOL_MAX_ENTRIES];
+static int registeredPools = 0;
+
+PoolUsage::PoolUsage(const char* name, size_t capacity)
+    : name(name), capacity(capacity), used(0), highWater(0), failures(0) {
+    if (registeredPools < POOL_MAX_ENTRIES) {
+        pools[registeredPools++] = this;
+    }
+}
+
+void PoolUsage::record(size_t nowUsed) {
+    used = nowUsed;
+    if (used > highWater) {
+        highWater = used;
+    }
+}
+
+void PoolUsage::fail() {
+    failures++;
+}
+
+int poolCount() {
+    return registeredPools;
+}
+
+const PoolUsage& getPool(int index) {
+    return *pools[index];
+}
+
+// --- JsonArena ---
+// Every block starts with an 8-byte header holding its size, which keeps
+// the payload 8-byte aligned and lets reallocate() copy the old contents.
+
+#define ARENA_HEADER   8
+#define ARENA_NO_BLOCK ((size_t)-1)
+
+static size_t alignBlock(size_t size) {
+    return (size + 7) & ~(size_t)7;
+}
+
+JsonArena::JsonArena(const char* name, uint8_t* buffer, size_t capacity)
+    : PoolUsage(name, capacity), buffer(buffer), top(0), lastBlock(ARENA_NO_BLOCK), liveBlocks(0) {}
+
+void JsonArena::reset() {
+    top = 0;
+    lastBlock = ARENA_NO_BLOCK;
+    liveBlocks = 0;
+    record(0);
+}
+
+void* JsonArena::allocate(size_t size) {
+    size_t need = ARENA_HEADER + alignBlock(size);
+    if (need > capacity - top) {
+        fail();
+        return nullptr;
+    }
+    uint8_t* block = buffer + top;
+    *(uint32_t*)block = size;
+    lastBlock = top;
+    top += need;
+    liveBlocks++;
+    record(top);
+    return block + ARENA_HEADER;
+}
+
+void JsonArena::deallocate(void* pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    size_t offset = (uint8_t*)pointer - buffer - ARENA_HEADER;
+    if (liveBlocks <= 1) {
+        reset();
+        return;
+    }
+    liveBlocks--;
+    if (offset == lastBlock) {
+        // Topmost block, its space can be reused right away
+        top = offset;
+        lastBlock = ARENA_NO_BLOCK;
+        record(top);
+    }
+}
+
+void* JsonArena::reallocate(void* pointer, size_t newSize) {
+    if (pointer == nullptr) {
+        return allocate(newSize);
+    }
+    size_t offset = (uint8_t*)pointer - buffer - ARENA_HEADER;
+    uint32_t* header = (uint32_t*)(buffer + offset);
+
+    if (offset == lastBlock) {
+        // Topmost block, grow or shrink in place
+        size_t need = ARENA_HEADER + alignBlock(newSize);
+        if (need > capacity - offset) {
+            fail();
+            return nullptr;
+        }
+        *header = newSize;
+        top = offset + need;
+        record(top);
+        return pointer;
+    }
+
+    size_t oldSize = *header;
+    void* moved = allocate(newSize);
+    if (moved == nullptr) {
+        return nullptr;
+    }
+    memcpy(moved, pointer, oldSize < newSize ? oldSize : newSize);
+    deallocate(pointer);
+    return moved;
+}
@@ -0,0 +1,76 @@
+#ifndef POOLS_H
+#define POOLS_H
+
+#include <ArduinoJson.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// --- Static Pools ---
+// Working buffers that would otherwise come from the heap on every request
+// or message (JSON documents, serialized payloads) are sized at compile time
+// and live in static RAM, so the steady state does not fragment the heap.
+// Every pool registers itself by name; /status and /metrics report size,
+// current use, high-water mark and failed requests for each, so the sizes
+// can be tuned from a running device.
+//
+// The sketch's own code does not allocate once booted (host test
+// test_steady_heap). What the libraries allocate inside is outside its
+// reach and remains:
+//  - ArduinoWebsockets reads each HA message into a String, and builds
+//    one for each message it sends; onMessage() only borrows the text
+//  - WebSocketsServer allocates a frame buffer per send and per client
+//  - WiFiClient holds a heap handle per accepted HTTP connection
+//  - LittleFS file handles (history segments) and NVS writes (warm start)
+
+#define POOL_MAX_ENTRIES 8
+
+class PoolUsage {
+public:
+    PoolUsage(const char* name, size_t capacity);
+
+    void record(size_t used); // Current use, updates the high-water mark
+    void fail();              // A request that did not fit
+
+    const char* name;
+    size_t capacity;
+    size_t used;
+    size_t highWater;
+    uint32_t failures;
+};
+
+int poolCount();
+const PoolUsage& getPool(int index);
+
+// Bump allocator over a fixed buffer for one JsonDocument (or a few nested
+// ones). Blocks are carved off the top; freeing the topmost block gives its
+// space back, and the whole arena starts over once nothing is live. A
+// request that does not fit fails, and ArduinoJson marks the document as
+// overflowed instead of growing the heap.
+class JsonArena : public ArduinoJson::Allocator, public PoolUsage {
+public:
+    JsonArena(const char* name, uint8_t* buffer, size_t capacity);
+
+    void* allocate(size_t size) override;
+    void deallocate(void* pointer) override;
+    void* reallocate(void* pointer, size_t newSize) override;
+
+    // Drops every block at once; only when no document references the arena
+    void reset();
+
+private:
+    uint8_t* buffer;
+    size_t top;
+    size_t lastBlock; // Offset of the topmost block's header
+    size_t liveBlocks;
+};
+
+template <size_t SIZE>
+class StaticJsonArena : public JsonArena {
+public:
+    explicit StaticJsonArena(const char* name) : JsonArena(name, storage, SIZE) {}
+
+private:
+    alignas(8) uint8_t storage[SIZE];
+};
+
+#endif // POOLS_H
@@ -0,0 +1,155 @@
+#include "render.h"
+#include "animation.h"
+#include "display.h"
+#include "entities.h"
+#include "perf.h"
+#include "sync.h"
+
+static SeqLock<DisplayState> publishedState;
+static SpscQueue<EntityEvent, ENTITY_EVENT_QUEUE_SIZE> entityEvents;
+static RenderStats renderStats;
+static NetworkStats networkStats;
+static TaskHandle_t renderTaskHandle = nullptr;
+
+// Network side: last state handed to the seqlock
+static DisplayState lastPublished;
+static bool anyPublished = false;
+
+// Render side: the copy composeLook() works from
+static DisplayState renderState;
+static uint32_t renderStateVersion = 0;
+static unsigned long nextTickUs = 0;
+static bool ticking = false;
+
+static void wakeRenderer() {
+    if (renderTaskHandle != nullptr) {
+        xTaskNotifyGive(renderTaskHandle);
+    }
+}
+
+// --- Network Side ---
+
+void publishDisplayState() {
+    DisplayState state;
+    memset(&state, 0, sizeof(state));
+    state.wifiConnected = wifi_connected;
+    state.wsConnected = ws_connected;
+    state.shouldRender = should_render;
+    state.statesStale = statesStale;
+    state.brightness = displayBrightness;
+    memcpy(state.states, entityStates, sizeof(state.states));
+
+    if (anyPublished && memcmp(&state, &lastPublished, sizeof(state)) == 0) {
+        return;
+    }
+    publishedState.write(state);
+    lastPublished = state;
+    anyPublished = true;
+    wakeRenderer();
+}
+
+void postEntityEvent(int index, EntityState state) {
+    EntityEvent event = { (uint8_t)index, state };
+    if (!entityEvents.push(event)) {
+        // The snapshot still carries the new state, only the beep is lost
+        renderStats.eventsDropped++;
+    }
+    wakeRenderer();
+}
+
+// --- Render Side ---
+
+static void recordTick(unsigned long nowUs) {
+    uint32_t late = nowUs - nextTickUs;
+    renderStats.ticks++;
+    renderStats.lastLateUs = late;
+    renderStats.avgLateUs = (int32_t)renderStats.avgLateUs + ((int32_t)late - (int32_t)renderStats.avgLateUs) / 16;
+    if (late > renderStats.maxLateUs) {
+        renderStats.maxLateUs = late;
+    }
+
+    nextTickUs += ANIMATION_FRAME_US;
+    if ((long)(nowUs - nextTickUs) >= 0) {
+        // More than a whole frame behind, drop the missed frames instead of bursting
+        renderStats.framesDropped += (nowUs - nextTickUs) / ANIMATION_FRAME_US + 1;
+        nextTickUs = nowUs + ANIMATION_FRAME_US;
+    }
+}
+
+void renderPass() {
+    PerfScope perf(PERF_RENDER_PASS);
+    bool changed = false;
+
+    // The new state itself arrives through the snapshot below
+    EntityEvent event;
+    while (entityEvents.pop(event)) {
+        playEntitySound(event.index, event.state);
+    }
+
+    if (publishedState.version() != renderStateVersion) {
+        renderStateVersion = publishedState.version();
+        publishedState.read(renderState);
+        setDisplayBrightness(renderState.brightness);
+        startStateFade(millis());
+        changed = true;
+    }
+
+    unsigned long nowUs = micros();
+    if (!ticking) {
+        ticking = true;
+        nextTickUs = nowUs;
+    }
+    if ((long)(nowUs - nextTickUs) >= 0) {
+        recordTick(nowUs);
+        changed = changed || renderState.shouldRender || animationFading();
+    }
+
+    if (changed) {
+        renderAnimationFrame(millis());
+    }
+}
+
+static void renderTask(void* parameter) {
+    for (;;) {
+        renderPass();
+
+        // Sleep until the next tick, or until the network side wakes us up
+        long waitUs = (long)(nextTickUs - micros());
+        TickType_t wait = waitUs > 0 ? pdMS_TO_TICKS((waitUs + 999) / 1000) : 0;
+        ulTaskNotifyTake(pdTRUE, wait > 0 ? wait : 1);
+    }
+}
+
+void startRenderTask() {
+    xTaskCreatePinnedToCore(renderTask, "render", RENDER_TASK_STACK, nullptr,
+                            RENDER_TASK_PRIORITY, &renderTaskHandle, RENDER_TASK_CORE);
+}
+
+const DisplayState& getRenderState() {
+    return renderState;
+}
+
+const RenderStats& getRenderStats() {
+    return renderStats;
+}
+
+static unsigned long lastPassEndUs = 0;
+
+void recordNetworkPass(unsigned long startUs, unsigned long endUs) {
+    uint32_t passUs = endUs - startUs;
+    if (networkStats.passes > 0 && startUs - lastPassEndUs > networkStats.maxGapUs) {
+        networkStats.maxGapUs = startUs - lastPassEndUs;
+    }
+    lastPassEndUs = endUs;
+
+    networkStats.passes++;
+    networkStats.lastPassUs = passUs;
+    networkStats.avgPassUs = (int32_t)networkStats.avgPassUs + ((int32_t)passUs - (int32_t)networkStats.avgPassUs) / 16;
+    if (passUs > networkStats.maxPassUs) {
+        networkStats.maxPassUs = passUs;
+    }
+}
+
+const NetworkStats& getNetworkStats() {
+    return networkStats;
+}
@@ -0,0 +1,75 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "declarations.h"
+
+// --- Render Task ---
+// The display runs in its own task pinned to RENDER_TASK_CORE, while WiFi,
+// Home Assistant, HTTP and logging run in the network task on the other
+// core. The network side owns the connection flags and entity states and
+// publishes a copy of what the display needs (DisplayState) through a
+// seqlock; state changes from Home Assistant are also queued as
+// EntityEvents so the render side can react to each one (beeps).
+// The render task wakes every ANIMATION_FRAME_US (see animation.h).
+//
+// With RENDER_TASK set to 0 both passes run from loop() as before, which is
+// useful to compare the render tick jitter reported in /status.
+
+#ifndef RENDER_TASK
+#define RENDER_TASK             1 // The host build (CMakeLists.txt) sets 0
+#endif
+#define RENDER_TASK_CORE        1
+#define RENDER_TASK_PRIORITY    3
+#define RENDER_TASK_STACK       4096
+#define NETWORK_TASK_CORE       0
+#define NETWORK_TASK_PRIORITY   1
+#define NETWORK_TASK_STACK      8192
+#define ENTITY_EVENT_QUEUE_SIZE 16 // Power of two
+
+// What the renderer needs from the network side
+struct DisplayState {
+    bool wifiConnected;
+    bool wsConnected;
+    bool shouldRender;
+    bool statesStale;
+    uint8_t brightness;
+    EntityState states[MAX_ENTITIES];
+};
+
+struct EntityEvent {
+    uint8_t index;
+    EntityState state;
+};
+
+struct RenderStats {
+    uint32_t ticks;
+    uint32_t lastLateUs; // How late the last animation tick started
+    uint32_t avgLateUs;  // Moving average over ~16 ticks
+    uint32_t maxLateUs;
+    uint32_t framesDropped; // Ticks skipped because the task fell behind
+    uint32_t eventsDropped;
+};
+
+// Time spent in one networkPass()
+struct NetworkStats {
+    uint32_t passes;
+    uint32_t lastPassUs;
+    uint32_t avgPassUs;  // Moving average over ~16 passes
+    uint32_t maxPassUs;
+    uint32_t maxGapUs;   // Longest time between two passes
+};
+
+// Network side
+void publishDisplayState(); // Cheap when nothing changed
+void postEntityEvent(int index, EntityState state);
+
+// Render side
+void startRenderTask();
+void renderPass();
+const DisplayState& getRenderState();
+
+const RenderStats& getRenderStats();
+void recordNetworkPass(unsigned long startUs, unsigned long endUs);
+const NetworkStats& getNetworkStats();
+
+#endif // RENDER_H
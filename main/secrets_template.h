@@ -18,7 +18,7 @@
 #define SENSOR_2_ENTITY_ID "sensor.sensor_2"
 #define SENSOR_3_ENTITY_ID "sensor.sensor_3"
 
-// Log UDP endpoint (for compatibility with logging.cpp)
+// Log UDP endpoint, see http-server/server.py (remove LOG_UDP_IP to disable shipping)
 #define LOG_UDP_IP "logger.local"
-#define LOG_UDP_PORT 12201
+#define LOG_UDP_PORT 9999
 
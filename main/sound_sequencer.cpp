@@ -0,0 +1,87 @@
+#include "sound_sequencer.h"
+
+static bool samePattern(const SoundPattern& a, const SoundPattern& b) {
+    return a.beeps == b.beeps && a.gap == b.gap && a.duration == b.duration;
+}
+
+SoundSequencer::SoundSequencer()
+    : played(0), merged(0), dropped(0), head(0), count(0),
+      current{0, 0, 0}, remaining(0), phase(IDLE), phaseStart(0), phaseLength(0) {}
+
+bool SoundSequencer::enqueue(SoundPattern pattern, unsigned long now) {
+    if (pattern.beeps == 0) {
+        return false;
+    }
+
+    // Merge with the pattern that would play right before this one
+    if (count > 0) {
+        if (samePattern(queue[(head + count - 1) % SOUND_QUEUE_SIZE], pattern)) {
+            merged++;
+            return false;
+        }
+    } else if ((phase == TONE || phase == GAP) && samePattern(current, pattern)) {
+        merged++;
+        return false;
+    }
+
+    // Queue full: drop the oldest waiting pattern
+    if (count == SOUND_QUEUE_SIZE) {
+        head = (head + 1) % SOUND_QUEUE_SIZE;
+        count--;
+        dropped++;
+    }
+
+    queue[(head + count) % SOUND_QUEUE_SIZE] = pattern;
+    count++;
+
+    if (phase == IDLE) {
+        startNext(now);
+    }
+    return true;
+}
+
+bool SoundSequencer::update(unsigned long now) {
+    // Catch up on every phase that ended before 'now'
+    while (phase != IDLE && now - phaseStart >= phaseLength) {
+        unsigned long end = phaseStart + phaseLength;
+        switch (phase) {
+            case TONE:
+                if (remaining > 0) {
+                    enterPhase(GAP, end, current.gap);
+                } else {
+                    enterPhase(PAUSE, end, SOUND_PATTERN_PAUSE);
+                }
+                break;
+            case GAP:
+                remaining--;
+                enterPhase(TONE, end, current.duration);
+                break;
+            case PAUSE:
+                if (count > 0) {
+                    startNext(end);
+                } else {
+                    phase = IDLE;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return isOn();
+}
+
+void SoundSequencer::startNext(unsigned long now) {
+    current = queue[head];
+    head = (head + 1) % SOUND_QUEUE_SIZE;
+    count--;
+    remaining = current.beeps - 1;
+    played++;
+    enterPhase(TONE, now, current.duration);
+}
+
+void SoundSequencer::enterPhase(Phase next, unsigned long start, unsigned long length) {
+    phase = next;
+    phaseStart = start;
+    // A zero length phase would stall the deadline, so keep at least 1 ms
+    phaseLength = length > 0 ? length : 1;
+}
@@ -0,0 +1,64 @@
+#ifndef SOUND_SEQUENCER_H
+#define SOUND_SEQUENCER_H
+
+#include <stdint.h>
+
+// --- Sound Settings ---
+#define SOUND_QUEUE_SIZE    4
+#define SOUND_PATTERN_PAUSE 150 // Silence between two queued patterns (ms)
+
+// A beep pattern as requested by playSound(beeps, gap, duration).
+struct SoundPattern {
+    uint8_t beeps;
+    uint16_t gap;
+    uint16_t duration;
+};
+
+// Millis-driven beep sequencer. It has no Arduino dependencies: the caller
+// passes the current time in, so it can be driven by a hardware timer on the
+// device or by a fake clock on the host.
+//
+// Overlap policy:
+//  - A pattern identical to the last queued one (or to the one currently
+//    sounding when nothing is queued) is merged, so a burst of identical
+//    events beeps once.
+//  - When the queue is full, the oldest queued pattern is dropped so the most
+//    recent state change is always heard.
+class SoundSequencer {
+public:
+    SoundSequencer();
+
+    // Queue a pattern. Returns false when it was merged or ignored.
+    bool enqueue(SoundPattern pattern, unsigned long now);
+
+    // Advance the sequence up to 'now'. Returns true while the buzzer should sound.
+    bool update(unsigned long now);
+
+    bool isBusy() const { return phase != IDLE; }
+    bool isOn() const { return phase == TONE; }
+
+    // Time (ms) at which the current phase ends. Only meaningful while busy.
+    unsigned long nextDeadline() const { return phaseStart + phaseLength; }
+
+    uint32_t played;
+    uint32_t merged;
+    uint32_t dropped;
+
+private:
+    enum Phase { IDLE, TONE, GAP, PAUSE };
+
+    SoundPattern queue[SOUND_QUEUE_SIZE];
+    uint8_t head;
+    uint8_t count;
+
+    SoundPattern current;
+    uint8_t remaining;
+    Phase phase;
+    unsigned long phaseStart;
+    unsigned long phaseLength;
+
+    void startNext(unsigned long now);
+    void enterPhase(Phase next, unsigned long start, unsigned long length);
+};
+
+#endif // SOUND_SEQUENCER_H
@@ -0,0 +1,125 @@
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// --- Sprites ---
+// Patterns are declared as ASCII art and compiled into per-color bitplanes
+// at compile time, so they live in flash and cost no RAM. The canvas is cut
+// into tiles of TILE_WIDTH x TILE_HEIGHT pixels, one 32-bit word per color
+// and tile (bit = row * TILE_WIDTH + col), which is exactly one bike slot.
+//
+// Art characters, in enum Color order:
+//   K black, W white, R red, G green, B blue, Y yellow, C cyan, M magenta
+//   anything else is transparent ('.' by convention)
+//
+// No Arduino dependencies, so this header compiles on the host as well.
+
+#define TILE_WIDTH    4
+#define TILE_HEIGHT   8
+#define TILE_PIXELS   (TILE_WIDTH * TILE_HEIGHT)
+#define SPRITE_COLORS 8
+
+struct Tile {
+    uint32_t cover; // Pixels this tile paints, any color
+    uint32_t planes[SPRITE_COLORS];
+};
+
+// A sprite TILES tiles wide and one tile high
+template <size_t TILES>
+struct Sprite {
+    Tile tiles[TILES];
+};
+
+constexpr int spriteColor(char c) {
+    return c == 'K' ? 0 :
+           c == 'W' ? 1 :
+           c == 'R' ? 2 :
+           c == 'G' ? 3 :
+           c == 'B' ? 4 :
+           c == 'Y' ? 5 :
+           c == 'C' ? 6 :
+           c == 'M' ? 7 : -1;
+}
+
+// Rows are concatenated: sprite("...." "..Y." ...), TILE_HEIGHT rows of
+// TILE_WIDTH * TILES characters
+template <size_t N>
+constexpr Sprite<(N - 1) / TILE_PIXELS> sprite(const char (&art)[N]) {
+    static_assert(TILE_WIDTH == 4 && TILE_HEIGHT == 8, "expandTiles() assumes 4x8 tiles");
+    static_assert(N > 1 && (N - 1) % TILE_PIXELS == 0, "Sprite art must be TILE_HEIGHT rows of whole tiles");
+    Sprite<(N - 1) / TILE_PIXELS> result = {};
+    const size_t width = (N - 1) / TILE_HEIGHT;
+    for (size_t i = 0; i < N - 1; i++) {
+        int color = spriteColor(art[i]);
+        if (color < 0) {
+            continue;
+        }
+        size_t row = i / width;
+        size_t col = i % width;
+        uint32_t bit = 1UL << (row * TILE_WIDTH + col % TILE_WIDTH);
+        result.tiles[col / TILE_WIDTH].planes[color] |= bit;
+        result.tiles[col / TILE_WIDTH].cover |= bit;
+    }
+    return result;
+}
+
+// Paints src over dst, moved down by `rows` (pixels pushed past the bottom
+// are dropped). Later paints win, like successive pixel writes.
+inline void paintTile(Tile& dst, const Tile& src, unsigned rows = 0) {
+    unsigned shift = rows * TILE_WIDTH;
+    if (shift >= TILE_PIXELS) {
+        return;
+    }
+    uint32_t cover = src.cover << shift;
+    for (int c = 0; c < SPRITE_COLORS; c++) {
+        dst.planes[c] = (dst.planes[c] & ~cover) | (src.planes[c] << shift);
+    }
+    dst.cover |= cover;
+}
+
+template <size_t TILES>
+inline void paintSprite(Tile* canvas, const Sprite<TILES>& src, unsigned rows = 0) {
+    for (size_t t = 0; t < TILES; t++) {
+        paintTile(canvas[t], src.tiles[t], rows);
+    }
+}
+
+// Spreads the 4 bits of a tile row into one bit per byte, 0x00 or 0x01
+static const uint32_t SPRITE_NIBBLE_SPREAD[16] = {
+    0x00000000, 0x00000001, 0x00000100, 0x00000101,
+    0x00010000, 0x00010001, 0x00010100, 0x00010101,
+    0x01000000, 0x01000001, 0x01000100, 0x01000101,
+    0x01010000, 0x01010001, 0x01010100, 0x01010101
+};
+
+// Writes the color index of every pixel into cells (row-major, `width`
+// cells per row); pixels no sprite covered are BLACK. Painting keeps the
+// planes of a tile disjoint, so the three bits of the color index are plain
+// ORs of planes, and each row of four cells is built from three lookups.
+inline void expandTiles(const Tile* canvas, int tilesX, int tilesY, uint8_t* cells, int width) {
+    for (int ty = 0; ty < tilesY; ty++) {
+        for (int tx = 0; tx < tilesX; tx++) {
+            const Tile& tile = canvas[ty * tilesX + tx];
+            const uint32_t* p = tile.planes;
+            uint32_t bit0 = p[1] | p[3] | p[5] | p[7];
+            uint32_t bit1 = p[2] | p[3] | p[6] | p[7];
+            uint32_t bit2 = p[4] | p[5] | p[6] | p[7];
+
+            uint8_t* out = cells + ty * TILE_HEIGHT * width + tx * TILE_WIDTH;
+            for (int row = 0; row < TILE_HEIGHT; row++, out += width) {
+                int shift = row * TILE_WIDTH;
+                uint32_t word = SPRITE_NIBBLE_SPREAD[(bit0 >> shift) & 0xF] |
+                                SPRITE_NIBBLE_SPREAD[(bit1 >> shift) & 0xF] << 1 |
+                                SPRITE_NIBBLE_SPREAD[(bit2 >> shift) & 0xF] << 2;
+                out[0] = word;
+                out[1] = word >> 8;
+                out[2] = word >> 16;
+                out[3] = word >> 24;
+            }
+        }
+    }
+}
+
+#endif // SPRITES_H
@@ -0,0 +1,391 @@
+#include "status.h"
+#include "display.h"
+#include "logging.h"
+#include "buffered_print.h"
+#include "entities.h"
+#include "connection.h"
+#include "render.h"
+#include "animation.h"
+#include "http_server.h"
+#include "perf.h"
+#include "pools.h"
+#include "history.h"
+#include "warmstart.h"
+#include "boot.h"
+#include <esp_heap_caps.h>
+
+static StaticJsonArena<STATUS_ARENA_SIZE> statusArena("status_json");
+static JsonDocument statusDoc(&statusArena);
+static uint32_t snapshotVersion = 0;
+static bool snapshotValid = false;
+static size_t snapshotLength = 0;
+
+static char statusText[STATUS_TEXT_SIZE];
+static PoolUsage statusTextUsage("status_text", STATUS_TEXT_SIZE);
+static bool statusTextValid = false;
+static bool statusTextFits = false;
+
+static StaticJsonArena<DELTA_ARENA_SIZE> deltaArena("delta_json");
+static JsonDocument deltaDoc(&deltaArena);
+static char deltaText[DELTA_TEXT_SIZE];
+static PoolUsage deltaTextUsage("delta_text", DELTA_TEXT_SIZE);
+
+static uint32_t stateRevision = 0;
+static uint32_t bootId = 0;
+
+// What the WebSocket subscribers have last been sent
+struct PushedStatus {
+    bool wifiConnected;
+    bool wsConnected;
+    bool shouldRender;
+    bool statesStale;
+    uint8_t brightness;
+    long wifiLastConnectAttempt;
+    EntityState states[MAX_ENTITIES];
+    unsigned long logSeq;
+};
+static PushedStatus pushed;
+
+void notifyStatusChanged() {
+    stateRevision++;
+}
+
+uint32_t getStatusVersion() {
+    // Keyframes, not every frame: the blends in between would change the
+    // version 40 times a second. The tick keeps uptime, heap and the clock
+    // from being served (or 304'd) stale while nothing else changes.
+    return stateRevision + logSequence + keyframesShown + millis() / STATUS_LIVE_INTERVAL;
+}
+
+static void addDisplayArray(JsonDocument& jsonDoc) {
+    ShownFrame frame;
+    readShownFrame(frame);
+
+    JsonArray displayData = jsonDoc["displayArray"].to<JsonArray>();
+    for (int i = 0; i < MATRIX_HEIGHT; i++) {
+        JsonArray row = displayData.add<JsonArray>();
+        for (int j = 0; j < MATRIX_WIDTH; j++) {
+            row.add(getShownColor(frame, i, j));
+        }
+    }
+}
+
+static void addLinkStats(JsonObject link, const LinkStats& stats) {
+    unsigned long now = millis();
+    link["state"] = linkStateName(stats.state);
+    link["state_ms"] = now - stats.stateSince;
+    if (stats.state != LINK_UP) {
+        link["down_ms"] = now - stats.downSince;
+    }
+    link["attempts"] = stats.attempts;
+    link["total_attempts"] = stats.totalAttempts;
+    link["reconnects"] = stats.reconnects;
+    link["last_reconnect_ms"] = stats.lastOutage;
+    link["total_down_ms"] = stats.totalOutage;
+}
+
+static void addRenderStats(JsonObject render) {
+    const RenderStats& stats = getRenderStats();
+    render["task"] = RENDER_TASK == 1;
+    render["ticks"] = stats.ticks;
+    render["tick_late_us"] = stats.lastLateUs;
+    render["tick_late_avg_us"] = stats.avgLateUs;
+    render["tick_late_max_us"] = stats.maxLateUs;
+    render["frames_dropped"] = stats.framesDropped;
+    render["events_dropped"] = stats.eventsDropped;
+}
+
+static void addNetworkStats(JsonObject network) {
+    const NetworkStats& stats = getNetworkStats();
+    network["passes"] = stats.passes;
+    network["pass_us"] = stats.lastPassUs;
+    network["pass_avg_us"] = stats.avgPassUs;
+    network["pass_max_us"] = stats.maxPassUs;
+    network["gap_max_us"] = stats.maxGapUs;
+    network["frames_pushed"] = getFramesPushed();
+}
+
+static void addPerfStats(JsonObject perf) {
+    uint32_t cyclesPerUs = ESP.getCpuFreqMHz();
+    for (int i = 0; i < PERF_PATH_COUNT; i++) {
+        PerfCounter counter;
+        readPerf((PerfPath)i, counter);
+        JsonObject path = perf[perfPathName((PerfPath)i)].to<JsonObject>();
+        path["calls"] = counter.calls;
+        path["avg_ns"] = counter.calls > 0 ? (uint32_t)(counter.totalCycles * 1000 / cyclesPerUs / counter.calls) : 0;
+        path["max_ns"] = (uint32_t)((uint64_t)counter.maxCycles * 1000 / cyclesPerUs);
+    }
+}
+
+static void addAnimationStats(JsonObject animation) {
+    const AnimationStats& stats = getAnimationStats();
+    animation["fps"] = ANIMATION_FPS;
+    animation["budget_us"] = ANIMATION_FRAME_BUDGET_US;
+    animation["frames"] = stats.frames;
+    animation["frame_us"] = stats.lastFrameUs;
+    animation["frame_avg_us"] = stats.avgFrameUs;
+    animation["frame_max_us"] = stats.maxFrameUs;
+    animation["overruns"] = stats.overruns;
+    animation["degraded"] = stats.degraded;
+}
+
+static void addHistoryStats(JsonObject history) {
+    const HistoryStats& stats = getHistoryStats();
+    history["events"] = stats.events;
+    history["bytes"] = stats.bytes;
+    history["capacity"] = HISTORY_RAM_SIZE;
+    history["first_seq"] = stats.firstSeq;
+    history["persisted"] = stats.persisted;
+    history["segment"] = stats.segment;
+    history["write_errors"] = stats.writeErrors;
+    history["untimed_dropped"] = stats.untimedDropped;
+}
+
+static void addWarmStartStats(JsonObject warm) {
+    const WarmStartStats& stats = getWarmStartStats();
+    warm["source"] = warmSourceName(stats.source);
+    warm["restored_ms"] = stats.restoredAtMs;
+    warm["nvs_writes"] = stats.nvsWrites;
+    warm["nvs_errors"] = stats.nvsErrors;
+}
+
+// ms since boot when the stage completed, null while it has not
+static void addBootTime(JsonObject boot, const char* key, BootStage stage) {
+    const BootTiming& timing = getBootTiming(stage);
+    if (timing.done) {
+        boot[key] = timing.doneMs;
+    } else {
+        boot[key] = nullptr;
+    }
+}
+
+static void addBootStats(JsonObject boot) {
+    addBootTime(boot, "first_frame_ms", BOOT_DISPLAY);
+    addBootTime(boot, "network_ms", BOOT_WIFI);
+    addBootTime(boot, "valid_state_ms", BOOT_STATE);
+    JsonObject stages = boot["stages"].to<JsonObject>();
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        addBootTime(stages, bootStageName((BootStage)i), (BootStage)i);
+    }
+}
+
+static void addPoolStats(JsonObject pools) {
+    for (int i = 0; i < poolCount(); i++) {
+        const PoolUsage& usage = getPool(i);
+        JsonObject pool = pools[usage.name].to<JsonObject>();
+        pool["size"] = usage.capacity;
+        pool["used"] = usage.used;
+        pool["high_water"] = usage.highWater;
+        pool["failures"] = usage.failures;
+    }
+}
+
+// Formatted into stack buffers rather than through String
+static void formatIpAddress(char* out, size_t size) {
+    IPAddress ip = WiFi.localIP();
+    snprintf(out, size, "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+}
+
+static void formatCurrentTime(char* out, size_t size) {
+    snprintf(out, size, "%02d:%02d:%02d", timeClient.getHours(), timeClient.getMinutes(), timeClient.getSeconds());
+}
+
+static void buildStatus(JsonDocument& jsonDoc) {
+    jsonDoc.clear();
+    char text[16];
+    jsonDoc["uptime"] = millis() / 1000;
+    formatIpAddress(text, sizeof(text));
+    jsonDoc["ip_address"] = text;
+    jsonDoc["wifi_connected"] = wifi_connected;
+    jsonDoc["ws_connected"] = ws_connected;
+    char key[24];
+    for (int i = 0; i < entityCount; i++) {
+        snprintf(key, sizeof(key), "sensor_%d_state", i + 1);
+        jsonDoc[key] = stateName(entityStates[i]);
+    }
+    jsonDoc["states_stale"] = statesStale;
+    jsonDoc["displayBrightness"] = displayBrightness;
+    jsonDoc["should_render"] = should_render;
+    jsonDoc["log_level"] = logLevelName(logRuntimeLevel);
+    jsonDoc["log_lines_shipped"] = logLinesShipped;
+    jsonDoc["log_lines_dropped"] = logLinesDropped;
+    jsonDoc["free_heap"] = ESP.getFreeHeap();
+    jsonDoc["min_free_heap"] = ESP.getMinFreeHeap();
+    jsonDoc["largest_free_block"] = ESP.getMaxAllocHeap();
+    // Live allocations; a count that keeps growing is a leak
+    multi_heap_info_t heap;
+    heap_caps_get_info(&heap, MALLOC_CAP_8BIT);
+    jsonDoc["heap_blocks"] = heap.allocated_blocks;
+    jsonDoc["frames_composed"] = framesComposed;
+    jsonDoc["frames_shown"] = framesShown;
+    jsonDoc["keyframes_shown"] = keyframesShown;
+    jsonDoc["wifi_last_connect_attempt"] = wifiLastConnectAttempt / 1000;
+    addLinkStats(jsonDoc["wifi_link"].to<JsonObject>(), getWifiStats());
+    addLinkStats(jsonDoc["hass_link"].to<JsonObject>(), getHassStats());
+    addRenderStats(jsonDoc["render"].to<JsonObject>());
+    addAnimationStats(jsonDoc["animation"].to<JsonObject>());
+    addNetworkStats(jsonDoc["network"].to<JsonObject>());
+    addPerfStats(jsonDoc["perf"].to<JsonObject>());
+    addPoolStats(jsonDoc["pools"].to<JsonObject>());
+    addHistoryStats(jsonDoc["history"].to<JsonObject>());
+    addWarmStartStats(jsonDoc["warm_start"].to<JsonObject>());
+    addBootStats(jsonDoc["boot"].to<JsonObject>());
+    formatCurrentTime(text, sizeof(text));
+    jsonDoc["current_time"] = text;
+    jsonDoc["status_version"] = snapshotVersion;
+    jsonDoc["log_seq"] = logSequence;
+
+    // Newest first, as the control panel expects
+    char line[LOG_LINE_SIZE];
+    LogEntry entry;
+    JsonArray logData = jsonDoc["logBuffer"].to<JsonArray>();
+    for (unsigned long seq = logSequence; seq >= firstLogSequence() && seq > 0; seq--) {
+        if (readLogEntry(seq, entry)) {
+            formatLogEntry(entry, line, sizeof(line));
+            logData.add(line);
+        }
+    }
+
+    addDisplayArray(jsonDoc);
+}
+
+static void refreshSnapshot() {
+    uint32_t version = getStatusVersion();
+    if (snapshotValid && version == snapshotVersion) {
+        return;
+    }
+
+    if (bootId == 0) {
+        // Keeps ETags from a previous boot from matching this one
+        bootId = esp_random() | 1;
+    }
+
+    PerfScope perf(PERF_STATUS_JSON);
+    snapshotVersion = version;
+    // Nothing else holds blocks from the arena, so it can start over
+    statusDoc.clear();
+    statusArena.reset();
+    buildStatus(statusDoc);
+    snapshotLength = measureJson(statusDoc);
+    snapshotValid = true;
+    statusTextValid = false;
+}
+
+static void formatETag(char* etag, size_t size) {
+    snprintf(etag, size, "\"%08lx-%lu\"", (unsigned long)bootId, (unsigned long)snapshotVersion);
+}
+
+void sendStatusHttp(WiFiClient& client, const char* ifNoneMatch, bool keepAlive) {
+    refreshSnapshot();
+
+    char etag[24];
+    formatETag(etag, sizeof(etag));
+
+    BufferedPrint out(client);
+    if (ifNoneMatch != nullptr && strstr(ifNoneMatch, etag) != nullptr) {
+        out.print(F("HTTP/1.1 304 Not Modified\r\n"));
+        out.print(F("ETag: "));
+        out.print(etag);
+        out.print(F("\r\nAccess-Control-Allow-Origin: *\r\n"));
+        out.print(keepAlive ? F("Connection: keep-alive\r\n\r\n") : F("Connection: close\r\n\r\n"));
+        return;
+    }
+
+    out.print(F("HTTP/1.1 200 OK\r\n"));
+    out.print(F("Content-Type: application/json\r\n"));
+    out.print(F("Content-Length: "));
+    out.print((unsigned long)snapshotLength);
+    out.print(F("\r\nETag: "));
+    out.print(etag);
+    out.print(F("\r\nCache-Control: no-cache\r\n"));
+    out.print(F("Access-Control-Allow-Origin: *\r\n"));
+    out.print(F("Access-Control-Expose-Headers: ETag\r\n"));
+    out.print(keepAlive ? F("Connection: keep-alive\r\n\r\n") : F("Connection: close\r\n\r\n"));
+    serializeJson(statusDoc, out);
+}
+
+const char* getStatusJson(size_t& length) {
+    refreshSnapshot();
+    if (!statusTextValid) {
+        statusTextValid = true;
+        statusTextFits = snapshotLength < sizeof(statusText);
+        if (statusTextFits) {
+            serializeJson(statusDoc, statusText, sizeof(statusText));
+            statusTextUsage.record(snapshotLength + 1);
+        } else {
+            statusTextUsage.fail();
+        }
+    }
+    length = snapshotLength;
+    return statusTextFits ? statusText : nullptr;
+}
+
+const char* buildStatusDelta(size_t& length, bool& changes) {
+    PerfScope perf(PERF_STATUS_DELTA);
+    deltaDoc.clear();
+    deltaArena.reset();
+
+    char text[16];
+    deltaDoc["type"] = "delta";
+    deltaDoc["uptime"] = millis() / 1000;
+    deltaDoc["free_heap"] = ESP.getFreeHeap();
+    formatCurrentTime(text, sizeof(text));
+    deltaDoc["current_time"] = text;
+    size_t alwaysSent = deltaDoc.size();
+
+    if (pushed.wifiConnected != wifi_connected) deltaDoc["wifi_connected"] = wifi_connected;
+    if (pushed.wsConnected != ws_connected) deltaDoc["ws_connected"] = ws_connected;
+    if (pushed.shouldRender != should_render) deltaDoc["should_render"] = should_render;
+    if (pushed.statesStale != statesStale) deltaDoc["states_stale"] = statesStale;
+    if (pushed.brightness != displayBrightness) deltaDoc["displayBrightness"] = displayBrightness;
+    if (pushed.wifiLastConnectAttempt != wifiLastConnectAttempt) {
+        deltaDoc["wifi_last_connect_attempt"] = wifiLastConnectAttempt / 1000;
+    }
+    char key[24];
+    for (int i = 0; i < entityCount; i++) {
+        if (pushed.states[i] != entityStates[i]) {
+            snprintf(key, sizeof(key), "sensor_%d_state", i + 1);
+            deltaDoc[key] = stateName(entityStates[i]);
+        }
+    }
+
+    if (pushed.logSeq != logSequence) {
+        // Lines older than the ring are gone; clients see the gap in "seq"
+        unsigned long seq = max(pushed.logSeq + 1, firstLogSequence());
+        char line[LOG_LINE_SIZE];
+        LogEntry logEntry;
+
+        JsonArray logs = deltaDoc["logs"].to<JsonArray>();
+        for (; seq <= logSequence; seq++) {
+            if (!readLogEntry(seq, logEntry)) {
+                continue;
+            }
+            formatLogEntry(logEntry, line, sizeof(line));
+            JsonObject entry = logs.add<JsonObject>();
+            entry["seq"] = seq;
+            entry["line"] = line;
+        }
+        deltaDoc["log_seq"] = logSequence;
+    }
+
+    changes = deltaDoc.size() > alwaysSent;
+    length = measureJson(deltaDoc);
+    if (length >= sizeof(deltaText)) {
+        deltaTextUsage.fail();
+        return nullptr;
+    }
+    serializeJson(deltaDoc, deltaText, sizeof(deltaText));
+    deltaTextUsage.record(length + 1);
+    return deltaText;
+}
+
+void markStatusPushed() {
+    pushed.wifiConnected = wifi_connected;
+    pushed.wsConnected = ws_connected;
+    pushed.shouldRender = should_render;
+    pushed.statesStale = statesStale;
+    pushed.brightness = displayBrightness;
+    pushed.wifiLastConnectAttempt = wifiLastConnectAttempt;
+    memcpy(pushed.states, entityStates, sizeof(pushed.states));
+    pushed.logSeq = logSequence;
+}
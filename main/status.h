@@ -0,0 +1,45 @@
+#ifndef STATUS_H
+#define STATUS_H
+
+#include "declarations.h"
+
+// Working buffers, static (see pools.h). The arenas hold the JsonDocuments,
+// the text buffers their serialized copies for WebSocket clients.
+#define STATUS_ARENA_SIZE 12288
+#define STATUS_TEXT_SIZE  10240
+#define DELTA_ARENA_SIZE  6144
+#define DELTA_TEXT_SIZE   6144
+
+#define STATUS_LIVE_INTERVAL 1000 // Uptime, heap and time are at most this old (ms)
+
+// --- Status Snapshot ---
+// One JSON status document shared by GET /status and the port 81 WebSocket.
+// It is only rebuilt when its version changes: a state change, a new log
+// line, a new keyframe on the strip (blended frames in between do not count)
+// or every STATUS_LIVE_INTERVAL, for the fields that move on their own.
+
+// Call after changing anything reported in the status that is not a log
+// line or a frame (sensor states, connection flags, brightness...).
+void notifyStatusChanged();
+uint32_t getStatusVersion();
+
+// Writes a complete HTTP response (200 with body, or 304 when ifNoneMatch
+// matches the current ETag) straight into the client.
+void sendStatusHttp(WiFiClient& client, const char* ifNoneMatch, bool keepAlive);
+
+// Serialized snapshot, cached per version for WebSocket clients.
+// nullptr when it does not fit STATUS_TEXT_SIZE.
+const char* getStatusJson(size_t& length);
+
+// --- Push Deltas ---
+// Serializes only what changed since the last markStatusPushed(): scalar
+// fields and log lines newer than the last pushed log sequence. Uptime, heap
+// and time are always included; changes is false when that is all there is.
+// Frames are pushed separately as binary messages (see frame_codec.h).
+// nullptr when it does not fit DELTA_TEXT_SIZE.
+const char* buildStatusDelta(size_t& length, bool& changes);
+
+// Records the current state as the base for the next delta.
+void markStatusPushed();
+
+#endif // STATUS_H
@@ -0,0 +1,90 @@
+#ifndef SYNC_H
+#define SYNC_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// --- Cross-core Handover ---
+// Lock-free primitives for passing data between the network and render
+// tasks. Neither blocks nor disables interrupts, and neither depends on
+// FreeRTOS, so both can be exercised with plain threads on the host.
+
+// Single writer, any number of readers. T must be trivially copyable.
+// A reader retries while a write is in progress, so reads are never torn;
+// the writer never waits.
+// A reader spins while the writer is mid-write, so a reader must not preempt
+// the writer on the same core (here they are pinned to different cores).
+template <typename T>
+class SeqLock {
+public:
+    SeqLock() : sequence(0) {
+        memset(&value, 0, sizeof(value));
+    }
+
+    void write(const T& next) {
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed); // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&value, &next, sizeof(T));
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    void read(T& out) const {
+        uint32_t before;
+        uint32_t after;
+        do {
+            before = sequence.load(std::memory_order_acquire);
+            memcpy(&out, &value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+    }
+
+    // Number of completed writes, cheap to poll for changes
+    uint32_t version() const {
+        return sequence.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    std::atomic<uint32_t> sequence;
+    T value;
+};
+
+// Bounded single-producer, single-consumer ring. push() fails instead of
+// overwriting when the consumer has fallen SIZE items behind.
+template <typename T, size_t SIZE>
+class SpscQueue {
+    static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    bool push(const T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == SIZE) {
+            return false;
+        }
+        items[h & (SIZE - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[t & (SIZE - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::atomic<uint32_t> head; // Written by the producer only
+    std::atomic<uint32_t> tail; // Written by the consumer only
+    T items[SIZE];
+};
+
+#endif // SYNC_H
@@ -1,15 +1,75 @@
 #include "util.h"
 #include "declarations.h"
+#include "sound_sequencer.h"
+#include "perf.h"
 #include <Arduino.h>
+#include <esp_timer.h>
+
+// The sequencer is advanced from an esp_timer callback that is armed for the
+// next tone edge only, so playSound() never blocks loop(). Only the callback
+// drives the pin, under the same lock as the sequencer, so a write can never
+// land after a newer state has been written.
+static SoundSequencer soundSequencer;
+static esp_timer_handle_t soundTimer = nullptr;
+static portMUX_TYPE soundMux = portMUX_INITIALIZER_UNLOCKED;
+
+static void writeBuzzer(bool on) {
+    // The buzzer is active low
+    digitalWrite(BUZZER_PIN, on ? LOW : HIGH);
+}
+
+static void onSoundTimer(void* arg) {
+    unsigned long now = millis();
+
+    portENTER_CRITICAL(&soundMux);
+    writeBuzzer(soundSequencer.update(now));
+    bool busy = soundSequencer.isBusy();
+    unsigned long wait = soundSequencer.nextDeadline() - now;
+    portEXIT_CRITICAL(&soundMux);
+
+    if (busy) {
+        esp_timer_start_once(soundTimer, (uint64_t)wait * 1000ULL);
+    }
+}
+
+void setupSound() {
+    pinMode(BUZZER_PIN, OUTPUT);
+    writeBuzzer(false); // Keep buzzer OFF
+
+    if (soundTimer == nullptr) {
+        esp_timer_create_args_t args = {};
+        args.callback = onSoundTimer;
+        args.name = "sound";
+        esp_timer_create(&args, &soundTimer);
+    }
+}
 
 void playSound(int beeps, int delayBetweenBeep, int duration) {
-    // Play 'beeps' short beeps for any state change.
-    for (int i = 0; i < beeps; i++) {
-        digitalWrite(BUZZER_PIN, LOW);
-        delay(duration);
-        digitalWrite(BUZZER_PIN, HIGH);
-        if (i < beeps - 1) {
-            delay(delayBetweenBeep);
-        }
+    PerfScope perf(PERF_SOUND);
+    if (beeps <= 0) {
+        return;
+    }
+    if (soundTimer == nullptr) {
+        setupSound();
+    }
+
+    SoundPattern pattern;
+    pattern.beeps = constrain(beeps, 1, 255);
+    pattern.gap = constrain(delayBetweenBeep, 0, 65535);
+    pattern.duration = constrain(duration, 0, 65535);
+
+    unsigned long now = millis();
+
+    portENTER_CRITICAL(&soundMux);
+    bool wasBusy = soundSequencer.isBusy();
+    soundSequencer.enqueue(pattern, now);
+    bool started = !wasBusy && soundSequencer.isBusy();
+    portEXIT_CRITICAL(&soundMux);
+
+    // Only the idle -> busy transition arms the timer, right away so the
+    // callback switches the buzzer on; it re-arms itself until the queue
+    // drains.
+    if (started) {
+        esp_timer_start_once(soundTimer, 0);
     }
 }
@@ -2,6 +2,7 @@
 #define UTIL_H
 
 
+void setupSound();
 void playSound(int beeps, int delayBetweenBeep, int duration);
 
 #endif // UTIL_H
@@ -0,0 +1,207 @@
+#include "warmstart.h"
+#include "logging.h"
+#include "status.h"
+#include "animation.h"
+#include "hass.h"
+#include <Preferences.h>
+
+#define WARM_MAGIC     0x57524D31 // "WRM1"
+#define WARM_NVS_SPACE "charger"
+#define WARM_NVS_KEY   "warm"
+
+struct WarmState {
+    uint32_t magic;
+    uint16_t size;         // sizeof(WarmState), so a changed layout is ignored
+    uint8_t entityCount;   // States are only restored for the same bindings
+    uint8_t brightness;
+    uint8_t logLevel;
+    uint8_t wifiChannel;   // 0 when unknown
+    uint8_t wifiBssid[6];
+    EntityState states[MAX_ENTITIES];
+    uint32_t animationStep; // RTC only, 0 in NVS
+    uint32_t checksum;
+};
+
+// Not cleared by a soft reset; random after power-on, hence the checksum
+RTC_NOINIT_ATTR static WarmState rtcState;
+
+static WarmState live;     // What the RTC copy was last refreshed to
+static WarmState nvsSaved; // What NVS holds
+static unsigned long lastCheck = 0;
+static unsigned long lastNvsWrite = 0;
+static bool nvsWritten = false;
+static WarmStartStats stats;
+
+// FNV-1a over everything before the checksum
+static uint32_t warmChecksum(const WarmState& state) {
+    const uint8_t* bytes = (const uint8_t*)&state;
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < offsetof(WarmState, checksum); i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+static bool warmValid(const WarmState& state) {
+    return state.magic == WARM_MAGIC && state.size == sizeof(WarmState) &&
+           state.checksum == warmChecksum(state);
+}
+
+static void seal(WarmState& state) {
+    state.magic = WARM_MAGIC;
+    state.size = sizeof(WarmState);
+    state.checksum = warmChecksum(state);
+}
+
+static bool readNvs(WarmState& state) {
+    Preferences prefs;
+    if (!prefs.begin(WARM_NVS_SPACE, true)) {
+        return false;
+    }
+    bool ok = prefs.getBytesLength(WARM_NVS_KEY) == sizeof(state) &&
+              prefs.getBytes(WARM_NVS_KEY, &state, sizeof(state)) == sizeof(state) &&
+              warmValid(state);
+    prefs.end();
+    return ok;
+}
+
+static void writeNvs(const WarmState& state) {
+    WarmState stored = state;
+    stored.animationStep = 0;
+    seal(stored);
+    if (memcmp(&stored, &nvsSaved, sizeof(stored)) == 0) {
+        return;
+    }
+
+    Preferences prefs;
+    bool ok = prefs.begin(WARM_NVS_SPACE, false);
+    ok = ok && prefs.putBytes(WARM_NVS_KEY, &stored, sizeof(stored)) == sizeof(stored);
+    prefs.end();
+    lastNvsWrite = millis();
+    nvsWritten = true;
+    if (!ok) {
+        stats.nvsErrors++;
+        logWarning("Could not save the warm-start cache to NVS");
+        return;
+    }
+    nvsSaved = stored;
+    stats.nvsWrites++;
+}
+
+static void restore(const WarmState& state) {
+    displayBrightness = state.brightness;
+    if (state.logLevel <= LOG_ERROR) {
+        logRuntimeLevel = (LogLevel)state.logLevel;
+    }
+    setAnimationStep(state.animationStep);
+    if (state.entityCount == entityCount) {
+        // Straight into the array: not a transition, nothing to record or beep
+        memcpy(entityStates, state.states, sizeof(entityStates));
+        for (int i = 0; i < entityCount; i++) {
+            statesStale = statesStale || state.states[i] != STATE_UNKNOWN;
+        }
+    }
+}
+
+// Sensor states are only taken once the current connection has delivered
+// them; before that (and after a disconnect) they are "unknown" or stale, and
+// the cache keeps the last confirmed ones
+static void capture(WarmState& state) {
+    state.entityCount = entityCount;
+    state.brightness = displayBrightness;
+    state.logLevel = logRuntimeLevel;
+    if (wifi_connected) {
+        state.wifiChannel = WiFi.channel();
+        memcpy(state.wifiBssid, WiFi.BSSID(), sizeof(state.wifiBssid));
+    }
+    if (hassStatesSynced() && !statesStale) {
+        memcpy(state.states, entityStates, sizeof(state.states));
+    }
+    state.animationStep = getAnimationStep(millis());
+    seal(state);
+}
+
+void setupWarmStart() {
+    memset(&stats, 0, sizeof(stats));
+    memset(&nvsSaved, 0, sizeof(nvsSaved));
+    bool fromNvs = readNvs(nvsSaved);
+
+    if (warmValid(rtcState)) {
+        live = rtcState;
+        stats.source = WARM_RTC;
+    } else if (fromNvs) {
+        live = nvsSaved;
+        stats.source = WARM_NVS;
+    } else {
+        memset(&live, 0, sizeof(live));
+        capture(live);
+        rtcState = live;
+        logInfo("No warm-start cache");
+        return;
+    }
+
+    restore(live);
+    stats.restoredAtMs = millis();
+    logInfo("Warm start from %s: brightness %u, states %s", warmSourceName(stats.source),
+            displayBrightness, statesStale ? "cached" : "unknown");
+}
+
+void loopWarmStart() {
+    unsigned long now = millis();
+    if (now - lastCheck < WARM_CHECK_INTERVAL) {
+        return;
+    }
+    lastCheck = now;
+
+    WarmState next = live;
+    capture(next);
+    if (memcmp(&next, &live, sizeof(next)) != 0) {
+        live = next;
+        rtcState = live;
+        stats.rtcWrites++;
+    }
+
+    // The animation step alone changes every second; writeNvs() ignores it
+    if (!nvsWritten || now - lastNvsWrite >= WARM_NVS_INTERVAL) {
+        writeNvs(live);
+    }
+}
+
+void flushWarmState() {
+    capture(live);
+    rtcState = live;
+    writeNvs(live);
+}
+
+void endStaleStates() {
+    if (!statesStale) {
+        return;
+    }
+    statesStale = false;
+    notifyStatusChanged();
+    if (stats.source != WARM_NONE) {
+        logInfo("Cached states cleared %lu ms after boot", millis() - stats.restoredAtMs);
+    }
+}
+
+bool getWifiHint(uint8_t& channel, uint8_t* bssid) {
+    if (live.wifiChannel == 0) {
+        return false;
+    }
+    channel = live.wifiChannel;
+    memcpy(bssid, live.wifiBssid, sizeof(live.wifiBssid));
+    return true;
+}
+
+const WarmStartStats& getWarmStartStats() {
+    return stats;
+}
+
+const char* warmSourceName(WarmSource source) {
+    switch (source) {
+        case WARM_NONE: return "none";
+        case WARM_RTC: return "rtc";
+        case WARM_NVS: return "nvs";
+    }
+    return "unknown";
+}
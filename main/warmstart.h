@@ -0,0 +1,55 @@
+#ifndef WARMSTART_H
+#define WARMSTART_H
+
+#include "declarations.h"
+
+// --- Warm Start ---
+// The last confirmed sensor states, the brightness and log level, the
+// animation step and the WiFi channel/BSSID are cached so a reboot does not
+// start from "unknown":
+//   - RTC memory keeps them across soft resets (/boot, panics, watchdog)
+//     and is refreshed as they change;
+//   - NVS keeps them across power cycles, written at most once every
+//     WARM_NVS_INTERVAL so frequent changes neither wear the flash nor
+//     stall the network pass.
+// At boot the cache is restored before the first frame. Restored states are
+// flagged stale (statesStale) and drawn without the border until Home
+// Assistant's initial sync confirms or replaces them.
+
+#define WARM_CHECK_INTERVAL 1000  // How often the cache is compared with the live values (ms)
+#define WARM_NVS_INTERVAL   60000 // Minimum time between two NVS writes (ms)
+
+enum WarmSource : uint8_t {
+    WARM_NONE = 0,
+    WARM_RTC,
+    WARM_NVS
+};
+
+struct WarmStartStats {
+    WarmSource source;
+    unsigned long restoredAtMs; // millis() when the cache was restored
+    uint32_t rtcWrites;
+    uint32_t nvsWrites;
+    uint32_t nvsErrors;
+};
+
+// Restores the cache into the globals; call after setupEntities(), before
+// the first frame
+void setupWarmStart();
+
+// Network pass: refreshes RTC memory and, coalesced, NVS
+void loopWarmStart();
+
+// Writes NVS now, e.g. before a requested reboot
+void flushWarmState();
+
+// The restored states are confirmed by HA, or gone with the connection
+void endStaleStates();
+
+// WiFi channel and BSSID of the last connection; false when unknown
+bool getWifiHint(uint8_t& channel, uint8_t* bssid);
+
+const WarmStartStats& getWarmStartStats();
+const char* warmSourceName(WarmSource source);
+
+#endif // WARMSTART_H